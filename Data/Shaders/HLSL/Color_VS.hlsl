@@ -1,5 +1,6 @@
 #include "Include/ForwardBase.hlsli"
 #include "Include/Skinning.hlsli"
+#include "Include/Instancing.hlsli"
 
 cbuffer PerCameraBuffer : register(b0)
 {
@@ -18,7 +19,7 @@ cbuffer PerCameraBuffer : register(b0)
 
 cbuffer PerInstanceBuffer : register(b1)
 {
-    PerInstanceData gInstanceData[STANDARD_FORWARD_MAX_INSTANCED_BLOCK];
+    uint   gInstanceOffset;
 }
 
 cbuffer PerObjectBuffer : register(b2)
@@ -91,10 +92,12 @@ VS_OUTPUT main( VS_INPUT IN )
     }
     else
     {
+        PerInstanceData instance = GetInstanceData(gInstanceOffset + IN.Instanceid);
+
         OUT.Position = float4(IN.Position, 1.0f);
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
-        OUT.Position = mul(gInstanceData[IN.Instanceid].gMatWorld, OUT.Position);
+        OUT.Position = mul(instance.gMatWorld, OUT.Position);
         OUT.Position = mul(gMatViewProj, OUT.Position);
 
         OUT.Normal = IN.Normal;
@@ -108,14 +111,14 @@ VS_OUTPUT main( VS_INPUT IN )
             OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
         }
 
-        OUT.Normal = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
-        OUT.BiTangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
+        OUT.Normal = normalize(mul(instance.gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
+        OUT.Tangent = normalize(mul(instance.gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
+        OUT.BiTangent = normalize(mul(instance.gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
 
         OUT.PositionWS = float4(IN.Position, 1.0f);
         if(gHasAnimation)
             OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
-        OUT.PositionWS = mul(gInstanceData[IN.Instanceid].gMatWorld, OUT.PositionWS);
+        OUT.PositionWS = mul(instance.gMatWorld, OUT.PositionWS);
 
         OUT.ViewDirectionWS = normalize(OUT.PositionWS.xyz - gViewOrigin);
         OUT.Color = IN.Color;
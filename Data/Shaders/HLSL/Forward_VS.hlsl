@@ -1,5 +1,6 @@
 #include "Include/ForwardBase.hlsli"
 #include "Include/Skinning.hlsli"
+#include "Include/Instancing.hlsli"
 
 cbuffer PerCameraBuffer : register(b0)
 {
@@ -18,7 +19,7 @@ cbuffer PerCameraBuffer : register(b0)
 
 cbuffer PerInstanceBuffer : register(b1)
 {
-    PerInstanceData gInstanceData[STANDARD_FORWARD_MAX_INSTANCED_BLOCK];
+    uint   gInstanceOffset;
 }
 
 cbuffer PerObjectBuffer : register(b2)
@@ -103,7 +104,9 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
     }
     else
     {
-        if(gInstanceData[instanceid].gHasAnimation)
+        PerInstanceData instance = GetInstanceData(gInstanceOffset + instanceid);
+
+        if(instance.gHasAnimation)
         {
             blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
             prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
@@ -112,19 +115,19 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
         OUT.Position = float4(IN.Position, 1.0f);
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
-        OUT.Position = mul(gInstanceData[instanceid].gMatWorld, OUT.Position);
+        OUT.Position = mul(instance.gMatWorld, OUT.Position);
         OUT.Position = mul(gMatViewProj, OUT.Position);
 
         OUT.CurrPosition = float4(IN.Position, 1.0f);
         if(gHasAnimation)
             OUT.CurrPosition = mul(blendMatrix, OUT.CurrPosition);
-        OUT.CurrPosition = mul(gInstanceData[instanceid].gMatWorld, OUT.CurrPosition);
+        OUT.CurrPosition = mul(instance.gMatWorld, OUT.CurrPosition);
         OUT.CurrPosition = mul(gMatViewProj, OUT.CurrPosition);
 
         OUT.PrevPosition = float4(IN.Position, 1.0f);
         if(gHasAnimation)
             OUT.PrevPosition = mul(prevBlendMatrix, OUT.PrevPosition);
-        OUT.PrevPosition = mul(gInstanceData[instanceid].gMatPrevWorld, OUT.PrevPosition);
+        OUT.PrevPosition = mul(instance.gMatPrevWorld, OUT.PrevPosition);
         OUT.PrevPosition = mul(gMatViewProj, OUT.PrevPosition);
 
         OUT.Normal = IN.Normal;
@@ -138,19 +141,19 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
             OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
         }
 
-        OUT.Normal = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
-        OUT.BiTangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
+        OUT.Normal = normalize(mul(instance.gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
+        OUT.Tangent = normalize(mul(instance.gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
+        OUT.BiTangent = normalize(mul(instance.gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
 
         OUT.Texture = FlipUV(IN.Texture);
 
         OUT.PositionWS = float4(IN.Position, 1.0f);
         if(gHasAnimation)
             OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
-        OUT.PositionWS = mul(gInstanceData[instanceid].gMatWorld, OUT.PositionWS);
+        OUT.PositionWS = mul(instance.gMatWorld, OUT.PositionWS);
 
-        OUT.Other.x = (gInstanceData[instanceid].gWriteVelocity == 1) ? 1.0 : 0.0;
-        OUT.Other.y = (gInstanceData[instanceid].gCastLights == 1) ? 1.0 : 0.0;
+        OUT.Other.x = (instance.gWriteVelocity == 1) ? 1.0 : 0.0;
+        OUT.Other.y = (instance.gCastLights == 1) ? 1.0 : 0.0;
     }
 
     float3x3 TBN = float3x3(OUT.Tangent, OUT.BiTangent, OUT.Normal);
@@ -1,4 +1,3 @@
-#define STANDARD_FORWARD_MAX_INSTANCED_BLOCK 128
 #define MAX_LIGHTS 24
 
 #define DIRECTIONAL_LIGHT 0.0
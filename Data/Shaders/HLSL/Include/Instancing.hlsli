@@ -0,0 +1,32 @@
+#define INSTANCE_DATA_NUM_ELEMENTS 21
+
+Buffer<float4> InstanceData;
+
+float4x4 GetInstanceMatrix(uint idx)
+{
+    float4 row0 = InstanceData[idx + 0];
+    float4 row1 = InstanceData[idx + 1];
+    float4 row2 = InstanceData[idx + 2];
+    float4 row3 = InstanceData[idx + 3];
+
+    return float4x4(row0, row1, row2, row3);
+}
+
+PerInstanceData GetInstanceData(uint instanceIdx)
+{
+    uint idx = instanceIdx * INSTANCE_DATA_NUM_ELEMENTS;
+    uint4 flags = asuint(InstanceData[idx + 20]);
+
+    PerInstanceData data;
+    data.gMatWorld = GetInstanceMatrix(idx + 0);
+    data.gMatInvWorld = GetInstanceMatrix(idx + 4);
+    data.gMatWorldNoScale = GetInstanceMatrix(idx + 8);
+    data.gMatInvWorldNoScale = GetInstanceMatrix(idx + 12);
+    data.gMatPrevWorld = GetInstanceMatrix(idx + 16);
+    data.gLayer = flags.x;
+    data.gHasAnimation = flags.y;
+    data.gWriteVelocity = flags.z;
+    data.gCastLights = flags.w;
+
+    return data;
+}
@@ -872,7 +872,7 @@ namespace te
 
                 case TID_CSkybox:
                 {
-                    if (SceneManager::Instance().FindComponents<CSkybox>().size() > 0)
+                    if (SceneManager::Instance().GetNumComponents<CSkybox>() > 0)
                         break;
 
                     HSkybox component = clickedSceneObject->AddComponent<CSkybox>();
@@ -1,9 +1,13 @@
 #include "TeWidgetProfiler.h"
 
 #include "Profiling/TeProfilerGPU.h"
+#include "Profiling/TeProfilerRenderer.h"
 
 namespace te
 {
+    /** File written by the "Export CSV" button, relative to the working directory. */
+    static const char* RENDERER_PROFILE_CSV_PATH = "RendererProfile.csv";
+
     WidgetProfiler::WidgetProfiler()
         : Widget(WidgetType::Profiler)
     { 
@@ -24,6 +28,12 @@ namespace te
         {
             gProfilerGPU().Enable(profilerEnabled);
         }
+
+        bool rendererProfilerEnabled = gProfilerRenderer().IsEnabled();
+        if (ImGuiExt::RenderOptionBool(rendererProfilerEnabled, "##profiler_renderer_enabled_option", "Enable renderer profiling"))
+        {
+            gProfilerRenderer().Enable(rendererProfilerEnabled);
+        }
         ImGui::Separator();
 
         const GPUSample& sample = gProfilerGPU().GetSample();
@@ -34,7 +44,7 @@ namespace te
 
             ImGui::PushID("Renderer Profiling ID");
             {
-                ImGui::BeginChild("Renderer Profiling Fields", ImVec2(ImGui::GetContentRegionAvail().x, 418.0f), true);
+                ImGui::BeginChild("Renderer Profiling Fields", ImVec2(ImGui::GetContentRegionAvail().x, 443.0f), true);
                 ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2{ 5.0f, 5.0f });
 
                 ImGui::Columns(2);
@@ -143,6 +153,14 @@ namespace te
 
                 ImGui::Separator();
 
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Filtered Binds");
+                ImGui::NextColumn();
+                ImGui::Text(ToString(sample.NumFilteredBinds).c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
                 ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
                 ImGui::Text("Num Res Created");
                 ImGui::NextColumn();
@@ -179,6 +197,63 @@ namespace te
             ImGui::PopID();
         }
 
+        if (ImGui::CollapsingHeader("Renderer CPU", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            const RendererSample& rendererSample = gProfilerRenderer().GetSample();
+
+            auto renderField = [](const char* name, const String& value)
+            {
+                ImGui::Separator();
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text(name);
+                ImGui::NextColumn();
+                ImGui::Text(value.c_str());
+                ImGui::NextColumn();
+            };
+
+            ImGui::PushID("Renderer CPU Profiling ID");
+            {
+                ImGui::BeginChild("Renderer CPU Profiling Fields", ImVec2(ImGui::GetContentRegionAvail().x, 345.0f), true);
+                ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2{ 5.0f, 5.0f });
+
+                ImGui::Columns(2);
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("CPU time");
+                ImGui::NextColumn();
+                ImGui::Text((ToString((float)rendererSample.Time / 1000.0f) + " ms").c_str());
+                ImGui::NextColumn();
+
+                for (UINT32 i = 0; i < (UINT32)RendererStage::Count; i++)
+                {
+                    renderField(ProfilerRenderer::GetStageName((RendererStage)i),
+                        ToString((float)rendererSample.StageTimes[i] / 1000.0f) + " ms");
+                }
+
+                renderField("Views", ToString(rendererSample.NumViews));
+                renderField("Renderables", ToString(rendererSample.NumRenderables));
+                renderField("Visible", ToString(rendererSample.NumVisibleRenderables));
+                renderField("Culled by layer", ToString(rendererSample.NumCulledByLayer));
+                renderField("Culled by distance", ToString(rendererSample.NumCulledByDistance));
+                renderField("Culled by frustum", ToString(rendererSample.NumCulledByFrustum));
+                renderField("Opaque elements", ToString(rendererSample.NumOpaqueElements));
+                renderField("Transparent elements", ToString(rendererSample.NumTransparentElements));
+
+                ImGui::Columns(1);
+
+                ImGui::PopStyleVar();
+                ImGui::EndChild();
+            }
+            ImGui::PopID();
+
+            if (ImGui::Button("Export CSV", ImVec2(ImGui::GetWindowContentRegionWidth(), 25.0f)))
+            {
+                if (!gProfilerRenderer().ExportCSV(RENDERER_PROFILE_CSV_PATH))
+                    TE_DEBUG("Cannot export renderer profiling data to " + String(RENDERER_PROFILE_CSV_PATH));
+            }
+        }
+
         if (ImGui::CollapsingHeader("GPU Memory", ImGuiTreeNodeFlags_DefaultOpen))
         {
             String GPUMemory = ToString(sample.GPUMemory) + " MB";
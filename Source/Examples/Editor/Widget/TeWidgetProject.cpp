@@ -922,7 +922,7 @@ namespace te
         if (!_selections.ClickedSceneObject || _selections.ClickedComponent)
             return;
 
-        if (SceneManager::Instance().FindComponents<CSkybox>().size() > 0)
+        if (SceneManager::Instance().GetNumComponents<CSkybox>() > 0)
             return;
 
         HSkybox skybox = _selections.ClickedSceneObject->AddComponent<CSkybox>();
@@ -28,8 +28,10 @@ set (TE_CORE_INC_RENDERAPI
     "Core/RenderAPI/TeGpuParams.h"
     "Core/RenderAPI/TeGpuParam.h"
     "Core/RenderAPI/TeGpuParamBlockBuffer.h"
+    "Core/RenderAPI/TeGpuParamBlockRingBuffer.h"
     "Core/RenderAPI/TeVertexData.h"
     "Core/RenderAPI/TeRenderAPICapabilities.h"
+    "Core/RenderAPI/TeRenderAPIStateCache.h"
 )
 set (TE_CORE_SRC_RENDERAPI
     "Core/RenderAPI/TeRenderAPI.cpp"
@@ -56,8 +58,10 @@ set (TE_CORE_SRC_RENDERAPI
     "Core/RenderAPI/TeGpuParams.cpp"
     "Core/RenderAPI/TeGpuParam.cpp"
     "Core/RenderAPI/TeGpuParamBlockBuffer.cpp"
+    "Core/RenderAPI/TeGpuParamBlockRingBuffer.cpp"
     "Core/RenderAPI/TeVertexData.cpp"
     "Core/RenderAPI/TeRenderAPICapabilities.cpp"
+    "Core/RenderAPI/TeRenderAPIStateCache.cpp"
 )
 
 set (TE_CORE_INC_RENDERER
@@ -112,16 +116,21 @@ set (TE_CORE_INC_SCENE
     "Core/Scene/TeSceneActor.h"
     "Core/Scene/TeSceneManager.h"
     "Core/Scene/TeTransform.h"
+    "Core/Scene/TeTransformHierarchy.h"
+    "Core/Scene/TeWorldStreaming.h"
     "Core/Scene/TeComponent.h"
     "Core/Scene/TeGameObject.h"
     "Core/Scene/TeGameObjectHandle.h"
     "Core/Scene/TeGameObjectManager.h"
+    "Core/Scene/TeGameObjectPool.h"
     "Core/Scene/TeSceneObject.h"
 )
 set (TE_CORE_SRC_SCENE
     "Core/Scene/TeSceneActor.cpp"
     "Core/Scene/TeSceneManager.cpp"
     "Core/Scene/TeTransform.cpp"
+    "Core/Scene/TeTransformHierarchy.cpp"
+    "Core/Scene/TeWorldStreaming.cpp"
     "Core/Scene/TeComponent.cpp"
     "Core/Scene/TeGameObject.cpp"
     "Core/Scene/TeGameObjectHandle.cpp"
@@ -274,8 +283,12 @@ set (TE_CORE_SRC_MATERIAL
 
 set (TE_CORE_INC_SERIALIZATION
     "Core/Serialization/TeSerializable.h"
+    "Core/Serialization/TeBinaryStream.h"
+    "Core/Serialization/TeSceneSerializer.h"
 )
 set (TE_CORE_SRC_SERIALIZATION
+    "Core/Serialization/TeBinaryStream.cpp"
+    "Core/Serialization/TeSceneSerializer.cpp"
 )
 
 set (TE_CORE_INC_COMPONENTS
@@ -483,9 +496,11 @@ set (TE_CORE_SRC_PHYSICS
 
 set (TE_CORE_INC_PROFILING
     "Core/Profiling/TeProfilerGPU.h"
+    "Core/Profiling/TeProfilerRenderer.h"
 )
 set (TE_CORE_SRC_PROFILING
     "Core/Profiling/TeProfilerGPU.cpp"
+    "Core/Profiling/TeProfilerRenderer.cpp"
 )
 
 if (WIN32)
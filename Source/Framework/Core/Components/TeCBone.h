@@ -45,6 +45,9 @@ namespace te
         /** @copydoc Component::update */
         void Update() override { }
 
+        /** @copydoc Component::GetUpdateFlags */
+        UINT32 GetUpdateFlags() const override { return CUF_None; }
+
     protected:
         friend class SceneObject;
 
@@ -227,6 +227,9 @@ namespace te
         /** @copydoc Component::Update */
         void Update() override { }
 
+        /** @copydoc Component::GetUpdateFlags */
+        UINT32 GetUpdateFlags() const override { return CUF_None; }
+
     protected:
         CCamera();
     };
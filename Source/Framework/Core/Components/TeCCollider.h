@@ -34,6 +34,9 @@ namespace te
         /** @copydoc Component::update */
         void Update() override { }
 
+        /** @copydoc Component::GetUpdateFlags */
+        UINT32 GetUpdateFlags() const override { return CUF_None; }
+
         /** @copydoc Collider::SetScale */
         void SetScale(const Vector3& scale);
 
@@ -1,6 +1,7 @@
 #include "Components/TeCLight.h"
 #include "Scene/TeSceneManager.h"
 #include "Renderer/TeRenderer.h"
+#include "Serialization/TeBinaryStream.h"
 
 namespace te
 {
@@ -111,4 +112,57 @@ namespace te
 
         _internal->_markCoreDirty();
     }
+
+    void CLight::Serialize(BinaryWriter& writer) const
+    {
+        Component::Serialize(writer);
+
+        writer.Write((UINT32)_internal->GetType());
+        writer.Write(_internal->GetColor());
+        writer.Write(_internal->GetIntensity());
+        writer.Write(_internal->GetAttenuationRadius());
+        writer.Write(_internal->GetLinearAttenuation());
+        writer.Write(_internal->GetQuadraticAttenuation());
+        writer.Write(_internal->GetSpotAngle().ValueDegrees());
+        writer.Write(_internal->GetCastShadows());
+        writer.Write(_internal->GetShadowBias());
+    }
+
+    void CLight::Deserialize(BinaryReader& reader)
+    {
+        Component::Deserialize(reader);
+
+        UINT32 type = 0;
+        Color color;
+        float intensity = 0.0f;
+        float radius = 0.0f;
+        float linearAtt = 0.0f;
+        float quadraticAtt = 0.0f;
+        float spotAngle = 0.0f;
+        bool castShadows = false;
+        float shadowBias = 0.0f;
+
+        reader.Read(type);
+        reader.Read(color);
+        reader.Read(intensity);
+        reader.Read(radius);
+        reader.Read(linearAtt);
+        reader.Read(quadraticAtt);
+        reader.Read(spotAngle);
+        reader.Read(castShadows);
+        reader.Read(shadowBias);
+
+        if (reader.HasFailed())
+            return;
+
+        SetType((LightType)type);
+        SetColor(color);
+        SetIntensity(intensity);
+        SetAttenuationRadius(radius);
+        SetLinearAttenuation(linearAtt);
+        SetQuadraticAttenuation(quadraticAtt);
+        SetSpotAngle(Degree(spotAngle));
+        SetCastShadows(castShadows);
+        SetShadowBias(shadowBias);
+    }
 }
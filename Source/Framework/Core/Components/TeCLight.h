@@ -106,6 +106,15 @@ namespace te
         /** @copydoc Component::Update */
         void Update() override { }
 
+        /** @copydoc Component::Serialize */
+        void Serialize(BinaryWriter& writer) const override;
+
+        /** @copydoc Component::Deserialize */
+        void Deserialize(BinaryReader& reader) override;
+
+        /** @copydoc Component::GetUpdateFlags */
+        UINT32 GetUpdateFlags() const override { return CUF_None; }
+
     protected:
         mutable SPtr<Light> _internal;
 
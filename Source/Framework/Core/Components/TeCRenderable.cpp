@@ -1,6 +1,10 @@
 #include "Components/TeCRenderable.h"
 #include "Scene/TeSceneManager.h"
 #include "Components/TeCAnimation.h"
+#include "Resources/TeResourceManager.h"
+#include "Serialization/TeBinaryStream.h"
+#include "Mesh/TeMesh.h"
+#include "Material/TeMaterial.h"
 
 namespace te
 {
@@ -150,4 +154,80 @@ namespace te
 
         _internal->_markCoreDirty(ActorDirtyFlag::GpuParams);
     }
+
+    void CRenderable::Serialize(BinaryWriter& writer) const
+    {
+        Component::Serialize(writer);
+
+        SPtr<Mesh> mesh = _internal->GetMesh();
+        writer.Write(mesh != nullptr ? mesh->GetUUID() : UUID::EMPTY);
+
+        const Vector<SPtr<Material>>& materials = _internal->GetMaterials();
+        writer.Write((UINT32)materials.size());
+
+        for (auto& material : materials)
+            writer.Write(material != nullptr ? material->GetUUID() : UUID::EMPTY);
+
+        writer.Write(_internal->GetLayer());
+        _internal->GetProperties().Serialize(writer);
+    }
+
+    void CRenderable::Deserialize(BinaryReader& reader)
+    {
+        Component::Deserialize(reader);
+
+        UUID meshUUID;
+        reader.Read(meshUUID);
+
+        if (!meshUUID.Empty())
+            SetMesh(gResourceManager().Load<Mesh>(meshUUID));
+
+        UINT32 numMaterials = 0;
+        reader.Read(numMaterials);
+
+        for (UINT32 i = 0; i < numMaterials; i++)
+        {
+            UUID materialUUID;
+            reader.Read(materialUUID);
+
+            if (!materialUUID.Empty())
+                SetMaterial(i, gResourceManager().Load<Material>(materialUUID));
+        }
+
+        // Version 1 only stored some of the properties
+        if (reader.GetVersion() < 2)
+        {
+            float cullDistanceFactor = 1.0f;
+            bool writeVelocity = true;
+            bool useForDynamicEnvMapping = false;
+            UINT64 layer = 1;
+            bool instancing = false;
+
+            reader.Read(cullDistanceFactor);
+            reader.Read(writeVelocity);
+            reader.Read(useForDynamicEnvMapping);
+            reader.Read(layer);
+            reader.Read(instancing);
+
+            if (reader.HasFailed())
+                return;
+
+            SetCullDistanceFactor(cullDistanceFactor);
+            SetWriteVelocity(writeVelocity);
+            SetUseForDynamicEnvMapping(useForDynamicEnvMapping);
+            SetLayer(layer);
+            SetInstancing(instancing);
+            return;
+        }
+
+        UINT64 layer = 1;
+        RenderableProperties properties = _internal->GetProperties();
+
+        reader.Read(layer);
+        if (!properties.Deserialize(reader))
+            return;
+
+        SetLayer(layer);
+        _internal->SetPorperties(properties);
+    }
 }
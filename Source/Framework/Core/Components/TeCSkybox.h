@@ -91,6 +91,9 @@ namespace te
         /** @copydoc Component::update */
         void Update() override { }
 
+        /** @copydoc Component::GetUpdateFlags */
+        UINT32 GetUpdateFlags() const override { return CUF_None; }
+
     protected:
         CSkybox();
     };
@@ -120,6 +120,21 @@ namespace te
          */
         bool CollisionShape = true;
 
+        /**
+         * Number of simplified levels of detail generated for the mesh, in addition to the full detail one. Zero disables
+         * level of detail generation. Only triangle list sub-meshes are simplified.
+         */
+        UINT32 NumLODs = 0;
+
+        /** Fraction of the triangles of a level of detail kept in the next one. */
+        float LODReductionRatio = 0.5f;
+
+        /**
+         * Projected screen size (fraction of the viewport height covered by the mesh bounding sphere) below which the
+         * first simplified level of detail is used. Each next level of detail uses half the screen size of the previous one.
+         */
+        float LODScreenSize = 0.5f;
+
         /** Creates a new import options object that allows you to customize how are Meshs imported. */
         static SPtr<MeshImportOptions> Create();
     };
@@ -4,6 +4,9 @@
 #include "TeTechnique.h"
 #include "Image/TeTexture.h"
 #include "RenderAPI/TeSamplerState.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "RenderAPI/TeGpuParamDesc.h"
+#include "RenderAPI/TeGpuPipelineParamInfo.h"
 #include "Resources/TeResourceHandle.h"
 #include "Resources/TeResourceManager.h"
 
@@ -100,20 +103,125 @@ namespace te
             for (auto& buffer : _buffers)
                 outputParams[idx]->SetBuffer(buffer.first, buffer.second);
 
-            for (auto& param : _params)
-                outputParams[idx]->SetParam(param.first, param.second.Param, (UINT32)param.second.Size);
+            SetGpuParam(outputParams[idx]);
         }
     }
 
-    void Material::SetGpuParam(SPtr<GpuParams> outparams)
+    void Material::SetGpuParam(const SPtr<GpuParams>& outparams)
     {
+        if (_params.empty())
+            return;
+
+        const CompiledParams& compiled = GetCompiledParams(outparams->GetParamInfo());
+
+        for (auto& range : compiled.Ranges)
+        {
+            SPtr<GpuParamBlockBuffer> paramBlock = outparams->GetParamBlockBuffer(range.Set, range.Slot);
+            if (paramBlock == nullptr)
+                continue;
+
+            paramBlock->Write(range.Offset, compiled.Data.data() + range.DataOffset, range.Size);
+        }
+    }
+
+    const Material::CompiledParams& Material::GetCompiledParams(const SPtr<GpuPipelineParamInfo>& paramInfo)
+    {
+        for (auto& compiled : _compiledParams)
+        {
+            if (compiled.ParamInfo != paramInfo)
+                continue;
+
+            if (compiled.Version != _paramsVersion)
+                CompileParams(paramInfo, compiled);
+
+            return compiled;
+        }
+
+        _compiledParams.push_back(CompiledParams());
+        CompileParams(paramInfo, _compiledParams.back());
+
+        return _compiledParams.back();
+    }
+
+    void Material::CompileParams(const SPtr<GpuPipelineParamInfo>& paramInfo, CompiledParams& output) const
+    {
+        struct Element
+        {
+            UINT32 Set;
+            UINT32 Slot;
+            UINT32 Offset;
+            UINT32 Size;
+            const ParamData* Param;
+        };
+
+        // Find where each parameter lives, a parameter used by multiple programs is usually stored in the same block
+        Vector<Element> elements;
         for (auto& param : _params)
-            outparams->SetParam(param.first, param.second.Param, (UINT32)param.second.Size);
+        {
+            for (UINT32 i = 0; i < GPT_COUNT; i++)
+            {
+                const SPtr<GpuParamDesc>& paramDescs = paramInfo->GetParamDesc((GpuProgramType)i);
+                if (paramDescs == nullptr)
+                    continue;
+
+                auto iterFind = paramDescs->Params.find(param.first);
+                if (iterFind == paramDescs->Params.end())
+                    continue;
+
+                const GpuParamDataDesc& desc = iterFind->second;
+                elements.push_back({ desc.ParamBlockSet, desc.ParamBlockSlot, desc.CpuMemOffset * (UINT32)sizeof(UINT32),
+                    desc.ElementSize * (UINT32)sizeof(UINT32), &param.second });
+            }
+        }
+
+        std::sort(elements.begin(), elements.end(), [](const Element& a, const Element& b)
+        {
+            if (a.Set != b.Set)
+                return a.Set < b.Set;
+
+            if (a.Slot != b.Slot)
+                return a.Slot < b.Slot;
+
+            return a.Offset < b.Offset;
+        });
+
+        output.ParamInfo = paramInfo;
+        output.Ranges.clear();
+        output.Data.clear();
+        output.Version = _paramsVersion;
+
+        for (auto& element : elements)
+        {
+            CompiledParams::Range* range = output.Ranges.empty() ? nullptr : &output.Ranges.back();
+
+            // Same parameter found in another program
+            if (range && range->Set == element.Set && range->Slot == element.Slot &&
+                element.Offset < range->Offset + range->Size)
+            {
+                continue;
+            }
+
+            // Start a new range unless the element directly follows the previous one in the same block
+            if (!range || range->Set != element.Set || range->Slot != element.Slot ||
+                range->Offset + range->Size != element.Offset)
+            {
+                output.Ranges.push_back({ element.Set, element.Slot, element.Offset, 0, (UINT32)output.Data.size() });
+                range = &output.Ranges.back();
+            }
+
+            // Unused bytes of the element are set to 0, as GpuParams::SetParam() does
+            UINT32 dataOffset = (UINT32)output.Data.size();
+            output.Data.resize(dataOffset + element.Size, 0);
+            memcpy(output.Data.data() + dataOffset, element.Param->Param, std::min((UINT32)element.Param->Size, element.Size));
+
+            range->Size += element.Size;
+        }
     }
 
     void Material::SetShader(const SPtr<Shader>& shader)
     {
         _shader = shader;
+        _compiledParams.clear();
         InitializeTechniques();
     }
 
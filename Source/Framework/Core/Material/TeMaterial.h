@@ -226,12 +226,26 @@ namespace te
         template <typename T>
         void SetParam(const String& name, T& data)
         {
-            ParamData param;
-            param.Param = te_allocate<T>(sizeof(T));
-            param.Size = sizeof(T);
-            memcpy(param.Param, &data, param.Size);
-
-            _params[name] = param;
+            auto iterFind = _params.find(name);
+            if (iterFind != _params.end() && iterFind->second.Size == sizeof(T))
+            {
+                memcpy(iterFind->second.Param, &data, sizeof(T));
+            }
+            else
+            {
+                if (iterFind != _params.end())
+                    te_deallocate(iterFind->second.Param);
+
+                ParamData param;
+                param.Param = te_allocate<T>(sizeof(T));
+                param.Size = sizeof(T);
+                memcpy(param.Param, &data, param.Size);
+
+                _params[name] = param;
+            }
+
+            // Compiled layouts must be rebuilt with the new value
+            _paramsVersion++;
         }
 
         /* Create all gpu params for a set of passes related to the current technique */
@@ -240,8 +254,12 @@ namespace te
         /** Here you can set all properties for a given material */
         const MaterialProperties& GetProperties() { return _properties; }
 
-        /** ParamBlockBuffer are sometimes not currently set when creating gpuparams. So we give the ability to set manually gpu params */
-        void SetGpuParam(SPtr<GpuParams> outparams);
+        /**
+         * ParamBlockBuffer are sometimes not currently set when creating gpuparams. So we give the ability to set manually
+         * gpu params. Parameters are written using a layout compiled once per pipeline (see CompiledParams), which costs
+         * one copy per contiguous range of parameters instead of a lookup by name per parameter and per program.
+         */
+        void SetGpuParam(const SPtr<GpuParams>& outparams);
 
         void SetProperties(const MaterialProperties& properties) 
         { 
@@ -282,6 +300,15 @@ namespace te
          */
         void InitializeTechniques();
 
+    protected:
+        struct CompiledParams;
+
+        /** Returns parameters compiled for the provided pipeline, compiling them if they are missing or out of date. */
+        const CompiledParams& GetCompiledParams(const SPtr<GpuPipelineParamInfo>& paramInfo);
+
+        /** Builds the layout and the data of all parameters for the provided pipeline. */
+        void CompileParams(const SPtr<GpuPipelineParamInfo>& paramInfo, CompiledParams& output) const;
+
     protected:
         struct TextureData
         {
@@ -305,6 +332,27 @@ namespace te
             size_t Size;
         };
 
+        /**
+         * Values of all parameters laid out as they are in the parameter blocks of a pipeline. Parameters contiguous in a
+         * block are merged into a single range, written with a single copy.
+         */
+        struct CompiledParams
+        {
+            struct Range
+            {
+                UINT32 Set;
+                UINT32 Slot;
+                UINT32 Offset; /**< In bytes, within the parameter block. */
+                UINT32 Size; /**< In bytes. */
+                UINT32 DataOffset; /**< In bytes, within CompiledParams::Data. */
+            };
+
+            SPtr<GpuPipelineParamInfo> ParamInfo;
+            Vector<Range> Ranges;
+            Vector<UINT8> Data;
+            UINT32 Version = 0;
+        };
+
     protected:
         UINT32 _id;
         SPtr<Shader> _shader;
@@ -315,6 +363,10 @@ namespace te
         UnorderedMap<String, SPtr<GpuBuffer>> _buffers;
         UnorderedMap<String, SPtr<SamplerState>> _samplerStates;
         UnorderedMap<String, ParamData> _params;
+        UINT32 _paramsVersion = 0;
+
+        // Usually one entry per pass of the techniques in use, so a linear search is enough
+        Vector<CompiledParams> _compiledParams;
 
         MaterialProperties _properties;
 
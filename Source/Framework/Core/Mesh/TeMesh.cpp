@@ -77,7 +77,9 @@ namespace te
         , _indexType(desc.IndType)
         , _deviceMask(deviceMask)
         , _skeleton(desc.MeshSkeleton)
-    { }
+    {
+        _properties._lodScreenSizes = desc.LODScreenSizes;
+    }
 
     Mesh::Mesh(const SPtr<MeshData>& initialMeshData, const MESH_DESC& desc, GpuDeviceFlags deviceMask)
         : Resource(TID_Mesh)
@@ -91,7 +93,9 @@ namespace te
         , _indexType(initialMeshData->GetIndexType())
         , _deviceMask(deviceMask)
         , _skeleton(desc.MeshSkeleton)
-    { }
+    {
+        _properties._lodScreenSizes = desc.LODScreenSizes;
+    }
 
     Mesh::~Mesh()
     {
@@ -59,6 +59,13 @@ namespace te
          */
         IndexType IndType = IT_32BIT;
 
+        /**
+         * Projected screen sizes (fraction of the viewport height covered by the mesh bounding sphere) below which each
+         * level of detail of the mesh is used. Entry 0 is for level of detail 1 (see SubMesh::LODs), values must be
+         * decreasing. Leave empty if the mesh has no level of detail.
+         */
+        Vector<float> LODScreenSizes;
+
         /** Optional skeleton that can be used for skeletal animation of the mesh. */
         SPtr<Skeleton> MeshSkeleton;
 
@@ -94,10 +101,17 @@ namespace te
         /** Returns bounds of the geometry contained in the vertex buffers for all sub-meshes. */
         const Bounds& GetBounds() const { return _bounds; }
 
+        /** Returns the number of levels of detail of the mesh, including the full detail one. */
+        UINT32 GetNumLODs() const { return (UINT32)_lodScreenSizes.size() + 1; }
+
+        /** Returns the screen sizes below which each level of detail is used. @see MESH_DESC::LODScreenSizes */
+        const Vector<float>& GetLODScreenSizes() const { return _lodScreenSizes; }
+
     protected:
         friend class Mesh;
 
         Vector<SubMesh> _subMeshes;
+        Vector<float> _lodScreenSizes;
         UINT32 _numVertices;
         UINT32 _numIndices;
         Bounds _bounds;
@@ -136,4 +136,275 @@ namespace te
         CalculateNormals(vertices, indices, numVertices, numIndices, normals, indexSize);
         CalculateTangents(vertices, normals, uv, indices, numVertices, numIndices, tangents, bitangents, indexSize);
     }
+
+    /** Symmetric matrix [A b; b^T c] storing the sum of squared distances to a set of planes, used by Simplify(). */
+    struct SimplifyQuadric
+    {
+        double A00 = 0.0, A01 = 0.0, A02 = 0.0, A11 = 0.0, A12 = 0.0, A22 = 0.0;
+        double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+        double C = 0.0;
+
+        void AddPlane(const Vector3& normal, float distance, float weight)
+        {
+            const double x = normal.x, y = normal.y, z = normal.z, d = distance, w = weight;
+
+            A00 += w * x * x; A01 += w * x * y; A02 += w * x * z;
+            A11 += w * y * y; A12 += w * y * z; A22 += w * z * z;
+            B0 += w * x * d; B1 += w * y * d; B2 += w * z * d;
+            C += w * d * d;
+        }
+
+        double Evaluate(const Vector3& point) const
+        {
+            const double x = point.x, y = point.y, z = point.z;
+
+            return A00 * x * x + 2.0 * A01 * x * y + 2.0 * A02 * x * z + A11 * y * y + 2.0 * A12 * y * z + A22 * z * z
+                + 2.0 * (B0 * x + B1 * y + B2 * z) + C;
+        }
+
+        SimplifyQuadric& operator+= (const SimplifyQuadric& other)
+        {
+            A00 += other.A00; A01 += other.A01; A02 += other.A02;
+            A11 += other.A11; A12 += other.A12; A22 += other.A22;
+            B0 += other.B0; B1 += other.B1; B2 += other.B2;
+            C += other.C;
+
+            return *this;
+        }
+    };
+
+    /** Candidate edge collapse, moving vertex From onto vertex To. */
+    struct SimplifyCollapse
+    {
+        UINT32 From;
+        UINT32 To;
+        double Cost;
+    };
+
+    void MeshUtility::Simplify(const Vector3* vertices, UINT32 numVertices, const UINT8* indices, UINT32 numIndices,
+        UINT32 targetNumIndices, Vector<UINT32>& output, UINT32 indexSize, UINT32 vertexStride)
+    {
+        if (vertexStride == 0)
+            vertexStride = sizeof(Vector3);
+
+        auto getPosition = [vertices, vertexStride](UINT32 idx) -> const Vector3&
+        {
+            return *(const Vector3*)((const UINT8*)vertices + idx * vertexStride);
+        };
+
+        auto getEdgeKey = [](UINT32 a, UINT32 b) -> UINT64
+        {
+            return a < b ? (((UINT64)a << 32) | b) : (((UINT64)b << 32) | a);
+        };
+
+        output.resize(numIndices - (numIndices % 3));
+        for (UINT32 i = 0; i < (UINT32)output.size(); i++)
+        {
+            UINT32 idx = 0;
+            memcpy(&idx, indices + i * indexSize, indexSize);
+            output[i] = idx;
+        }
+
+        if (targetNumIndices >= (UINT32)output.size())
+            return;
+
+        // Error quadric of each vertex, built from the planes of the triangles using it, weighted by their area
+        Vector<SimplifyQuadric> quadrics(numVertices);
+        Vector<UINT64> edges;
+        edges.reserve(output.size());
+
+        for (size_t i = 0; i < output.size(); i += 3)
+        {
+            const Vector3& p0 = getPosition(output[i + 0]);
+            Vector3 normal = (getPosition(output[i + 1]) - p0).Cross(getPosition(output[i + 2]) - p0);
+            float area = normal.Length();
+
+            if (area > 0.0f)
+            {
+                normal = normal / area;
+                for (UINT32 j = 0; j < 3; j++)
+                    quadrics[output[i + j]].AddPlane(normal, -normal.Dot(p0), area * 0.5f);
+            }
+
+            for (UINT32 j = 0; j < 3; j++)
+                edges.push_back(getEdgeKey(output[i + j], output[i + (j + 1) % 3]));
+        }
+
+        // Edges not shared by exactly two triangles are open borders (or non-manifold), their vertices are locked
+        Vector<bool> locked(numVertices, false);
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t i = 0; i < edges.size();)
+        {
+            size_t count = 1;
+            while (i + count < edges.size() && edges[i + count] == edges[i])
+                count++;
+
+            if (count != 2)
+            {
+                locked[(UINT32)(edges[i] >> 32)] = true;
+                locked[(UINT32)(edges[i] & 0xFFFFFFFF)] = true;
+            }
+
+            i += count;
+        }
+
+        Vector<UINT32> remap(numVertices);
+        Vector<bool> touched(numVertices);
+        Vector<UINT32> vertexTriangleOffsets(numVertices + 1);
+        Vector<UINT32> vertexTriangles;
+        Vector<SimplifyCollapse> collapses;
+
+        // A collapse must not turn a triangle around the removed vertex upside down (or rotate it by more than ~75 degrees)
+        auto flipsTriangles = [&](const SimplifyCollapse& collapse)
+        {
+            const Vector3& target = getPosition(collapse.To);
+
+            for (UINT32 i = vertexTriangleOffsets[collapse.From]; i < vertexTriangleOffsets[collapse.From + 1]; i++)
+            {
+                const UINT32* triangle = &output[vertexTriangles[i] * 3];
+                if (triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To)
+                    continue;
+
+                Vector3 corners[3] = { getPosition(triangle[0]), getPosition(triangle[1]), getPosition(triangle[2]) };
+                Vector3 normal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    if (triangle[j] == collapse.From)
+                        corners[j] = target;
+                }
+
+                // Also rejects triangles which would become degenerate, their normal is not reliable anymore
+                Vector3 newNormal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+                if (normal.Dot(newNormal) <= 0.25f * normal.Length() * newNormal.Length())
+                    return true;
+            }
+
+            return false;
+        };
+
+        // Collapses are applied in passes. In each pass, independent collapses are applied cheapest first, then the
+        // triangle list is rebuilt
+        while ((UINT32)output.size() > targetNumIndices)
+        {
+            const UINT32 numTriangles = (UINT32)output.size() / 3;
+
+            std::fill(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end(), 0);
+            for (auto idx : output)
+                vertexTriangleOffsets[idx + 1]++;
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                vertexTriangleOffsets[i + 1] += vertexTriangleOffsets[i];
+
+            vertexTriangles.resize(output.size());
+            Vector<UINT32> fill(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end() - 1);
+            for (UINT32 i = 0; i < (UINT32)output.size(); i++)
+                vertexTriangles[fill[output[i]]++] = i / 3;
+
+            edges.clear();
+            for (UINT32 i = 0; i < (UINT32)output.size(); i += 3)
+            {
+                for (UINT32 j = 0; j < 3; j++)
+                    edges.push_back(getEdgeKey(output[i + j], output[i + (j + 1) % 3]));
+            }
+
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            collapses.clear();
+            for (auto edge : edges)
+            {
+                UINT32 a = (UINT32)(edge >> 32);
+                UINT32 b = (UINT32)(edge & 0xFFFFFFFF);
+
+                if (locked[a] && locked[b])
+                    continue;
+
+                SimplifyQuadric quadric = quadrics[a];
+                quadric += quadrics[b];
+
+                double costAB = locked[a] ? std::numeric_limits<double>::max() : quadric.Evaluate(getPosition(b));
+                double costBA = locked[b] ? std::numeric_limits<double>::max() : quadric.Evaluate(getPosition(a));
+
+                if (costAB <= costBA)
+                    collapses.push_back({ a, b, costAB });
+                else
+                    collapses.push_back({ b, a, costBA });
+            }
+
+            std::sort(collapses.begin(), collapses.end(),
+                [](const SimplifyCollapse& lhs, const SimplifyCollapse& rhs) { return lhs.Cost < rhs.Cost; });
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                remap[i] = i;
+
+            std::fill(touched.begin(), touched.end(), false);
+
+            const UINT32 numTrianglesToRemove = (numTriangles * 3 - targetNumIndices + 2) / 3;
+            UINT32 numRemovedTriangles = 0;
+            UINT32 numCollapses = 0;
+
+            for (auto& collapse : collapses)
+            {
+                if (numRemovedTriangles >= numTrianglesToRemove)
+                    break;
+
+                if (touched[collapse.From] || touched[collapse.To] || flipsTriangles(collapse))
+                    continue;
+
+                remap[collapse.From] = collapse.To;
+                quadrics[collapse.To] += quadrics[collapse.From];
+                numCollapses++;
+
+                // Vertices around the removed one must not be modified by another collapse during this pass, otherwise
+                // the flip test above could be wrong
+                for (UINT32 i = vertexTriangleOffsets[collapse.From]; i < vertexTriangleOffsets[collapse.From + 1]; i++)
+                {
+                    const UINT32* triangle = &output[vertexTriangles[i] * 3];
+
+                    if (triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To)
+                        numRemovedTriangles++;
+
+                    for (UINT32 j = 0; j < 3; j++)
+                        touched[triangle[j]] = true;
+                }
+            }
+
+            if (numCollapses == 0)
+                break;
+
+            UINT32 writeIdx = 0;
+            for (UINT32 i = 0; i < (UINT32)output.size(); i += 3)
+            {
+                UINT32 i0 = remap[output[i + 0]];
+                UINT32 i1 = remap[output[i + 1]];
+                UINT32 i2 = remap[output[i + 2]];
+
+                if (i0 == i1 || i1 == i2 || i0 == i2)
+                    continue;
+
+                output[writeIdx++] = i0;
+                output[writeIdx++] = i1;
+                output[writeIdx++] = i2;
+            }
+
+            output.resize(writeIdx);
+        }
+    }
+
+    UINT32 MeshUtility::SelectLOD(const Vector<float>& screenSizes, float screenSize, UINT32 currentLOD, float hysteresis)
+    {
+        UINT32 lod = 0;
+        for (UINT32 i = 0; i < (UINT32)screenSizes.size(); i++)
+        {
+            const float factor = currentLOD > i ? (1.0f + hysteresis) : (1.0f - hysteresis);
+            if (screenSize >= screenSizes[i] * factor)
+                break;
+
+            lod = i + 1;
+        }
+
+        return lod;
+    }
 }
@@ -149,5 +149,41 @@ namespace te
          */
         static void CalculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
             UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize = 4);
+
+        /**
+         * Reduces the number of triangles of a triangle list by collapsing its edges, cheapest first according to quadric
+         * error metrics. Vertices are only collapsed onto other existing vertices, so the simplified indices can keep on
+         * referencing the original vertex buffer.
+         *
+         * @param[in]	vertices			Set of vertices containing vertex positions.
+         * @param[in]	numVertices			Number of vertices in the @p vertices array.
+         * @param[in]	indices				Set of indices containing indexes into vertex array for each triangle.
+         * @param[in]	numIndices			Number of indices in the @p indices array. Must be a multiple of three.
+         * @param[in]	targetNumIndices	Number of indices the simplified triangle list should contain. Simplification
+         *									stops earlier if no valid collapse remains.
+         * @param[out]	output				Indices of the simplified triangle list, 32-bit.
+         * @param[in]	indexSize			Size of a single index in the indices array, in bytes.
+         * @param[in]	vertexStride		Number of bytes to advance the @p vertices array with each vertex. If set to zero
+         *									the array is advanced by the size of a Vector3.
+         *
+         * @note
+         * Vertices on an open border are never moved. Seams (for example UV discontinuities where vertices are split) are
+         * borders too, so they stay watertight.
+         */
+        static void Simplify(const Vector3* vertices, UINT32 numVertices, const UINT8* indices, UINT32 numIndices,
+            UINT32 targetNumIndices, Vector<UINT32>& output, UINT32 indexSize = 4, UINT32 vertexStride = 0);
+
+        /**
+         * Selects the level of detail to use for a mesh covering @p screenSize of the screen.
+         *
+         * @param[in]	screenSizes		Screen size under which each level of detail (after the first one) is used,
+         *								sorted from the most detailed level to the least detailed one.
+         * @param[in]	screenSize		Projected size of the mesh on screen.
+         * @param[in]	currentLOD		Level of detail used previously. Thresholds are pushed away from it, so meshes
+         *								close to a threshold don't switch level every frame.
+         * @param[in]	hysteresis		Fraction of the thresholds the screen size must exceed them by to switch level.
+         * @return						Index of the level of detail, 0 being the most detailed one.
+         */
+        static UINT32 SelectLOD(const Vector<float>& screenSizes, float screenSize, UINT32 currentLOD, float hysteresis);
     };
 }
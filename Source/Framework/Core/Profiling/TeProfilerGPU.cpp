@@ -65,6 +65,7 @@ namespace te
         _sample.NumGpuParamBinds = 0;
         _sample.NumVertexBufferBinds = 0;
         _sample.NumIndexBufferBinds = 0;
+        _sample.NumFilteredBinds = 0;
 
         _sample.NumResourceWrites = 0;
         _sample.NumResourceReads = 0;
@@ -173,6 +174,14 @@ namespace te
         _sample.NumIndexBufferBinds++; 
     }
 
+    void ProfilerGPU::AddNumFilteredBinds(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumFilteredBinds += count;
+    }
+
     void ProfilerGPU::IncResCreated()
     {
         if (!_frameBegan)
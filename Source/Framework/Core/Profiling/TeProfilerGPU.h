@@ -34,6 +34,7 @@ namespace te
         UINT32 NumGpuParamBinds = 0; /**< How many times were GPU parameters bound. */
         UINT32 NumVertexBufferBinds = 0; /**< How many times was a vertex buffer bound. */
         UINT32 NumIndexBufferBinds = 0; /**< How many times was an index buffer bound. */
+        UINT32 NumFilteredBinds = 0; /**< How many binds were skipped because the same state was already bound. */
 
         UINT32 NumResourceWrites = 0; /**< How many times were GPU resources written to. */
         UINT32 NumResourceReads = 0; /**< How many times were GPU resources read from. */
@@ -113,6 +114,12 @@ namespace te
         /** Increments index buffer change counter indicating how many times was a index buffer bound to the pipeline. */
         void IncNumIndexBufferBinds();
 
+        /**
+         * Increments filtered bind counter indicating how many pipeline, buffer, texture or sampler binds were skipped
+         * because the exact same state was already bound to the pipeline.
+         */
+        void AddNumFilteredBinds(UINT32 count);
+
         /** Increments created GPU resource counter. */
         void IncResCreated();
 
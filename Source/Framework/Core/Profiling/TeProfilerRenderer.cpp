@@ -0,0 +1,205 @@
+#include "TeProfilerRenderer.h"
+#include "Utility/TeTime.h"
+#include "Utility/TeDataStream.h"
+
+namespace te
+{
+    ProfilerRenderer::ProfilerRenderer()
+        : _sample(RendererSample())
+        , _historyStart(0)
+        , _enabled(true)
+        , _frameBegan(false)
+    { }
+
+    void ProfilerRenderer::BeginFrame()
+    {
+        if (!_enabled)
+        {
+            _frameBegan = false;
+            return;
+        }
+
+        Reset();
+        _frameBegan = true;
+        _sample.Time = gTime().GetTimePrecise();
+    }
+
+    void ProfilerRenderer::EndFrame()
+    {
+        if (!_frameBegan)
+            return;
+
+        _frameBegan = false;
+        _sample.Time = (gTime().GetTimePrecise() - _sample.Time);
+
+        if (_history.size() < HISTORY_SIZE)
+        {
+            _history.push_back(_sample);
+        }
+        else
+        {
+            _history[_historyStart] = _sample;
+            _historyStart = (_historyStart + 1) % HISTORY_SIZE;
+        }
+    }
+
+    void ProfilerRenderer::Enable(bool enable)
+    {
+        _enabled = enable;
+
+        if (!_enabled)
+            Reset();
+    }
+
+    void ProfilerRenderer::Reset()
+    {
+        _frameBegan = false;
+        _sample = RendererSample();
+    }
+
+    bool ProfilerRenderer::ExportCSV(const String& path) const
+    {
+        FileStream stream(path, DataStream::WRITE);
+        if (stream.Fail())
+            return false;
+
+        String header = "Frame,Time";
+        for (UINT32 i = 0; i < (UINT32)RendererStage::Count; i++)
+            header += "," + String(GetStageName((RendererStage)i));
+
+        header += ",Views,Renderables,Visible,CulledByLayer,CulledByDistance,CulledByFrustum,OpaqueElements,"
+            "TransparentElements\n";
+
+        stream.Write(header.data(), header.size());
+
+        const auto numSamples = (UINT32)_history.size();
+        for (UINT32 i = 0; i < numSamples; i++)
+        {
+            const RendererSample& sample = _history[(_historyStart + i) % numSamples];
+
+            String line = ToString(i) + "," + ToString(sample.Time);
+            for (UINT32 j = 0; j < (UINT32)RendererStage::Count; j++)
+                line += "," + ToString(sample.StageTimes[j]);
+
+            line += "," + ToString(sample.NumViews);
+            line += "," + ToString(sample.NumRenderables);
+            line += "," + ToString(sample.NumVisibleRenderables);
+            line += "," + ToString(sample.NumCulledByLayer);
+            line += "," + ToString(sample.NumCulledByDistance);
+            line += "," + ToString(sample.NumCulledByFrustum);
+            line += "," + ToString(sample.NumOpaqueElements);
+            line += "," + ToString(sample.NumTransparentElements);
+            line += "\n";
+
+            stream.Write(line.data(), line.size());
+        }
+
+        return true;
+    }
+
+    void ProfilerRenderer::AddStageTime(RendererStage stage, UINT64 time)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.StageTimes[(UINT32)stage] += time;
+    }
+
+    void ProfilerRenderer::AddNumViews(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumViews += count;
+    }
+
+    void ProfilerRenderer::AddNumRenderables(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumRenderables += count;
+    }
+
+    void ProfilerRenderer::AddNumVisibleRenderables(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumVisibleRenderables += count;
+    }
+
+    void ProfilerRenderer::AddNumCulledByLayer(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumCulledByLayer += count;
+    }
+
+    void ProfilerRenderer::AddNumCulledByDistance(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumCulledByDistance += count;
+    }
+
+    void ProfilerRenderer::AddNumCulledByFrustum(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumCulledByFrustum += count;
+    }
+
+    void ProfilerRenderer::AddNumOpaqueElements(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumOpaqueElements += count;
+    }
+
+    void ProfilerRenderer::AddNumTransparentElements(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumTransparentElements += count;
+    }
+
+    const char* ProfilerRenderer::GetStageName(RendererStage stage)
+    {
+        switch (stage)
+        {
+        case RendererStage::Visibility:
+            return "Visibility";
+        case RendererStage::Instancing:
+            return "Instancing";
+        case RendererStage::QueueBuild:
+            return "QueueBuild";
+        case RendererStage::Sort:
+            return "Sort";
+        case RendererStage::Submission:
+            return "Submission";
+        default:
+            return "Unknown";
+        }
+    }
+
+    ProfilerRendererScope::ProfilerRendererScope(RendererStage stage)
+        : _stage(stage)
+        , _startTime(gTime().GetTimePrecise())
+    { }
+
+    ProfilerRendererScope::~ProfilerRendererScope()
+    {
+        gProfilerRenderer().AddStageTime(_stage, gTime().GetTimePrecise() - _startTime);
+    }
+
+    ProfilerRenderer& gProfilerRenderer()
+    {
+        return ProfilerRenderer::Instance();
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeModule.h"
+
+namespace te
+{
+#if TE_PROFILING_ENABLED
+    #define TE_ADD_PROFILER_RENDERER(Stat, Count) gProfilerRenderer().Add##Stat(Count)
+    #define TE_PROFILE_RENDERER_STAGE(Stage) ProfilerRendererScope profilerRendererScope##Stage(RendererStage::Stage)
+#else
+    #define TE_ADD_PROFILER_RENDERER(Stat, Count)
+    #define TE_PROFILE_RENDERER_STAGE(Stage)
+#endif
+
+    /** CPU stages of a renderer frame timed by ProfilerRenderer. */
+    enum class RendererStage
+    {
+        Visibility, /**< Culling of renderables and lights against views. */
+        Instancing, /**< Grouping of similar renderables into instanced draws. */
+        QueueBuild, /**< Filling render queues of a view, including Sort. */
+        Sort, /**< Sorting of render queues. */
+        Submission, /**< Recording of the draw commands of a view. */
+        Count
+    };
+
+    /** Contains renderer CPU statistics about a single frame. */
+    struct RendererSample
+    {
+        UINT64 Time = 0; /**< Time in microseconds it took to render the frame on the CPU. */
+        UINT64 StageTimes[(UINT32)RendererStage::Count] = {}; /**< Time in microseconds spent in each stage. */
+
+        UINT32 NumViews = 0; /**< Number of views rendered. */
+        UINT32 NumRenderables = 0; /**< Number of renderables tested for visibility, once per view group. */
+        UINT32 NumVisibleRenderables = 0; /**< Number of renderables visible by at least one view of a group. */
+        UINT32 NumCulledByLayer = 0; /**< Number of renderables culled by a view because of their layer. */
+        UINT32 NumCulledByDistance = 0; /**< Number of renderables culled by a view because of the cull distance. */
+        UINT32 NumCulledByFrustum = 0; /**< Number of renderables culled by a view because outside of the frustum. */
+        UINT32 NumOpaqueElements = 0; /**< Number of elements in opaque render queues. */
+        UINT32 NumTransparentElements = 0; /**< Number of elements in transparent render queues. */
+    };
+
+    /**
+     * Profiler that measures the time spent in each CPU stage of the renderer, and counts what the renderer processed.
+     * Samples of the last frames are kept so they can be exported for regression tracking.
+     */
+    class TE_CORE_EXPORT ProfilerRenderer : public Module<ProfilerRenderer>
+    {
+    public:
+        /** Number of frames kept in history. */
+        static const UINT32 HISTORY_SIZE = 600;
+
+        ProfilerRenderer();
+        ~ProfilerRenderer() = default;
+
+        /**
+         * Signals a start of a new frame. This call must be followed by EndFrame(), and any sampling operations must
+         * happen between BeginFrame() and EndFrame().
+         */
+        void BeginFrame();
+
+        /** Signals an end of the currently sampled frame. */
+        void EndFrame();
+
+        /** Enable profiler */
+        void Enable(bool enable);
+
+        /* @copydoc ProfilerRenderer::Enable */
+        bool IsEnabled() { return _enabled; }
+
+        /** Returns last metrics sample */
+        const RendererSample& GetSample() const { return _sample; }
+
+        /**
+         * Returns the samples of the last frames, at most HISTORY_SIZE. Use with GetHistoryStart(), oldest sample being
+         * at index GetHistoryStart().
+         */
+        const Vector<RendererSample>& GetHistory() const { return _history; }
+
+        /** Returns the index of the oldest sample in GetHistory(). */
+        UINT32 GetHistoryStart() const { return _historyStart; }
+
+        /**
+         * Writes the samples of the last frames to a CSV file, oldest first, one line per frame. Times are written in
+         * microseconds. Returns false if the file can't be written.
+         */
+        bool ExportCSV(const String& path) const;
+
+        /** Adds time spent in a renderer stage. Use TE_PROFILE_RENDERER_STAGE instead of calling it directly. */
+        void AddStageTime(RendererStage stage, UINT64 time);
+
+        /** Increments the counter of rendered views. */
+        void AddNumViews(UINT32 count);
+
+        /** Increments the counter of renderables tested for visibility. */
+        void AddNumRenderables(UINT32 count);
+
+        /** Increments the counter of visible renderables. */
+        void AddNumVisibleRenderables(UINT32 count);
+
+        /** Increments the counter of renderables culled because none of their layers is visible by a view. */
+        void AddNumCulledByLayer(UINT32 count);
+
+        /** Increments the counter of renderables culled because too far from a view. */
+        void AddNumCulledByDistance(UINT32 count);
+
+        /** Increments the counter of renderables culled because outside of the frustum of a view. */
+        void AddNumCulledByFrustum(UINT32 count);
+
+        /** Increments the counter of elements added to opaque render queues. */
+        void AddNumOpaqueElements(UINT32 count);
+
+        /** Increments the counter of elements added to transparent render queues. */
+        void AddNumTransparentElements(UINT32 count);
+
+        /** Returns a readable name of the stage. */
+        static const char* GetStageName(RendererStage stage);
+
+    private:
+        /** Reset all metric from previous frame */
+        void Reset();
+
+    private:
+        RendererSample _sample;
+        Vector<RendererSample> _history;
+        UINT32 _historyStart;
+        bool _enabled;
+        bool _frameBegan;
+    };
+
+    /** Measures the time spent in a renderer stage until the end of the scope. */
+    class TE_CORE_EXPORT ProfilerRendererScope
+    {
+    public:
+        ProfilerRendererScope(RendererStage stage);
+        ~ProfilerRendererScope();
+
+    private:
+        RendererStage _stage;
+        UINT64 _startTime;
+    };
+
+    /** Provides global access to ProfilerRenderer instance. */
+    TE_CORE_EXPORT ProfilerRenderer& gProfilerRenderer();
+
+    /** Profiling macros that allow profiling functionality to be disabled at compile time. */
+#if TE_PROFILING_ENABLED
+#   define TE_RENDERER_PROFILE_BEGIN() gProfilerRenderer().BeginFrame();
+#   define TE_RENDERER_PROFILE_END() gProfilerRenderer().EndFrame();
+#else
+#   define TE_RENDERER_PROFILE_BEGIN()
+#   define TE_RENDERER_PROFILE_END()
+#endif
+}
@@ -46,6 +46,7 @@ namespace te
 #endif
 
         memcpy(_cachedData + offset, data, size);
+        _dirtyRangeEnd = std::max(_dirtyRangeEnd, offset + size);
         _GPUBufferDirty = true;
     }
 
@@ -74,6 +75,7 @@ namespace te
 #endif
 
         memset(_cachedData + offset, 0, size);
+        _dirtyRangeEnd = std::max(_dirtyRangeEnd, offset + size);
         _GPUBufferDirty = true;
     }
 
@@ -83,9 +85,22 @@ namespace te
         {
             WriteToGPU(_cachedData, queueIdx);
             _GPUBufferDirty = false;
+            _dirtyRangeEnd = 0;
         }
     }
 
+    void GpuParamBlockBuffer::FlushDirtyRangeToGPU(UINT32 queueIdx)
+    {
+        if (_GPUBufferDirty && _dirtyRangeEnd > 0)
+        {
+            _buffer->WriteData(0, _dirtyRangeEnd, _cachedData, BWT_DISCARD, queueIdx);
+            TE_INC_PROFILER_GPU(ResWrite);
+        }
+
+        _GPUBufferDirty = false;
+        _dirtyRangeEnd = 0;
+    }
+
     void GpuParamBlockBuffer::WriteToGPU(const UINT8* data, UINT32 queueIdx)
     {
         _buffer->WriteData(0, _size, data, BWT_DISCARD, queueIdx);
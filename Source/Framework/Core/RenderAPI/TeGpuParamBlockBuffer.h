@@ -46,6 +46,16 @@ namespace te
          */
         void FlushToGPU(UINT32 queueIdx = 0);
 
+        /**
+         * Flushes cached data into the actual GPU buffer, but only up to the end of the range written since the last
+         * flush. The buffer is discarded before the write, which means anything past the written range is undefined on
+         * the GPU afterwards. Only use this on buffers which are entirely rewritten before each use (e.g. transient
+         * per-instance data), where the GPU never reads past the last written byte.
+         *
+         * @param[in]	queueIdx	Device queue to perform the write operation on. See @ref queuesDoc.
+         */
+        void FlushDirtyRangeToGPU(UINT32 queueIdx = 0);
+
         /**
          * Clear specified section of the buffer to zero.
          *
@@ -56,6 +66,9 @@ namespace te
         /** Returns internal cached data of the buffer. */
         const UINT8* GetCachedData() const { return _cachedData; }
 
+        /** Returns the offset, in bytes, of the end of the range written since the last flush. */
+        UINT32 GetDirtyRangeEnd() const { return _dirtyRangeEnd; }
+
         /**	Returns the size of the buffer in bytes. */
         UINT32 GetSize() const { return _size; }
 
@@ -75,5 +88,6 @@ namespace te
         UINT32 _size;
         UINT8* _cachedData;
         bool _GPUBufferDirty = false;
+        UINT32 _dirtyRangeEnd = 0;
     };
 }
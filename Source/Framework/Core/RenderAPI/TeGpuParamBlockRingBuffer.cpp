@@ -0,0 +1,49 @@
+#include "RenderAPI/TeGpuParamBlockRingBuffer.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+
+namespace te
+{
+    GpuParamBlockRingBuffer::GpuParamBlockRingBuffer(UINT32 blockSize, UINT32 initialNumBlocks)
+        : _blockSize(blockSize)
+    {
+        _blocks.reserve(initialNumBlocks);
+
+        for (UINT32 i = 0; i < initialNumBlocks; i++)
+            _blocks.push_back(GpuParamBlockBuffer::Create(_blockSize));
+    }
+
+    GpuParamBlockRingBuffer::~GpuParamBlockRingBuffer()
+    { }
+
+    void GpuParamBlockRingBuffer::BeginFrame()
+    {
+        _head = 0;
+        _flushed = 0;
+    }
+
+    const SPtr<GpuParamBlockBuffer>& GpuParamBlockRingBuffer::Allocate()
+    {
+        if (_head == (UINT32)_blocks.size())
+            _blocks.push_back(GpuParamBlockBuffer::Create(_blockSize));
+
+        return _blocks[_head++];
+    }
+
+    void GpuParamBlockRingBuffer::Flush(UINT32 queueIdx)
+    {
+        for (UINT32 i = _flushed; i < _head; i++)
+            _blocks[i]->FlushDirtyRangeToGPU(queueIdx);
+
+        _flushed = _head;
+    }
+
+    void GpuParamBlockRingBuffer::Destroy()
+    {
+        for (auto& block : _blocks)
+            block->Destroy();
+
+        _blocks.clear();
+        _head = 0;
+        _flushed = 0;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    /**
+     * Per-frame linear allocator of parameter block buffers, used for transient constants which are rewritten every
+     * frame (e.g. per-instance data). Blocks are handed out in order from the beginning of the ring each frame, and new
+     * blocks are created on demand when the ring is exhausted, so there is no upper limit to the number of blocks which
+     * can be used in a single frame.
+     *
+     * Render APIs bind whole parameter block buffers, so a block is the smallest unit which can be allocated. Each block
+     * keeps track of the range written during the frame, and only that range is uploaded (once) when the ring is flushed.
+     */
+    class TE_CORE_EXPORT GpuParamBlockRingBuffer
+    {
+    public:
+        /**
+         * @param[in]	blockSize			Size of a single block, in bytes.
+         * @param[in]	initialNumBlocks	Number of blocks to create up front.
+         */
+        GpuParamBlockRingBuffer(UINT32 blockSize, UINT32 initialNumBlocks = 0);
+        ~GpuParamBlockRingBuffer();
+
+        /** Rewinds the ring. Blocks allocated during the previous frame can be reused. */
+        void BeginFrame();
+
+        /** Returns the next free block, creating a new one if all existing blocks are already in use this frame. */
+        const SPtr<GpuParamBlockBuffer>& Allocate();
+
+        /**
+         * Uploads the written range of every block allocated since the last flush. Must be called before the blocks are
+         * used for rendering, and after all the data has been written.
+         *
+         * @param[in]	queueIdx	Device queue to perform the write operation on. See @ref queuesDoc.
+         */
+        void Flush(UINT32 queueIdx = 0);
+
+        /** Destroys all the blocks. */
+        void Destroy();
+
+        /** Returns the size of a single block, in bytes. */
+        UINT32 GetBlockSize() const { return _blockSize; }
+
+        /** Returns the number of blocks allocated since the beginning of the frame. */
+        UINT32 GetNumUsedBlocks() const { return _head; }
+
+        /** Returns the total number of blocks created by the ring. */
+        UINT32 GetNumBlocks() const { return (UINT32)_blocks.size(); }
+
+    private:
+        UINT32 _blockSize;
+        Vector<SPtr<GpuParamBlockBuffer>> _blocks;
+        UINT32 _head = 0;
+        UINT32 _flushed = 0;
+    };
+}
@@ -22,6 +22,7 @@ namespace te
     void RenderAPI::Destroy()
     {
         _activeRenderTarget = nullptr;
+        _stateCache.Invalidate();
     }
 
     const RenderAPICapabilities& RenderAPI::GetCapabilities(UINT32 deviceIdx) const
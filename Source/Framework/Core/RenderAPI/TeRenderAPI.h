@@ -5,6 +5,7 @@
 #include "RenderAPI/TeRenderTarget.h"
 #include "RenderAPI/TeRenderWindow.h"
 #include "RenderAPI/TeRenderAPICapabilities.h"
+#include "RenderAPI/TeRenderAPIStateCache.h"
 #include "Image/TeColor.h"
 
 #define TE_MAX_BOUND_VERTEX_BUFFERS 16
@@ -231,10 +232,18 @@ namespace te
         /** Converts the number of vertices to number of primitives based on the specified draw operation. */
         UINT32 VertexCountToPrimCount(DrawOperationType type, UINT32 elementCount);
 
+        /**
+         * Forgets about everything currently bound to the pipeline. Must be called if some code binds states directly
+         * through the underlying render API without restoring them afterwards.
+         */
+        void InvalidateStateCache() { _stateCache.Invalidate(); }
+
     protected:
         SPtr<RenderTarget> _activeRenderTarget;
         bool _activeRenderTargetModified = false;
 
+        RenderAPIStateCache _stateCache;
+
         SPtr<VideoModeInfo> _videoModeInfo;
         UINT32 _numDevices;
         RenderAPICapabilities* _capabilities;
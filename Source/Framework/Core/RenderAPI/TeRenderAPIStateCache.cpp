@@ -0,0 +1,154 @@
+#include "RenderAPI/TeRenderAPIStateCache.h"
+#include "RenderAPI/TeGpuPipelineState.h"
+#include "RenderAPI/TeVertexBuffer.h"
+#include "RenderAPI/TeIndexBuffer.h"
+#include "Profiling/TeProfilerGPU.h"
+
+namespace te
+{
+    RenderAPIStateCache::RenderAPIStateCache()
+    {
+        Invalidate();
+    }
+
+    bool RenderAPIStateCache::SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+    {
+        if (pipelineState != nullptr && _graphicsPipeline == pipelineState)
+        {
+            NotifyFiltered(1);
+            return false;
+        }
+
+        // Graphics and compute programs share the same slots on most render APIs
+        _graphicsPipeline = pipelineState;
+        _computePipeline = nullptr;
+
+        return true;
+    }
+
+    bool RenderAPIStateCache::SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
+    {
+        if (pipelineState != nullptr && _computePipeline == pipelineState)
+        {
+            NotifyFiltered(1);
+            return false;
+        }
+
+        _computePipeline = pipelineState;
+        _graphicsPipeline = nullptr;
+
+        return true;
+    }
+
+    bool RenderAPIStateCache::SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+    {
+        if (index + numBuffers > TE_STATE_CACHE_MAX_VERTEX_BUFFERS)
+            return true;
+
+        bool dirty = false;
+        for (UINT32 i = 0; i < numBuffers; i++)
+        {
+            if (_vertexBuffers[index + i] != buffers[i])
+            {
+                _vertexBuffers[index + i] = buffers[i];
+                dirty = true;
+            }
+        }
+
+        if (!dirty)
+            NotifyFiltered(1);
+
+        return dirty;
+    }
+
+    bool RenderAPIStateCache::SetIndexBuffer(const SPtr<IndexBuffer>& buffer)
+    {
+        if (buffer != nullptr && _indexBuffer == buffer)
+        {
+            NotifyFiltered(1);
+            return false;
+        }
+
+        _indexBuffer = buffer;
+        return true;
+    }
+
+    bool RenderAPIStateCache::SetStencilRef(UINT32 value)
+    {
+        if (_stencilRefValid && _stencilRef == value)
+        {
+            NotifyFiltered(1);
+            return false;
+        }
+
+        _stencilRef = value;
+        _stencilRefValid = true;
+        return true;
+    }
+
+    bool RenderAPIStateCache::SetSlots(GpuProgramType type, SlotType slotType, UINT32 startSlot, void* const* handles,
+        UINT32 numHandles, UINT32& first, UINT32& count)
+    {
+        UINT32 firstDirty = std::numeric_limits<UINT32>::max();
+        UINT32 lastDirty = 0;
+
+        void** slots = _slots[type][(UINT32)slotType];
+        bool* slotsValid = _slotsValid[type][(UINT32)slotType];
+
+        for (UINT32 i = 0; i < numHandles; i++)
+        {
+            UINT32 slot = startSlot + i;
+
+            // Slots we are not able to track are always bound
+            if (slot < TE_STATE_CACHE_MAX_SLOTS)
+            {
+                if (slotsValid[slot] && slots[slot] == handles[i])
+                    continue;
+
+                slots[slot] = handles[i];
+                slotsValid[slot] = true;
+            }
+
+            firstDirty = std::min(firstDirty, slot);
+            lastDirty = std::max(lastDirty, slot);
+        }
+
+        if (firstDirty == std::numeric_limits<UINT32>::max())
+        {
+            NotifyFiltered(numHandles);
+            return false;
+        }
+
+        first = firstDirty;
+        count = lastDirty - firstDirty + 1;
+        NotifyFiltered(numHandles - count);
+
+        return true;
+    }
+
+    void RenderAPIStateCache::InvalidateSlots(SlotType slotType)
+    {
+        for (UINT32 i = 0; i < GPT_COUNT; i++)
+            memset(_slotsValid[i][(UINT32)slotType], 0, sizeof(bool) * TE_STATE_CACHE_MAX_SLOTS);
+    }
+
+    void RenderAPIStateCache::Invalidate()
+    {
+        _graphicsPipeline = nullptr;
+        _computePipeline = nullptr;
+        _indexBuffer = nullptr;
+        _stencilRefValid = false;
+
+        for (UINT32 i = 0; i < TE_STATE_CACHE_MAX_VERTEX_BUFFERS; i++)
+            _vertexBuffers[i] = nullptr;
+
+        te_zero_out(_slots);
+        te_zero_out(_slotsValid);
+    }
+
+    void RenderAPIStateCache::NotifyFiltered(UINT32 count)
+    {
+        if (count > 0)
+            TE_ADD_PROFILER_GPU(NumFilteredBinds, count);
+    }
+}
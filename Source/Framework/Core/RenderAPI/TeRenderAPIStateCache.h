@@ -0,0 +1,90 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "RenderAPI/TeCommonTypes.h"
+
+#define TE_STATE_CACHE_MAX_SLOTS 32
+#define TE_STATE_CACHE_MAX_VERTEX_BUFFERS 32
+
+namespace te
+{
+    /**
+     * Keeps track of everything which is currently bound to the pipeline, independently of the render API used. Render
+     * API implementations query this cache before issuing a bind to the device and skip the call if the exact same
+     * object is already bound. Every filtered bind is reported to the GPU profiler.
+     *
+     * Pipelines, vertex and index buffers are tracked using engine objects. Resources bound to GPU program slots are
+     * tracked using opaque handles provided by the render API (e.g. a shader resource view), it is up to the render API
+     * to guarantee that a handle can't be reused by another resource while it is still bound.
+     */
+    class TE_CORE_EXPORT RenderAPIStateCache
+    {
+    public:
+        /** Kind of resources which can be bound to a GPU program slot. */
+        enum class SlotType
+        {
+            ParamBlock,
+            Texture,
+            Sampler,
+            Count // Keep at end
+        };
+
+    public:
+        RenderAPIStateCache();
+        ~RenderAPIStateCache() = default;
+
+        /** Returns true if the provided pipeline is not already bound. Records it as the bound graphics pipeline. */
+        bool SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState);
+
+        /** Returns true if the provided pipeline is not already bound. Records it as the bound compute pipeline. */
+        bool SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState);
+
+        /** Returns true if at least one of the provided vertex buffers is not already bound at its slot. */
+        bool SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers);
+
+        /** Returns true if the provided index buffer is not already bound. */
+        bool SetIndexBuffer(const SPtr<IndexBuffer>& buffer);
+
+        /** Returns true if the provided stencil reference value is not already in use. */
+        bool SetStencilRef(UINT32 value);
+
+        /**
+         * Filters a bind of a contiguous range of slots for a GPU program stage.
+         *
+         * @param[in]	type		GPU program stage the resources are bound to.
+         * @param[in]	slotType	Kind of resources bound.
+         * @param[in]	startSlot	First slot of the range.
+         * @param[in]	handles		Opaque handles of the resources to bind, one per slot.
+         * @param[in]	numHandles	Number of slots in the range.
+         * @param[out]	first		First slot which really needs to be bound.
+         * @param[out]	count		Number of slots which really needs to be bound, starting at @p first.
+         * @return					False if all the slots in the range are already bound with the provided resources.
+         */
+        bool SetSlots(GpuProgramType type, SlotType slotType, UINT32 startSlot, void* const* handles, UINT32 numHandles,
+            UINT32& first, UINT32& count);
+
+        /**
+         * Forgets about every resource of the specified kind. Must be called when the render API unbinds resources
+         * implicitly (e.g. a texture bound as a render target can't stay bound as a shader resource).
+         */
+        void InvalidateSlots(SlotType slotType);
+
+        /** Forgets about everything which is bound. Next binds will always reach the render API. */
+        void Invalidate();
+
+    private:
+        /** Reports filtered binds to the GPU profiler. */
+        void NotifyFiltered(UINT32 count);
+
+    private:
+        SPtr<GraphicsPipelineState> _graphicsPipeline;
+        SPtr<ComputePipelineState> _computePipeline;
+        SPtr<VertexBuffer> _vertexBuffers[TE_STATE_CACHE_MAX_VERTEX_BUFFERS];
+        SPtr<IndexBuffer> _indexBuffer;
+        UINT32 _stencilRef = 0;
+        bool _stencilRefValid = false;
+
+        void* _slots[GPT_COUNT][(UINT32)SlotType::Count][TE_STATE_CACHE_MAX_SLOTS];
+        bool _slotsValid[GPT_COUNT][(UINT32)SlotType::Count][TE_STATE_CACHE_MAX_SLOTS];
+    };
+}
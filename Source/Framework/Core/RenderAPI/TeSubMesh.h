@@ -6,6 +6,20 @@
 
 namespace te
 {
+    /** Range of indices used to render a simplified level of detail of a sub-mesh. */
+    struct TE_CORE_EXPORT SubMeshLOD
+    {
+        SubMeshLOD() = default;
+
+        SubMeshLOD(UINT32 indexOffset, UINT32 indexCount)
+            : IndexOffset(indexOffset)
+            , IndexCount(indexCount)
+        { }
+
+        UINT32 IndexOffset = 0;
+        UINT32 IndexCount = 0;
+    };
+
     /** Data about a sub-mesh range and the type of primitives contained in the range. */
     struct TE_CORE_EXPORT SubMesh
     {
@@ -42,5 +56,26 @@ namespace te
 
         /** During mesh initialization, we also want to know bounds of a single subMesh below a mesh */
         Bounds SubMeshBounds;
+
+        /**
+         * Simplified versions of this sub-mesh, from the most detailed to the least detailed one. They reference the same
+         * vertices as the sub-mesh itself. Level of detail 0 is the sub-mesh range, so LODs[0] is level of detail 1.
+         */
+        Vector<SubMeshLOD> LODs;
+
+        /** Returns the index range to draw for the specified level of detail. Falls back to the coarsest available one. */
+        void GetLODRange(UINT32 lod, UINT32& indexOffset, UINT32& indexCount) const
+        {
+            if (lod == 0 || LODs.empty())
+            {
+                indexOffset = IndexOffset;
+                indexCount = IndexCount;
+                return;
+            }
+
+            const SubMeshLOD& range = LODs[std::min(lod, (UINT32)LODs.size()) - 1];
+            indexOffset = range.IndexOffset;
+            indexCount = range.IndexCount;
+        }
     };
 }
@@ -140,6 +140,7 @@ namespace te
 		}																													\
 																															\
 		SPtr<GpuParamBlockBuffer> CreateBuffer() const { return GpuParamBlockBuffer::Create(_blockSize); }					\
+		UINT32 GetBlockSize() const { return _blockSize; }																	\
 																															\
 	private:																												\
 		friend class ParamBlockManager;																						\
@@ -31,6 +31,9 @@ namespace te
         /** We can know if the element is instanced or not */
         int InstanceCount = 0;
 
+        /** Level of detail of the sub-mesh to draw, selected by the renderer each time the element is queued. */
+        UINT32 LODIdx = 0;
+
         /*  All params used by this element for all passes */
         Vector<SPtr<GpuParams>> GpuParamsElem;
 
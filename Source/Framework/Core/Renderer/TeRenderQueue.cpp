@@ -3,8 +3,6 @@
 #include "Material/TeShader.h"
 #include "Renderer/TeRenderElement.h"
 
-#include <functional>
-
 using namespace std::placeholders;
 
 namespace te
@@ -86,7 +84,10 @@ namespace te
         if (_stateReductionMode != StateReduction::Never)
         {
             // Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-            std::sort(_sortableElementIdx.begin(), _sortableElementIdx.end(), std::bind(sortMethod, _1, _2, _sortableElements));
+            if (_coherentSorting)
+                SortCoherent(sortMethod);
+            else
+                std::sort(_sortableElementIdx.begin(), _sortableElementIdx.end(), std::bind(sortMethod, _1, _2, std::cref(_sortableElements)));
         }
 
         UINT32 prevShaderId = (UINT32)-1;
@@ -148,6 +149,91 @@ namespace te
         }
     }
 
+    void RenderQueue::SortCoherent(const std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)>& sortMethod)
+    {
+        const UINT32 numElements = (UINT32)_sortableElementIdx.size();
+
+        if (numElements < COHERENT_SORTING_MIN_ELEMENTS)
+        {
+            // Small queues are fully sorted, their previous order would be outdated once they grow again
+            std::sort(_sortableElementIdx.begin(), _sortableElementIdx.end(), std::bind(sortMethod, _1, _2, std::cref(_sortableElements)));
+            _previousOrder.clear();
+            return;
+        }
+
+        if (_coherentSortingCooldown > 0)
+        {
+            // The order changed too much during the last frames, an insertion sort would most likely give up again
+            _coherentSortingCooldown--;
+            std::sort(_sortableElementIdx.begin(), _sortableElementIdx.end(), std::bind(sortMethod, _1, _2, std::cref(_sortableElements)));
+        }
+        else
+        {
+            // Passes of an element are added one after the other, only the first one is referenced
+            _elementLookup.clear();
+            _elementLookup.reserve(numElements);
+            for (UINT32 i = 0; i < numElements; i++)
+            {
+                if (i == 0 || _elements[i] != _elements[i - 1])
+                    _elementLookup.insert(std::make_pair(_elements[i], i));
+            }
+
+            _placedElements.assign(numElements, false);
+            _sortableElementIdx.clear();
+
+            for (auto& element : _previousOrder)
+            {
+                auto iterFind = _elementLookup.find(element);
+                if (iterFind == _elementLookup.end())
+                    continue;
+
+                for (UINT32 i = iterFind->second; i < numElements && _elements[i] == element && !_placedElements[i]; i++)
+                {
+                    _sortableElementIdx.push_back(i);
+                    _placedElements[i] = true;
+                }
+            }
+
+            for (UINT32 i = 0; i < numElements; i++)
+            {
+                if (!_placedElements[i])
+                    _sortableElementIdx.push_back(i);
+            }
+
+            // Elements are compared with their sequence index last, so insertion sort gives the same order as a full sort.
+            // If the order changed too much since the previous frame (e.g. camera cut), a full sort is faster.
+            const UINT32 maxMoves = numElements * 4 + 64;
+            UINT32 numMoves = 0;
+            for (UINT32 i = 1; i < numElements && numMoves <= maxMoves; i++)
+            {
+                const UINT32 idx = _sortableElementIdx[i];
+
+                UINT32 j = i;
+                while (j > 0 && sortMethod(idx, _sortableElementIdx[j - 1], _sortableElements))
+                {
+                    _sortableElementIdx[j] = _sortableElementIdx[j - 1];
+                    j--;
+                }
+
+                _sortableElementIdx[j] = idx;
+                numMoves += i - j;
+            }
+
+            if (numMoves > maxMoves)
+            {
+                std::sort(_sortableElementIdx.begin(), _sortableElementIdx.end(), std::bind(sortMethod, _1, _2, std::cref(_sortableElements)));
+                _coherentSortingCooldown = COHERENT_SORTING_COOLDOWN;
+            }
+        }
+
+        _previousOrder.clear();
+        for (auto& idx : _sortableElementIdx)
+        {
+            if (_previousOrder.empty() || _previousOrder.back() != _elements[idx])
+                _previousOrder.push_back(_elements[idx]);
+        }
+    }
+
     void RenderQueue::Clear()
     {
         _sortableElements.clear();
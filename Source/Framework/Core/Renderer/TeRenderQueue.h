@@ -2,6 +2,8 @@
 
 #include "TeCorePrerequisites.h"
 
+#include <functional>
+
 namespace te 
 {
     class RendererView;
@@ -30,6 +32,7 @@ namespace te
      */
     class TE_CORE_EXPORT RenderQueue
     {
+    protected:
         /**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
         struct SortableElement
         {
@@ -66,7 +69,23 @@ namespace te
          */
         void SetStateReduction(StateReduction mode) { _stateReductionMode = mode; }
 
+        /**
+         * When enabled, Sort() starts from the order of the previous frame and fixes it with an insertion sort, which is
+         * close to linear when elements only move slightly from one frame to another (e.g. transparent elements sorted by
+         * distance while the camera moves). The sorted order is the same as without coherent sorting. Queues with less
+         * than COHERENT_SORTING_MIN_ELEMENTS elements are always fully sorted, as finding the previous order of their
+         * elements costs more than it saves.
+         */
+        void SetCoherentSorting(bool enabled) { _coherentSorting = enabled; }
+
     protected:
+        /**
+         * Orders _sortableElementIdx like the previous frame, elements not sorted during the previous frame being moved
+         * at the end, then sorts it using an insertion sort. Falls back to a full sort if the order changed too much, and
+         * keeps on using full sorts for COHERENT_SORTING_COOLDOWN frames, as the order is likely to keep changing fast.
+         */
+        void SortCoherent(const std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)>& sortMethod);
+
         /**	Callback used for sorting elements with no material grouping. */
         static bool ElementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
 
@@ -83,5 +102,17 @@ namespace te
 
         Vector<RenderQueueElement> _sortedRenderElements;
         StateReduction _stateReductionMode;
+
+        /** Number of frames during which full sorts are used after the insertion sort of SortCoherent() gave up. */
+        static constexpr UINT32 COHERENT_SORTING_COOLDOWN = 15;
+
+        /** Minimum number of elements for which SortCoherent() doesn't simply use a full sort. */
+        static constexpr UINT32 COHERENT_SORTING_MIN_ELEMENTS = 64;
+
+        bool _coherentSorting = false;
+        UINT32 _coherentSortingCooldown = 0;
+        Vector<const RenderElement*> _previousOrder;
+        UnorderedMap<const RenderElement*, UINT32> _elementLookup;
+        Vector<bool> _placedElements;
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Animation/TeAnimation.h"
 #include "Animation/TeAnimationManager.h"
 #include "RenderAPI/TeGpuBuffer.h"
+#include "Serialization/TeBinaryStream.h"
 
 namespace te
 {
@@ -33,6 +34,37 @@ namespace te
         return buffer;
     }
 
+    void RenderableProperties::Serialize(BinaryWriter& writer) const
+    {
+        writer.Write(Instancing);
+        writer.Write(CanBeMerged);
+        writer.Write(CastShadows);
+        writer.Write(CastLights);
+        writer.Write(ReceiveShadows);
+        writer.Write(UseForDynamicEnvMapping);
+        writer.Write(WriteVelocity);
+        writer.Write(CullDistanceFactor);
+    }
+
+    bool RenderableProperties::Deserialize(BinaryReader& reader)
+    {
+        RenderableProperties properties;
+        reader.Read(properties.Instancing);
+        reader.Read(properties.CanBeMerged);
+        reader.Read(properties.CastShadows);
+        reader.Read(properties.CastLights);
+        reader.Read(properties.ReceiveShadows);
+        reader.Read(properties.UseForDynamicEnvMapping);
+        reader.Read(properties.WriteVelocity);
+        reader.Read(properties.CullDistanceFactor);
+
+        if (reader.HasFailed())
+            return false;
+
+        *this = properties;
+        return true;
+    }
+
     Renderable::Renderable()
         : _rendererId(0)
         , _animationId((UINT64)-1)
@@ -8,12 +8,20 @@
 namespace te
 {
     struct EvaluatedAnimationData;
+    class BinaryWriter;
+    class BinaryReader;
 
-    struct RenderableProperties
+    struct TE_CORE_EXPORT RenderableProperties
     {
         RenderableProperties()
         { }
 
+        /** Writes all the properties, see CRenderable::Serialize(). */
+        void Serialize(BinaryWriter& writer) const;
+
+        /** Reads properties written by Serialize(). Returns false, leaving the properties untouched, if data is missing. */
+        bool Deserialize(BinaryReader& reader);
+
         bool Instancing  = false;
         bool CanBeMerged = false;
         bool CastShadows = true;
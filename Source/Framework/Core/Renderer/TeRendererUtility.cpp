@@ -105,7 +105,7 @@ namespace te
         Draw(mesh, mesh->GetProperties().GetSubMesh(0), numInstances);
     }
 
-    void RendererUtility::Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances)
+    void RendererUtility::Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances, UINT32 lod)
     {
         RenderAPI& rapi = RenderAPI::Instance();
         SPtr<VertexData> vertexData = mesh->GetVertexData();
@@ -141,16 +141,18 @@ namespace te
 
         rapi.SetDrawOperation(subMesh.DrawOp);
 
-        UINT32 indexCount = subMesh.IndexCount;
+        UINT32 indexOffset = 0;
+        UINT32 indexCount = 0;
+        subMesh.GetLODRange(lod, indexOffset, indexCount);
 
         if (numInstances > 1)
         {
-            rapi.DrawIndexed(subMesh.IndexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
+            rapi.DrawIndexed(indexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
                 vertexData->vertexCount, numInstances);
         }
         else
         {
-            rapi.DrawIndexed(subMesh.IndexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
+            rapi.DrawIndexed(indexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
                 vertexData->vertexCount, 0);
         }
 
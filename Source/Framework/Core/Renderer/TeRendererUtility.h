@@ -68,10 +68,11 @@ namespace te
          * @param[in]	mesh			Mesh to draw.
          * @param[in]	subMesh			Portion of the mesh to draw.
          * @param[in]	numInstances	Number of times to draw the mesh using instanced rendering.
+         * @param[in]	lod				Level of detail of the sub-mesh to draw (see SubMesh::LODs).
          *
          * @note	Core thread.
          */
-        void Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1);
+        void Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1, UINT32 lod = 0);
 
         /**
          * Draws a quad over the entire viewport in normalized device coordinates.
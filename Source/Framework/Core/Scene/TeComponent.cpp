@@ -1,6 +1,7 @@
 #include "Scene/TeComponent.h"
 #include "Scene/TeSceneObject.h"
 #include "Math/TeBounds.h"
+#include "Serialization/TeBinaryStream.h"
 
 namespace te
 { 
@@ -43,6 +44,18 @@ namespace te
         SO()->DestroyComponent(this, immediate);
     }
 
+    void Component::Serialize(BinaryWriter& writer) const
+    {
+        writer.Write(_UUID);
+        writer.Write(_name);
+    }
+
+    void Component::Deserialize(BinaryReader& reader)
+    {
+        reader.Read(_UUID);
+        reader.Read(_name);
+    }
+
     void Component::DestroyInternal(GameObjectHandleBase& handle, bool immediate)
     {
         if (immediate)
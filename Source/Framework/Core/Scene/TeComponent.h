@@ -6,8 +6,24 @@
 
 namespace te
 {
+    class BinaryWriter;
+    class BinaryReader;
+
     typedef UINT32 ComponentFlags;
 
+    /** Flags that determine how the SceneManager calls Component::Update() on components of a type. */
+    enum ComponentUpdateFlags
+    {
+        CUF_None = 0x00, /**< Update() is never called, for components that don't need it. */
+        CUF_Update = 0x01, /**< Update() is called once per frame. */
+        /**
+         * Components of the type can be updated on worker threads, while other types flagged the same way are updated.
+         * Update() must then only modify data owned by the component. It must not read the world transform of scene
+         * objects either: world transforms are computed lazily and cached by SceneObject and TransformHierarchy.
+         */
+        CUF_Parallel = 0x02
+    };
+
     /**
      * Components represent primary logic elements in the scene. They are attached to scene objects.
      *
@@ -43,6 +59,13 @@ namespace te
         /** Called once per frame. Only called if the component is in Running state. */
         virtual void Update() { }
 
+        /**
+         * Returns a combination of ComponentUpdateFlags that determines how Update() is called. Read once when the
+         * component is registered by the SceneManager, and must be the same for all the components of a type. Components
+         * that don't override Update() should return CUF_None so they are skipped.
+         */
+        virtual UINT32 GetUpdateFlags() const { return CUF_Update; }
+
         /**
          * Calculates bounds of the visible contents represented by this component (for example a mesh for Renderable).
          *
@@ -84,6 +107,18 @@ namespace te
             _name = c->GetName() + " copy";
         }
 
+        /**
+         * Writes the state of the component when its scene object is saved, see SceneSerializer. Resources must be
+         * written as UUIDs.
+         */
+        virtual void Serialize(BinaryWriter& writer) const;
+
+        /**
+         * Restores the state written by Serialize(). Called after the component is created, before it is initialized.
+         * BinaryReader::GetVersion() returns the version of the format the data was written with.
+         */
+        virtual void Deserialize(BinaryReader& reader);
+
     public:
         /**
          * Construct any resources the component needs before use. Called when the parent scene object is instantiated.
@@ -1,11 +1,12 @@
 #include "Scene/TeGameObject.h"
 #include "Scene/TeGameObjectManager.h"
+#include "Scene/TeGameObjectPool.h"
 
 namespace te
 {
     void GameObject::Initialize(const SPtr<GameObject>& object, UINT64 instanceId)
     {
-        _instanceData = te_shared_ptr_new<GameObjectInstanceData>();
+        _instanceData = std::allocate_shared<GameObjectInstanceData>(GameObjectPoolAllocator<GameObjectInstanceData>());
         _instanceData->Object = object;
         _instanceData->InstanceId = instanceId;
     }
@@ -1,12 +1,15 @@
 #include "TeCorePrerequisites.h"
 #include "Scene/TeGameObjectHandle.h"
 #include "Scene/TeGameObject.h"
+#include "Scene/TeGameObjectPool.h"
 
 namespace te
 { 
     GameObjectHandleBase::GameObjectHandleBase(const SPtr<GameObject>& ptr)
     {
-        _data = te_shared_ptr_new<GameObjectHandleData>(ptr->_instanceData);
+        // Created for each registered object, so it comes from a pool like the object itself
+        _data = std::allocate_shared<GameObjectHandleData>(GameObjectPoolAllocator<GameObjectHandleData>(),
+            ptr->_instanceData);
     }
 
     bool GameObjectHandleBase::IsDestroyed(bool checkQueued) const
@@ -12,19 +12,19 @@ namespace te
 
     GameObjectHandleBase GameObjectManager::GetObjectHandle(UINT64 id) const
     {
-        const auto iterFind = _objects.find(id);
-        if (iterFind != _objects.end())
-            return iterFind->second;
+        const ObjectSlot* slot = FindSlot(id);
+        if (slot != nullptr)
+            return slot->Handle;
 
         return nullptr;
     }
 
     bool GameObjectManager::TryGetObjectHandle(UINT64 id, GameObjectHandleBase& object) const
     {
-        const auto iterFind = _objects.find(id);
-        if (iterFind != _objects.end())
+        const ObjectSlot* slot = FindSlot(id);
+        if (slot != nullptr)
         {
-            object = iterFind->second;
+            object = slot->Handle;
             return true;
         }
 
@@ -33,7 +33,7 @@ namespace te
 
     bool GameObjectManager::ObjectExists(UINT64 id) const
     {
-        return _objects.find(id) != _objects.end();
+        return FindSlot(id) != nullptr;
     }
 
     void GameObjectManager::RemapId(UINT64 oldId, UINT64 newId)
@@ -41,13 +41,40 @@ namespace te
         if (oldId == newId)
             return;
 
-        _objects[newId] = _objects[oldId];
-        _objects.erase(oldId);
-    }
+        if (FindSlot(oldId) == nullptr)
+            return;
 
-    UINT64 GameObjectManager::ReserveId()
-    {
-        return _nextAvailableID.fetch_add(1, std::memory_order_relaxed);
+        const UINT32 oldSlotIdx = GetSlotIndex(oldId);
+        const UINT32 newSlotIdx = GetSlotIndex(newId);
+        if (newSlotIdx >= (UINT32)_slots.size())
+            _slots.resize(newSlotIdx + 1);
+
+        ObjectSlot& oldSlot = _slots[oldSlotIdx];
+        ObjectSlot& newSlot = _slots[newSlotIdx];
+        GameObject* object = oldSlot.Object;
+
+        // Handle data is shared by all the handles to the object, so they all follow the object's new instance data
+        oldSlot.Handle._setHandleData(object->_instanceData->Object);
+
+        // The object took the slot of the object it is restored from, only the generation changes
+        if (oldSlotIdx == newSlotIdx)
+        {
+            newSlot.Generation = GetGeneration(newId);
+            return;
+        }
+
+        TE_ASSERT_ERROR(newSlot.Object == nullptr, "Cannot remap object, ID is already used by another object.");
+
+        // Rarely used (when restoring an object with an existing ID), so the linear search is acceptable
+        const auto iterFind = std::find(_freeSlots.begin(), _freeSlots.end(), newSlotIdx);
+        if (iterFind != _freeSlots.end())
+            _freeSlots.erase(iterFind);
+
+        newSlot.Handle = oldSlot.Handle;
+        newSlot.Object = object;
+        newSlot.Generation = GetGeneration(newId);
+
+        ReleaseSlot(oldSlotIdx);
     }
 
     void GameObjectManager::QueueForDestroy(const GameObjectHandleBase& object)
@@ -55,35 +82,110 @@ namespace te
         if (object.IsDestroyed())
             return;
 
-        const UINT64 instanceId = object->GetInstanceId();
-        _queuedForDestroy[instanceId] = object;
+        _queuedForDestroy.push_back(object);
     }
 
     void GameObjectManager::DestroyQueuedObjects()
     {
-        for (auto& objPair : _queuedForDestroy)
-            objPair.second->DestroyInternal(objPair.second, true);
+        while (!_queuedForDestroy.empty())
+        {
+            _destroyBatch.swap(_queuedForDestroy);
+
+            // Sorting groups objects queued several times, and visits the slots in order. The generation is in the upper
+            // bits of the ID, so IDs are sorted by slot first.
+            std::sort(_destroyBatch.begin(), _destroyBatch.end(),
+                [](const GameObjectHandleBase& a, const GameObjectHandleBase& b)
+                {
+                    const UINT64 aId = a.GetInstanceId();
+                    const UINT64 bId = b.GetInstanceId();
+
+                    if (GetSlotIndex(aId) != GetSlotIndex(bId))
+                        return GetSlotIndex(aId) < GetSlotIndex(bId);
 
-        _queuedForDestroy.clear();
+                    return GetGeneration(aId) < GetGeneration(bId);
+                });
+
+            UINT64 lastId = 0;
+            for (auto& object : _destroyBatch)
+            {
+                const UINT64 instanceId = object.GetInstanceId();
+                if (instanceId == lastId)
+                    continue;
+
+                lastId = instanceId;
+
+                // Children are destroyed along with their parent, so they might already be destroyed
+                if (!object.IsDestroyed())
+                    object->DestroyInternal(object, true);
+            }
+
+            _destroyBatch.clear();
+        }
     }
 
     GameObjectHandleBase GameObjectManager::RegisterObject(const SPtr<GameObject>& object)
     {
-        const UINT64 id = _nextAvailableID.fetch_add(1, std::memory_order_relaxed);
-        object->Initialize(object, id);
-
-        GameObjectHandleBase handle(object);
+        UINT32 slotIdx;
+        if (!_freeSlots.empty())
+        {
+            slotIdx = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+        else
         {
-            _objects[id] = handle;
+            slotIdx = (UINT32)_slots.size();
+            _slots.emplace_back();
         }
 
+        ObjectSlot& slot = _slots[slotIdx];
+        object->Initialize(object, MakeId(slotIdx, slot.Generation));
+
+        GameObjectHandleBase handle(object);
+        slot.Handle = handle;
+        slot.Object = object.get();
+
         return handle;
     }
 
+    void GameObjectManager::Reserve(UINT32 numObjects)
+    {
+        if (numObjects > (UINT32)_freeSlots.size())
+            _slots.reserve(_slots.size() + numObjects - _freeSlots.size());
+    }
+
     void GameObjectManager::UnregisterObject(GameObjectHandleBase& object)
     {
-        _objects.erase(object->GetInstanceId());
+        const UINT64 id = object->GetInstanceId();
+        if (FindSlot(id) != nullptr)
+            ReleaseSlot(GetSlotIndex(id));
+
         OnDestroyed(static_object_cast<GameObject>(object));
         object.Destroy();
     }
+
+    const GameObjectManager::ObjectSlot* GameObjectManager::FindSlot(UINT64 id) const
+    {
+        const UINT32 slotIdx = GetSlotIndex(id);
+        if (slotIdx >= (UINT32)_slots.size())
+            return nullptr;
+
+        const ObjectSlot& slot = _slots[slotIdx];
+        if (slot.Object == nullptr || slot.Generation != GetGeneration(id))
+            return nullptr;
+
+        return &slot;
+    }
+
+    void GameObjectManager::ReleaseSlot(UINT32 slotIdx)
+    {
+        ObjectSlot& slot = _slots[slotIdx];
+        slot.Handle._data = nullptr; // Only drops the reference of the slot, handles given out keep their data
+        slot.Object = nullptr;
+
+        // Generation 0 is skipped when wrapping around, so IDs are never 0
+        if (++slot.Generation == 0)
+            slot.Generation = 1;
+
+        _freeSlots.push_back(slotIdx);
+    }
 }
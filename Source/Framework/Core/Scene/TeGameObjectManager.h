@@ -5,12 +5,20 @@
 #include "Scene/TeGameObject.h"
 #include "Utility/TeEvent.h"
 
-#include <atomic>
-
 namespace te
 {
     /**
      * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
+     *
+     * Objects are stored in an array of slots. The instance ID of an object is made of the index of its slot (lower 32
+     * bits) and of the generation of the slot (upper 32 bits), incremented each time the slot is released. Looking an
+     * object up by ID doesn't depend on the number of objects, and IDs of destroyed objects never resolve to the object
+     * reusing their slot.
+     *
+     * Handles don't go through the slots: copies of a handle share the instance data of their object, so they all see
+     * it being destroyed or remapped.
+     *
+     * @note	Not thread safe, objects must be registered, looked up and destroyed from the same thread.
      */
     class TE_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
     {
@@ -28,6 +36,9 @@ namespace te
          */
         GameObjectHandleBase RegisterObject(const SPtr<GameObject>& object);
 
+        /** Allocates storage for @p numObjects more objects, before registering many objects at once. */
+        void Reserve(UINT32 numObjects);
+
         /**
          * Unregisters a GameObject. Handles to this object will no longer be valid after this call. This should be called
          * whenever a GameObject is destroyed.
@@ -43,45 +54,59 @@ namespace te
         /**
          * Attempts to find a GameObject handle based on the GameObject instance ID. Returns true if object with the
          * specified ID is found, false otherwise.
-         *
-         * @note	Thread safe.
          */
         bool TryGetObjectHandle(UINT64 id, GameObjectHandleBase& object) const;
 
-        /**
-         * Checks if the GameObject with the specified instance ID exists.
-         *
-         * @note	Thread safe.
-         */
+        /** Checks if the GameObject with the specified instance ID exists. */
         bool ObjectExists(UINT64 id) const;
 
         /**
          * Changes the instance ID by which an object can be retrieved by.
          *
          * @note	Caller is required to update the object itself with the new ID.
-         * @note	Thread safe.
          */
         void RemapId(UINT64 oldId, UINT64 newId);
 
-        /**
-         * Allocates a new unique game object ID.
-         *
-         * @note	Thread safe.
-         */
-        UINT64 ReserveId();
-
         /**	Queues the object to be destroyed at the end of a GameObject update cycle. */
         void QueueForDestroy(const GameObjectHandleBase& object);
 
-        /**	Destroys any GameObjects that were queued for destruction. */
+        /**
+         * Destroys any GameObjects that were queued for destruction. Objects are destroyed as a batch, sorted by slot.
+         * Objects queued while the batch is destroyed are destroyed as well.
+         */
         void DestroyQueuedObjects();
 
         /**	Triggered when a game object is being destroyed. */
         Event<void(const HGameObject&)> OnDestroyed;
 
     private:
-        std::atomic<UINT64> _nextAvailableID = { 1 }; // 0 is not a valid ID
-        Map<UINT64, GameObjectHandleBase> _objects;
-        Map<UINT64, GameObjectHandleBase> _queuedForDestroy;
+        /** Registered object, or free slot if Object is null. */
+        struct ObjectSlot
+        {
+            GameObjectHandleBase Handle;
+            GameObject* Object = nullptr;
+            UINT32 Generation = 1; // 0 is never used, so 0 is not a valid ID
+        };
+
+        /** Builds an instance ID from a slot index and a generation. */
+        static UINT64 MakeId(UINT32 slotIdx, UINT32 generation) { return ((UINT64)generation << 32) | slotIdx; }
+
+        /** Returns the index of the slot referenced by an instance ID. */
+        static UINT32 GetSlotIndex(UINT64 id) { return (UINT32)(id & 0xFFFFFFFF); }
+
+        /** Returns the generation of the slot referenced by an instance ID. */
+        static UINT32 GetGeneration(UINT64 id) { return (UINT32)(id >> 32); }
+
+        /** Returns the slot of a registered object, or null if no object with the specified ID exists. */
+        const ObjectSlot* FindSlot(UINT64 id) const;
+
+        /** Clears a slot and makes it available for new objects. IDs referencing it become invalid. */
+        void ReleaseSlot(UINT32 slotIdx);
+
+    private:
+        Vector<ObjectSlot> _slots;
+        Vector<UINT32> _freeSlots;
+        Vector<GameObjectHandleBase> _queuedForDestroy;
+        Vector<GameObjectHandleBase> _destroyBatch;
     };
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TePoolAllocator.h"
+
+namespace te
+{
+    /**
+     * Allocator for the standard library taking single elements from a global pool of elements of the same type. Memory
+     * of destroyed game objects, and of their shared pointer data, is reused by the next objects created instead of going
+     * back to the heap, so spawning and destroying objects continuously doesn't allocate. Objects are 16 bytes aligned,
+     * as they can contain vectorized math types.
+     */
+    template<class T>
+    using GameObjectPoolAllocator = StdPoolAllocator<T, 512, 16>;
+
+    /** Destructs a game object and returns its memory to the pool of its type. */
+    template<class T>
+    struct GameObjectPoolDeleter
+    {
+        void operator()(T* ptr) const
+        {
+            ptr->~T();
+            GameObjectPoolAllocator<T>().deallocate(ptr, 1);
+        }
+    };
+
+    /** Allocates memory for a game object of type T from the pool of its type, without constructing it. */
+    template<class T>
+    T* te_game_object_allocate()
+    {
+        return GameObjectPoolAllocator<T>().allocate(1);
+    }
+
+    /**
+     * Creates a shared pointer owning a game object allocated with te_game_object_allocate(). The data of the shared
+     * pointer is allocated from a pool as well.
+     */
+    template<class T>
+    SPtr<T> te_game_object_shared_ptr(T* object)
+    {
+        return SPtr<T>(object, GameObjectPoolDeleter<T>(), GameObjectPoolAllocator<T>());
+    }
+}
@@ -2,6 +2,8 @@
 #include "Renderer/TeCamera.h"
 #include "TeCoreApplication.h"
 #include "Physics/TePhysics.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Scene/TeTransformHierarchy.h"
 
 namespace te
 {
@@ -31,8 +33,8 @@ namespace te
     { }
 
     SceneManager::SceneManager()
-        : _mainScene(te_shared_ptr_new<SceneInstance>(
-            "Main", SceneObject::CreateInternal("SceneRoot"), gPhysics().CreatePhysicsScene()))
+        : _mainScene(te_shared_ptr_new<SceneInstance>("Main", SceneObject::CreateInternal("SceneRoot"),
+            Physics::IsStarted() ? gPhysics().CreatePhysicsScene() : nullptr))
     {
         _mainScene->_root->SetScene(_mainScene);
     }
@@ -44,7 +46,8 @@ namespace te
 
         _mainCameras.clear();
         _cameras.clear();
-        _components.clear();
+        _componentGroups.clear();
+        _componentGroupIndices.clear();
         _mainRTResizedConn.Disconnect();
     }
 
@@ -79,13 +82,42 @@ namespace te
 
     void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
     {
+        auto iterFind = _boundActors.find(actor.get());
+        if (iterFind != _boundActors.end())
+            _unbindActor(actor);
+
         _boundActors[actor.get()] = BoundActorData(actor, so);
+        _boundActorsPerSO[so.Get()].push_back(actor.get());
+        so->_numBoundActors++;
+
         actor->_updateState(*so, true);
     }
 
     void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
     {
-        _boundActors.erase(actor.get());
+        auto iterFind = _boundActors.find(actor.get());
+        if (iterFind == _boundActors.end())
+            return;
+
+        SceneObject* so = iterFind->second.SoPtr;
+        _boundActors.erase(iterFind);
+
+        Vector<SceneActor*>& actors = _boundActorsPerSO[so];
+        actors.erase(std::remove(actors.begin(), actors.end(), actor.get()), actors.end());
+        so->_numBoundActors--;
+
+        // The scene object can be destroyed once its last actor is unbound, it can't stay in the dirty list
+        if (actors.empty())
+        {
+            _boundActorsPerSO.erase(so);
+
+            if (so->_boundActorsDirty)
+            {
+                so->_boundActorsDirty = false;
+                _dirtyBoundActorsSOs.erase(
+                    std::remove(_dirtyBoundActorsSOs.begin(), _dirtyBoundActorsSOs.end(), so), _dirtyBoundActorsSOs.end());
+            }
+        }
     }
 
     HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
@@ -146,8 +178,21 @@ namespace te
 
     void SceneManager::_updateCoreObjectTransforms()
     {
-        for (auto& entry : _boundActors)
-            entry.second.Actor->_updateState(*entry.second.So);
+        for (size_t i = 0; i < _dirtyBoundActorsSOs.size(); i++)
+        {
+            SceneObject* so = _dirtyBoundActorsSOs[i];
+            so->_boundActorsDirty = false;
+
+            for (auto& actor : _boundActorsPerSO[so])
+                actor->_updateState(*so);
+        }
+
+        _dirtyBoundActorsSOs.clear();
+    }
+
+    void SceneManager::_notifyBoundActorsDirty(SceneObject* so)
+    {
+        _dirtyBoundActorsSOs.push_back(so);
     }
 
     SPtr<Camera> SceneManager::GetMainCamera() const
@@ -206,7 +251,7 @@ namespace te
     void SceneManager::_notifyComponentCreated(const HComponent& component)
     {
         component->OnCreated();
-        _components.push_back(component);
+        AddToComponentGroup(component.Get());
     }
 
     void SceneManager::_notifyComponentActivated(const HComponent& component, bool triggerEvent)
@@ -228,27 +273,267 @@ namespace te
         //const bool alwaysRun = component->HasFlag(Component::AlwaysRun);
         //const bool isEnabled = component->SO()->GetActive() && (alwaysRun);
 
+        // TODO immediate not used here as every destruction is automatically immediate
         component->OnDestroyed();
+        RemoveFromComponentGroup(component.Get());
+    }
 
-        // TODO immediate not used here as every destruction is automatically immediate
-        auto co = std::find(_components.begin(), _components.end(), component);
-        if (co != _components.end())
+    bool SceneManager::IsComponentOfType(const HComponent& component, UINT32 id)
+    {
+        return component->GetCoreType() == id;
+    }
+
+    void SceneManager::_beginComponentBatch()
+    {
+        _componentBatchDepth++;
+    }
+
+    void SceneManager::_endComponentBatch()
+    {
+        TE_ASSERT_ERROR(_componentBatchDepth > 0, "Component batch ended without being started.");
+
+        // Components created during an update are added once it ends
+        if (--_componentBatchDepth > 0 || _isUpdatingComponents)
+            return;
+
+        Vector<Component*> pendingComponents;
+        std::swap(pendingComponents, _pendingComponents);
+
+        AddToComponentGroups(pendingComponents);
+    }
+
+    void SceneManager::AddToComponentGroup(Component* component)
+    {
+        if (_isUpdatingComponents || _componentBatchDepth > 0)
         {
-            _components.erase(co);
+            Lock lock(_pendingComponentsMutex);
+            _pendingComponents.push_back(component);
+            return;
         }
+
+        ComponentTypeGroup& group = GetOrCreateComponentGroup(component);
+        component->SetSceneManagerId((UINT32)group.Components.size());
+        group.Components.push_back(component);
     }
 
-    bool SceneManager::IsComponentOfType(const HComponent& component, UINT32 id)
+    void SceneManager::AddToComponentGroups(Vector<Component*>& components)
     {
-        return component->GetCoreType() == id;
+        // Components of a same type keep the order they were created in
+        std::stable_sort(components.begin(), components.end(),
+            [](const Component* a, const Component* b) { return a->GetCoreType() < b->GetCoreType(); });
+
+        for (UINT32 first = 0; first < (UINT32)components.size();)
+        {
+            const UINT32 type = components[first]->GetCoreType();
+
+            UINT32 last = first + 1;
+            while (last < (UINT32)components.size() && components[last]->GetCoreType() == type)
+                last++;
+
+            ComponentTypeGroup& group = GetOrCreateComponentGroup(components[first]);
+            group.Components.reserve(group.Components.size() + last - first);
+
+            for (UINT32 i = first; i < last; i++)
+            {
+                components[i]->SetSceneManagerId((UINT32)group.Components.size());
+                group.Components.push_back(components[i]);
+            }
+
+            first = last;
+        }
+    }
+
+    SceneManager::ComponentTypeGroup& SceneManager::GetOrCreateComponentGroup(Component* component)
+    {
+        const UINT32 type = component->GetCoreType();
+
+        auto iterFind = _componentGroupIndices.find(type);
+        if (iterFind == _componentGroupIndices.end())
+        {
+            iterFind = _componentGroupIndices.insert(std::make_pair(type, (UINT32)_componentGroups.size())).first;
+
+            UPtr<ComponentTypeGroup> group = te_unique_ptr_new<ComponentTypeGroup>();
+            group->Type = type;
+            group->UpdateFlags = component->GetUpdateFlags();
+            _componentGroups.push_back(std::move(group));
+        }
+
+        return *_componentGroups[iterFind->second];
+    }
+
+    const SceneManager::ComponentTypeGroup* SceneManager::FindComponentGroup(UINT32 type) const
+    {
+        auto iterFind = _componentGroupIndices.find(type);
+        if (iterFind == _componentGroupIndices.end())
+            return nullptr;
+
+        return _componentGroups[iterFind->second].get();
+    }
+
+    void SceneManager::FindComponents(UINT32 type, Vector<Component*>& output) const
+    {
+        // Groups can be changed by components updated in parallel
+        Lock lock(_pendingComponentsMutex);
+
+        if (const ComponentTypeGroup* group = FindComponentGroup(type))
+        {
+            output.reserve(output.size() + group->Components.size() - group->NumDeadComponents);
+            for (auto& component : group->Components)
+            {
+                if (component != nullptr)
+                    output.push_back(component);
+            }
+        }
+
+        for (auto& component : _pendingComponents)
+        {
+            if (component->GetCoreType() == type)
+                output.push_back(component);
+        }
+    }
+
+    UINT32 SceneManager::GetNumComponents(UINT32 type) const
+    {
+        Lock lock(_pendingComponentsMutex);
+
+        UINT32 numComponents = 0;
+        if (const ComponentTypeGroup* group = FindComponentGroup(type))
+            numComponents = (UINT32)group->Components.size() - group->NumDeadComponents;
+
+        for (auto& component : _pendingComponents)
+        {
+            if (component->GetCoreType() == type)
+                numComponents++;
+        }
+
+        return numComponents;
+    }
+
+    void SceneManager::RemoveFromComponentGroup(Component* component)
+    {
+        if (_isUpdatingComponents || _componentBatchDepth > 0)
+        {
+            Lock lock(_pendingComponentsMutex);
+
+            // Created during this update or batch, it was never added to its group
+            auto iterPending = std::find(_pendingComponents.begin(), _pendingComponents.end(), component);
+            if (iterPending != _pendingComponents.end())
+            {
+                _pendingComponents.erase(iterPending);
+                return;
+            }
+        }
+
+        auto iterFind = _componentGroupIndices.find(component->GetCoreType());
+        if (iterFind == _componentGroupIndices.end())
+            return;
+
+        ComponentTypeGroup& group = *_componentGroups[iterFind->second];
+        Vector<Component*>& components = group.Components;
+
+        const UINT32 idx = component->GetSceneManagerId();
+        if (idx >= (UINT32)components.size() || components[idx] != component)
+            return;
+
+        if (_isUpdatingComponents)
+        {
+            // Moving another component into this entry would make the update loop skip it
+            Lock lock(_pendingComponentsMutex);
+            components[idx] = nullptr;
+            group.NumDeadComponents++;
+            return;
+        }
+
+        components[idx] = components.back();
+        components[idx]->SetSceneManagerId(idx);
+        components.pop_back();
+    }
+
+    void SceneManager::ApplyPendingComponentChanges()
+    {
+        for (auto& group : _componentGroups)
+        {
+            if (group->NumDeadComponents == 0)
+                continue;
+
+            Vector<Component*>& components = group->Components;
+            components.erase(std::remove(components.begin(), components.end(), nullptr), components.end());
+
+            for (UINT32 i = 0; i < (UINT32)components.size(); i++)
+                components[i]->SetSceneManagerId(i);
+
+            group->NumDeadComponents = 0;
+        }
+
+        // Components of batches still open are added when they end
+        if (_componentBatchDepth > 0)
+            return;
+
+        Vector<Component*> pendingComponents;
+        std::swap(pendingComponents, _pendingComponents);
+
+        AddToComponentGroups(pendingComponents);
+    }
+
+    void SceneManager::UpdateComponentGroup(ComponentTypeGroup& group)
+    {
+        // Components destroyed during the update are null until the group is compacted
+        for (UINT32 i = 0; i < (UINT32)group.Components.size(); i++)
+        {
+            if (Component* component = group.Components[i])
+                component->Update();
+        }
     }
 
     void SceneManager::Update()
     {
-        for (auto& entry : _components)
-            entry->Update();
+        {
+            ScopeToggle updatingComponents(_isUpdatingComponents);
+
+            // Types which don't need to be updated are skipped, others are updated type after type
+            for (auto& group : _componentGroups)
+            {
+                if ((group->UpdateFlags & CUF_Update) != 0 && (group->UpdateFlags & CUF_Parallel) == 0)
+                    UpdateComponentGroup(*group);
+            }
+
+            // Types that allow it are then updated in parallel, one task per type. The last one is updated on this thread
+            ComponentTypeGroup* localGroup = nullptr;
+            for (auto& group : _componentGroups)
+            {
+                if ((group->UpdateFlags & CUF_Update) == 0 || (group->UpdateFlags & CUF_Parallel) == 0 || group->Components.empty())
+                    continue;
+
+                if (localGroup != nullptr)
+                {
+                    SPtr<Task> task = Task::Create("ComponentUpdate", [localGroup]() { UpdateComponentGroup(*localGroup); });
+                    gTaskScheduler().AddTask(task);
+                    _updateTasks.push_back(task);
+                }
+
+                localGroup = group.get();
+            }
+
+            if (localGroup != nullptr)
+                UpdateComponentGroup(*localGroup);
+
+            for (auto& task : _updateTasks)
+                task->Wait();
+
+            _updateTasks.clear();
+        }
+
+        ApplyPendingComponentChanges();
 
         GameObjectManager::Instance().DestroyQueuedObjects();
+
+        // Descendants of objects moved by components are only notified by the hierarchy, so it must be updated before
+        // bound actors are synced for them to follow their parents in the same frame
+        if (TransformHierarchy::IsStarted())
+            gTransformHierarchy().Update();
+
+        // Components may have moved their scene objects, actors bound to the ones that changed are synced once
+        _updateCoreObjectTransforms();
     }
 
     void SceneManager::OnMainRenderTargetResized()
@@ -7,6 +7,7 @@
 namespace te
 {
     class PhysicsScene;
+    class Task;
 
     /** Possible states components can be in. Controls which component callbacks are triggered. */
     enum class ComponentState
@@ -21,10 +22,14 @@ namespace te
         BoundActorData(const SPtr<SceneActor>& actor, const HSceneObject& so)
             : Actor(actor)
             , So(so)
+            , SoPtr(so.Get())
         { }
 
         SPtr<SceneActor> Actor;
         HSceneObject So;
+
+        /** Scene object the actor is bound to. Still valid when the handle is already destroyed. */
+        SceneObject* SoPtr = nullptr;
     };
 
     /** Contains information about an instantiated scene. */
@@ -41,7 +46,7 @@ namespace te
 
         /**
          * Physical representation of the scene, as assigned by the physics sub-system. Exact implementation depends on the
-         * physics plugin used.
+         * physics plugin used. Null if the physics sub-system isn't started.
          */
         const SPtr<PhysicsScene>& GetPhysicsScene() const { return _physicsScene; }
 
@@ -89,10 +94,27 @@ namespace te
          *
          * @tparam		T			Type of the component to search for.
          * @return					A list of all matching components in the scene.
+         *
+         * @note	Components are indexed by type, so this only iterates over the matching components. Components
+         *			created during the current update are included, components destroyed during it are not.
          */
         template<class T>
         Vector<GameObjectHandle<T>> FindComponents();
 
+        /** Outputs all components with the specified type id currently in the scene. */
+        void FindComponents(UINT32 type, Vector<Component*>& output) const;
+
+        /**
+         * Returns the number of components of the specified type currently in the scene.
+         *
+         * @tparam		T			Type of the component to count.
+         */
+        template<class T>
+        UINT32 GetNumComponents() const { return GetNumComponents(T::GetComponentType()); }
+
+        /** Returns the number of components with the specified type id currently in the scene. */
+        UINT32 GetNumComponents(UINT32 type) const;
+
         /** Returns all cameras in the scene. */
         const UnorderedMap<Camera*, SPtr<Camera>>& GetAllCameras() const { return _cameras; }
 
@@ -135,12 +157,24 @@ namespace te
         /**	Notifies the scene manager that a camera either became the main camera, or has stopped being main camera. */
         void _notifyMainCameraStateChanged(const SPtr<Camera>& camera);
 
-        /** Called every frame. Calls update methods on all scene objects and their components. */
+        /**
+         * Called every frame. Calls update methods on all scene objects and their components, then syncs the actors bound
+         * to scene objects that changed. Components created while components are updated are first updated next frame.
+         */
         void Update();
 
-        /** Updates dirty transforms on any core objects that may be tied with scene objects. */
+        /**
+         * Updates dirty transforms on any core objects that may be tied with scene objects. Only actors bound to scene
+         * objects which changed (transform, mobility or active state) since the last call are updated. Called by Update().
+         */
         void _updateCoreObjectTransforms();
 
+        /**
+         * Notifies the manager that the actors bound to the provided scene object must be updated during next call to
+         * _updateCoreObjectTransforms(). Called by the scene object the first time it changes after an update.
+         */
+        void _notifyBoundActorsDirty(SceneObject* so);
+
         /** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
         void _notifyComponentCreated(const HComponent& component);
 
@@ -159,6 +193,16 @@ namespace te
         /** Notifies the manager that a component is about to be destroyed. The manager triggers necessary callbacks. */
         void _notifyComponentDestroyed(const HComponent& component, bool immediate);
 
+        /**
+         * Defers adding created components to their group until the matching _endComponentBatch() call, so components
+         * created together (e.g. by SceneObject::Instantiate()) are added in a single pass, type after type. Batches can
+         * be nested. Deferred components are still returned by FindComponents() and counted by GetNumComponents().
+         */
+        void _beginComponentBatch();
+
+        /** Ends a batch started by _beginComponentBatch(), adding the components created during the batch to their group. */
+        void _endComponentBatch();
+
     protected:
         friend class SceneObject;
 
@@ -181,14 +225,65 @@ namespace te
         /** Checks does the specified component type match the provided id. */
         static bool IsComponentOfType(const HComponent& component, UINT32 id);
 
+    protected:
+        /** Components of a same type, stored contiguously so they are found and updated together. */
+        struct ComponentTypeGroup
+        {
+            UINT32 Type = 0;
+            UINT32 UpdateFlags = CUF_Update;
+            Vector<Component*> Components;
+
+            /** Number of components destroyed during Update(), their entries being null until the group is compacted. */
+            UINT32 NumDeadComponents = 0;
+        };
+
+        /**
+         * Adds a component to the group of its type, creating the group if needed. Components created during Update()
+         * or during a batch (see _beginComponentBatch()) are only added once all groups have been updated, or once the
+         * batch ends.
+         */
+        void AddToComponentGroup(Component* component);
+
+        /** Adds components to the groups of their type, looking each group up once. Reorders @p components by type. */
+        void AddToComponentGroups(Vector<Component*>& components);
+
+        /** Returns the group of components of the type of @p component, creating it if needed. */
+        ComponentTypeGroup& GetOrCreateComponentGroup(Component* component);
+
+        /** Returns the group of components of the specified type, or null if no component of this type was created. */
+        const ComponentTypeGroup* FindComponentGroup(UINT32 type) const;
+
+        /**
+         * Removes a component from the group of its type. Components destroyed during Update() are marked as dead, and
+         * removed once all groups have been updated.
+         */
+        void RemoveFromComponentGroup(Component* component);
+
+        /** Removes dead components from the groups and adds the components created during Update(). */
+        void ApplyPendingComponentChanges();
+
+        /** Calls Update() on all the components of a group. */
+        static void UpdateComponentGroup(ComponentTypeGroup& group);
+
     protected:
         SPtr<SceneInstance> _mainScene;
 
         UnorderedMap<SceneActor*, BoundActorData> _boundActors;
+        UnorderedMap<SceneObject*, Vector<SceneActor*>> _boundActorsPerSO;
+        Vector<SceneObject*> _dirtyBoundActorsSOs;
         UnorderedMap<Camera*, SPtr<Camera>> _cameras;
         Vector<SPtr<Camera>> _mainCameras;
 
-        Vector<HComponent> _components;
+        // Groups are referenced by update tasks, so they must not move when a group is created
+        Vector<UPtr<ComponentTypeGroup>> _componentGroups;
+        UnorderedMap<UINT32, UINT32> _componentGroupIndices;
+        Vector<SPtr<Task>> _updateTasks;
+
+        // Groups are iterated by several threads during Update(), so changes to them are deferred until it ends
+        bool _isUpdatingComponents = false;
+        UINT32 _componentBatchDepth = 0;
+        Vector<Component*> _pendingComponents;
+        mutable Mutex _pendingComponentsMutex;
 
         SPtr<RenderTarget> _mainRenderTarget;
         HEvent _mainRTResizedConn;
@@ -199,14 +294,14 @@ namespace te
     template<class T>
     Vector<GameObjectHandle<T>> SceneManager::FindComponents()
     {
-        UINT32 typeId = T::GetComponentType();
+        Vector<Component*> components;
+        FindComponents(T::GetComponentType(), components);
 
         Vector<GameObjectHandle<T>> output;
-        for (auto& entry : _components)
-        {
-            if (IsComponentOfType(entry, typeId))
-                output.push_back(static_object_cast<T>(entry));
-        }
+        output.reserve(components.size());
+
+        for (auto& component : components)
+            output.push_back(static_object_cast<T>(component->GetHandle()));
 
         return output;
     }
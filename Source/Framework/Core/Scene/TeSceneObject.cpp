@@ -119,6 +119,103 @@ namespace te
             sceneObject->SetName(childSO->GetName());
         }
 
+        CloneComponents(so);
+    }
+
+    Vector<HSceneObject> SceneObject::Instantiate(const HSceneObject& so, UINT32 count, const HSceneObject& parent)
+    {
+        Vector<HSceneObject> instances;
+        if (so.IsDestroyed() || count == 0)
+            return instances;
+
+        HSceneObject root = parent;
+        if (root == nullptr && gSceneManager().GetMainScene() != nullptr)
+            root = gSceneManager().GetMainScene()->GetRoot();
+
+        // Pre-size storage for all the objects and components created
+        UINT32 numNodes = 0;
+        UINT32 numComponents = 0;
+        so->CountHierarchy(numNodes, numComponents);
+
+        GameObjectManager::Instance().Reserve(count * (numNodes + numComponents));
+        instances.reserve(count);
+
+        if (root != nullptr)
+            root->_children.reserve(root->_children.size() + count);
+
+        Vector<std::pair<SceneObject*, SceneObject*>> clones;
+        clones.reserve(count * numNodes);
+
+        for (UINT32 i = 0; i < count; i++)
+        {
+            HSceneObject instance = so->CloneHierarchy(root, clones);
+            instance->_name = so->GetName() + " copy";
+
+            instances.push_back(instance);
+        }
+
+        // Single pass propagating transforms, so components are created with their final world transform
+        for (auto& instance : instances)
+            instance->NotifyTransformChanged((TransformChangedFlags)(TCF_Parent | TCF_Transform));
+
+        // Components of all the instances are added to the scene manager groups at once, type after type
+        gSceneManager()._beginComponentBatch();
+
+        for (auto& clone : clones)
+            clone.first->CloneComponents(clone.second->GetHandle().GetInternalPtr());
+
+        gSceneManager()._endComponentBatch();
+
+        return instances;
+    }
+
+    void SceneObject::CountHierarchy(UINT32& numNodes, UINT32& numComponents) const
+    {
+        numNodes++;
+        numComponents += (UINT32)_components.size();
+
+        for (auto& child : _children)
+            child->CountHierarchy(numNodes, numComponents);
+    }
+
+    HSceneObject SceneObject::CloneHierarchy(const HSceneObject& parent,
+        Vector<std::pair<SceneObject*, SceneObject*>>& clones) const
+    {
+        HSceneObject clone = CreateInternal(_name);
+
+        // Copied and linked directly, without the notifications of SetParent() and SetLocalTransform()
+        clone->_localTfrm = _localTfrm;
+        clone->_mobility = _mobility;
+        clone->_activeSelf = _activeSelf;
+        clone->_children.reserve(_children.size());
+        clone->_components.reserve(_components.size());
+        clone->_linkWithoutNotify(parent);
+
+        clones.push_back(std::make_pair(clone.Get(), const_cast<SceneObject*>(this)));
+
+        for (auto& child : _children)
+            child->CloneHierarchy(clone, clones);
+
+        return clone;
+    }
+
+    void SceneObject::_linkWithoutNotify(const HSceneObject& parent)
+    {
+        _activeHierarchy = _activeSelf && (parent == nullptr || parent->_activeHierarchy);
+
+        if (_tfrmNodeId != TransformHierarchy::INVALID_NODE && _mobility != ObjectMobility::Movable)
+            gTransformHierarchy().SetMovable(_tfrmNodeId, false);
+
+        if (parent != nullptr)
+        {
+            _parent = parent;
+            _parentScene = parent->_parentScene;
+            parent->_children.push_back(_thisHandle);
+        }
+    }
+
+    void SceneObject::CloneComponents(const SPtr<SceneObject>& so)
+    {
         for (auto& co : so->GetComponents())
         {
             // Create a copy a each component
@@ -183,7 +280,7 @@ namespace te
 
             case TID_CSkybox:
             {
-                if (SceneManager::Instance().FindComponents<CSkybox>().size() > 0)
+                if (SceneManager::Instance().GetNumComponents<CSkybox>() > 0)
                     break;
 
                 HSkybox component = this->AddComponent<CSkybox>();
@@ -367,8 +464,8 @@ namespace te
 
     HSceneObject SceneObject::CreateInternal(const String& name, UINT32 flags)
     {
-        SPtr<SceneObject> sceneObjectPtr = SPtr<SceneObject>(new (te_allocate<SceneObject>()) SceneObject(name, flags),
-            &te_delete<SceneObject>);
+        SPtr<SceneObject> sceneObjectPtr = te_game_object_shared_ptr(
+            new (te_game_object_allocate<SceneObject>()) SceneObject(name, flags));
 
         sceneObjectPtr->_UUID = UUIDGenerator::GenerateRandom();
         sceneObjectPtr->_gameObjectColor = Color::GenerateRandom(0.1f, 1.0f);
@@ -377,6 +474,12 @@ namespace te
             GameObjectManager::Instance().RegisterObject(sceneObjectPtr));
         sceneObject->_thisHandle = sceneObject;
 
+        if (TransformHierarchy::IsStarted())
+        {
+            sceneObject->_tfrmNodeId = gTransformHierarchy().AddNode(sceneObjectPtr.get(), sceneObject->_localTfrm,
+                sceneObject->_mobility == ObjectMobility::Movable);
+        }
+
         return sceneObject;
     }
 
@@ -386,6 +489,12 @@ namespace te
             GameObjectManager::Instance().RegisterObject(soPtr));
         sceneObject->_thisHandle = sceneObject;
 
+        if (TransformHierarchy::IsStarted() && sceneObject->_tfrmNodeId == TransformHierarchy::INVALID_NODE)
+        {
+            sceneObject->_tfrmNodeId = gTransformHierarchy().AddNode(soPtr.get(), sceneObject->_localTfrm,
+                sceneObject->_mobility == ObjectMobility::Movable);
+        }
+
         return sceneObject;
     }
 
@@ -411,6 +520,12 @@ namespace te
                 _components.erase(_components.end() - 1);
             }
 
+            if (_tfrmNodeId != TransformHierarchy::INVALID_NODE && TransformHierarchy::IsStarted())
+            {
+                gTransformHierarchy().RemoveNode(_tfrmNodeId);
+                _tfrmNodeId = TransformHierarchy::INVALID_NODE;
+            }
+
             GameObjectManager::Instance().UnregisterObject(handle);
         }
         else
@@ -421,6 +536,13 @@ namespace te
 
     const Transform& SceneObject::GetTransform() const
     {
+        // Storage of the hierarchy moves when nodes are added, so the returned reference must point to this object
+        if (_tfrmNodeId != TransformHierarchy::INVALID_NODE)
+        {
+            _worldTfrm = gTransformHierarchy().GetWorld(_tfrmNodeId);
+            return _worldTfrm;
+        }
+
         if (!IsCachedWorldTfrmUpToDate())
             UpdateWorldTfrm();
 
@@ -515,6 +637,12 @@ namespace te
 
     const Matrix4& SceneObject::GetWorldMatrix() const
     {
+        if (_tfrmNodeId != TransformHierarchy::INVALID_NODE)
+        {
+            _cachedWorldTfrm = gTransformHierarchy().GetWorldMatrix(_tfrmNodeId);
+            return _cachedWorldTfrm;
+        }
+
         if (!IsCachedWorldTfrmUpToDate())
             UpdateWorldTfrm();
 
@@ -523,10 +651,7 @@ namespace te
 
     Matrix4 SceneObject::GetInvWorldMatrix() const
     {
-        if (!IsCachedWorldTfrmUpToDate())
-            UpdateWorldTfrm();
-
-        Matrix4 worldToLocal = _worldTfrm.GetInvMatrix();
+        Matrix4 worldToLocal = GetTransform().GetInvMatrix();
         return worldToLocal;
     }
 
@@ -633,7 +758,9 @@ namespace te
         if (!IsCachedLocalTfrmUpToDate())
             UpdateLocalTfrm();
 
-        if (!IsCachedWorldTfrmUpToDate())
+        if (_tfrmNodeId != TransformHierarchy::INVALID_NODE)
+            gTransformHierarchy().GetWorld(_tfrmNodeId);
+        else if (!IsCachedWorldTfrmUpToDate())
             UpdateWorldTfrm();
     }
 
@@ -691,6 +818,23 @@ namespace te
             _dirtyHash++;
         }
 
+        if (_tfrmNodeId != TransformHierarchy::INVALID_NODE)
+        {
+            if (flags & TCF_Parent)
+            {
+                const UINT32 parentNodeId = (_parent != nullptr) ? _parent->_tfrmNodeId : TransformHierarchy::INVALID_NODE;
+                gTransformHierarchy().SetParent(_tfrmNodeId, parentNodeId);
+            }
+
+            if (flags & TCF_Mobility)
+                gTransformHierarchy().SetMovable(_tfrmNodeId, _mobility == ObjectMobility::Movable);
+
+            if (flags & TCF_Transform)
+                gTransformHierarchy().SetLocal(_tfrmNodeId, _localTfrm);
+        }
+
+        NotifyBoundActorsDirty();
+
         // Only send component flags if we haven't removed them all
         if (componentFlags != 0)
         {
@@ -705,6 +849,11 @@ namespace te
 
         // Mobility flag is only relevant for this scene object
         flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
+
+        // Descendants moved by this object are notified once the hierarchy is updated, unless the hierarchy changed
+        if (_tfrmNodeId != TransformHierarchy::INVALID_NODE && (flags & TCF_Parent) == 0)
+            flags = (TransformChangedFlags)(flags & ~TCF_Transform);
+
         if (flags != 0)
         {
             for (auto& entry : _children)
@@ -712,6 +861,28 @@ namespace te
         }
     }
 
+    void SceneObject::NotifyTransformChangedByParent() const
+    {
+        _dirtyHash++;
+
+        NotifyBoundActorsDirty();
+
+        for (auto& entry : _components)
+        {
+            if (entry->SupportsNotify(TCF_Transform))
+                entry->OnTransformChanged(TCF_Transform);
+        }
+    }
+
+    void SceneObject::NotifyBoundActorsDirty() const
+    {
+        if (_numBoundActors == 0 || _boundActorsDirty)
+            return;
+
+        _boundActorsDirty = true;
+        gSceneManager()._notifyBoundActorsDirty(const_cast<SceneObject*>(this));
+    }
+
     void SceneObject::UpdateWorldTfrm() const
     {
         _worldTfrm = _localTfrm;
@@ -802,6 +973,7 @@ namespace te
         if (_activeHierarchy != activeHierarchy)
         {
             _activeHierarchy = activeHierarchy;
+            NotifyBoundActorsDirty();
 
             if (triggerEvents)
             {
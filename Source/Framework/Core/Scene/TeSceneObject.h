@@ -4,9 +4,11 @@
 #include "Math/TeMatrix4.h"
 #include "Math/TeVector3.h"
 #include "Scene/TeGameObjectManager.h"
+#include "Scene/TeGameObjectPool.h"
 #include "Scene/TeGameObject.h"
 #include "Scene/TeComponent.h"
 #include "Scene/TeTransform.h"
+#include "Scene/TeTransformHierarchy.h"
 #include "Serialization/TeSerializable.h"
 
 #include <any>
@@ -38,6 +40,8 @@ namespace te
         };
 
         friend class SceneManager;
+        friend class TransformHierarchy;
+        friend class SceneSerializer;
 
     public:
         ~SceneObject();
@@ -76,6 +80,20 @@ namespace te
          */
         void Clone(const SPtr<SceneObject>& so);
 
+        /**
+         * Creates @p count copies of a scene object and of all its descendants and components. Faster than calling
+         * Clone() for each copy when many copies are needed: storage is allocated once for all the copies, and
+         * transform changes are propagated in a single pass once all the objects are linked, before components are
+         * created, and the components of all the copies are added to the scene manager in a single pass.
+         *
+         * @param[in]	so		Scene object to copy.
+         * @param[in]	count	Number of copies to create.
+         * @param[in]	parent	Parent of the copies. If null, copies are added to the root of the main scene.
+         * @return				Root of each copy.
+         */
+        static Vector<HSceneObject> Instantiate(const HSceneObject& so, UINT32 count,
+            const HSceneObject& parent = HSceneObject());
+
     private: // ***** INTERNAL ******
         /** @copydoc GameObject::_setInstanceData */
         void _setInstanceData(GameObjectInstanceDataPtr& other) override;
@@ -86,6 +104,24 @@ namespace te
         /** Recursively disables the provided set of flags on this object and all children. */
         void _unsetFlags(UINT32 flags);
 
+        /** Adds a copy of each component of @p so to this object. */
+        void CloneComponents(const SPtr<SceneObject>& so);
+
+        /** Counts this object, its descendants and all their components. */
+        void CountHierarchy(UINT32& numNodes, UINT32& numComponents) const;
+
+        /**
+         * Creates a copy of this object and its descendants without components, and links it to @p parent without
+         * notifying anyone. Each copy is added to @p clones along with its source object.
+         */
+        HSceneObject CloneHierarchy(const HSceneObject& parent, Vector<std::pair<SceneObject*, SceneObject*>>& clones) const;
+
+        /**
+         * Adds a newly created object to the children of @p parent without sending any notification, for objects created
+         * in bulk. Transform changes must then be notified once the whole hierarchy is linked.
+         */
+        void _linkWithoutNotify(const HSceneObject& parent);
+
     private:
         SceneObject(const String& name, UINT32 flags);
 
@@ -121,7 +157,13 @@ namespace te
         void DestroyInternal(GameObjectHandleBase& handle, bool immediate = false) override;
 
     public:
-        /** Gets the transform object representing object's position/rotation/scale in world space. */
+        /**
+         * Gets the transform object representing object's position/rotation/scale in world space. The reference stays
+         * valid until the next call on this object.
+         *
+         * @note	Not thread safe, as the world transform is computed and cached on demand. Can't be called from
+         *			components updated in parallel (see CUF_Parallel).
+         */
         const Transform& GetTransform() const;
 
         /** Gets the transform object representing object's position/rotation/scale relative to its parent. */
@@ -160,6 +202,7 @@ namespace te
         /**
          * Gets the objects world transform matrix.
          * @note	Performance warning: This might involve updating the transforms if the transform is dirty.
+         * @note	Not thread safe, for the same reasons as GetTransform().
          */
         const Matrix4& GetWorldMatrix() const;
 
@@ -255,6 +298,15 @@ namespace te
          */
         void NotifyTransformChanged(TransformChangedFlags flags) const;
 
+        /**
+         * Notifies components that the world transform changed because of an ancestor. Only used when transforms are
+         * stored in the TransformHierarchy, which notifies descendants of moved objects once they are updated.
+         */
+        void NotifyTransformChangedByParent() const;
+
+        /** Registers this object in the list of objects whose bound actors must be updated, if it has any. */
+        void NotifyBoundActorsDirty() const;
+
         /** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
         void UpdateLocalTfrm() const;
 
@@ -375,8 +427,8 @@ namespace te
             static_assert((std::is_base_of<te::Component, T>::value),
                 "Specified type is not a valid Component.");
 
-            SPtr<T> gameObject(new (te_allocate<T>()) T(_thisHandle,
-                std::forward<Args>(args)...), &te_delete<T>);
+            SPtr<T> gameObject = te_game_object_shared_ptr(new (te_game_object_allocate<T>()) T(_thisHandle,
+                std::forward<Args>(args)...));
 
             const HComponent newComponent =
                 static_object_cast<Component>(GameObjectManager::Instance().RegisterObject(gameObject));
@@ -432,8 +484,8 @@ namespace te
         {
             static_assert((std::is_base_of<te::Component, T>::value), "Specified type is not a valid Component.");
 
-            T* rawPtr = new (te_allocate<T>()) T();
-            SPtr<T> gameObject(rawPtr, &te_delete<T>);
+            T* rawPtr = new (te_game_object_allocate<T>()) T();
+            SPtr<T> gameObject = te_game_object_shared_ptr(rawPtr);
 
             return gameObject;
         }
@@ -629,6 +681,9 @@ namespace te
         mutable UINT32 _dirtyFlags = 0xFFFFFFFF;
         mutable UINT32 _dirtyHash = 0;
 
+        // Node storing the transforms of this object when the TransformHierarchy is used
+        UINT32 _tfrmNodeId = TransformHierarchy::INVALID_NODE;
+
         HSceneObject _thisHandle;
         UINT32 _flags;
 
@@ -639,6 +694,10 @@ namespace te
         bool _activeSelf = true;
         bool _activeHierarchy = true;
 
+        // Scene actors bound to this object (see SceneManager::_bindActor()) and whether they must be updated
+        UINT32 _numBoundActors = 0;
+        mutable bool _boundActorsDirty = false;
+
         Vector<HComponent> _components;
     };
 }
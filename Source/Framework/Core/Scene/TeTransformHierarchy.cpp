@@ -0,0 +1,359 @@
+#include "Scene/TeTransformHierarchy.h"
+#include "Scene/TeSceneObject.h"
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    TE_MODULE_STATIC_MEMBER(TransformHierarchy)
+
+    /** Removes an element by moving the last one in its place. */
+    template<class T>
+    static void RemoveSwap(Vector<T>& data, UINT32 idx)
+    {
+        data[idx] = std::move(data.back());
+        data.pop_back();
+    }
+
+    /** Reorders elements so that the element at index i is the one previously at index order[i]. */
+    template<class T>
+    static void Reorder(Vector<T>& data, const Vector<UINT32>& order)
+    {
+        Vector<T> sorted;
+        sorted.reserve(data.size());
+
+        for (auto idx : order)
+            sorted.push_back(std::move(data[idx]));
+
+        data.swap(sorted);
+    }
+
+    UINT32 TransformHierarchy::AddNode(SceneObject* owner, const Transform& local, bool movable)
+    {
+        UINT32 id;
+        if (!_freeIds.empty())
+        {
+            id = _freeIds.back();
+            _freeIds.pop_back();
+        }
+        else
+        {
+            id = (UINT32)_indices.size();
+            _indices.push_back(INVALID_NODE);
+        }
+
+        _indices[id] = (UINT32)_ids.size();
+
+        _ids.push_back(id);
+        _parentIds.push_back(INVALID_NODE);
+        _parents.push_back(INVALID_NODE);
+        _owners.push_back(owner);
+        _localTfrms.push_back(local);
+        _worldTfrms.push_back(local);
+        _worldMatrices.push_back(local.GetMatrix());
+        _movable.push_back(movable ? 1 : 0);
+        _dirty.push_back(LocalDirty);
+
+        _numDirty++;
+        _structureDirty = true;
+
+        return id;
+    }
+
+    void TransformHierarchy::RemoveNode(UINT32 id)
+    {
+        const UINT32 idx = _indices[id];
+        if (idx == INVALID_NODE)
+            return;
+
+        RemoveSwap(_ids, idx);
+        RemoveSwap(_parentIds, idx);
+        RemoveSwap(_parents, idx);
+        RemoveSwap(_owners, idx);
+        RemoveSwap(_localTfrms, idx);
+        RemoveSwap(_worldTfrms, idx);
+        RemoveSwap(_worldMatrices, idx);
+        RemoveSwap(_movable, idx);
+        RemoveSwap(_dirty, idx);
+
+        if (idx < (UINT32)_ids.size())
+            _indices[_ids[idx]] = idx;
+
+        // Id is only reused once children referencing it have been detached, see Rebuild()
+        _indices[id] = INVALID_NODE;
+        _removedIds.push_back(id);
+        _structureDirty = true;
+    }
+
+    void TransformHierarchy::SetParent(UINT32 id, UINT32 parentId)
+    {
+        const UINT32 idx = _indices[id];
+
+        _parentIds[idx] = parentId;
+        _dirty[idx] |= LocalDirty;
+
+        _numDirty++;
+        _structureDirty = true;
+    }
+
+    void TransformHierarchy::SetLocal(UINT32 id, const Transform& local)
+    {
+        const UINT32 idx = _indices[id];
+
+        _localTfrms[idx] = local;
+        _dirty[idx] |= LocalDirty;
+
+        _numDirty++;
+    }
+
+    void TransformHierarchy::SetMovable(UINT32 id, bool movable)
+    {
+        const UINT32 idx = _indices[id];
+
+        _movable[idx] = movable ? 1 : 0;
+        _dirty[idx] |= LocalDirty;
+
+        _numDirty++;
+    }
+
+    const Transform& TransformHierarchy::GetWorld(UINT32 id)
+    {
+        const UINT32 idx = _indices[id];
+        UpdateWorldLazy(idx);
+
+        return _worldTfrms[idx];
+    }
+
+    const Matrix4& TransformHierarchy::GetWorldMatrix(UINT32 id)
+    {
+        const UINT32 idx = _indices[id];
+        UpdateWorldLazy(idx);
+
+        return _worldMatrices[idx];
+    }
+
+    void TransformHierarchy::Update()
+    {
+        if (_structureDirty)
+            Rebuild();
+
+        if (_numDirty == 0)
+            return;
+
+        for (UINT32 level = 0; level + 1 < (UINT32)_levels.size(); level++)
+            UpdateLevel(_levels[level], _levels[level + 1]);
+
+        _movedOwners.clear();
+
+        const auto numNodes = (UINT32)_ids.size();
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            if (_dirty[i] & ParentDirty)
+                _movedOwners.push_back(_owners[i]);
+
+            _dirty[i] = 0;
+        }
+
+        _numDirty = 0;
+
+        // Owners may move other objects when notified, which will be processed lazily or during the next update
+        for (auto& owner : _movedOwners)
+            owner->NotifyTransformChangedByParent();
+    }
+
+    void TransformHierarchy::Rebuild()
+    {
+        const auto numNodes = (UINT32)_ids.size();
+
+        // Children of removed nodes become roots, then ids of removed nodes can be safely reused
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            if (_parentIds[i] != INVALID_NODE && _indices[_parentIds[i]] == INVALID_NODE)
+                _parentIds[i] = INVALID_NODE;
+        }
+
+        _freeIds.insert(_freeIds.end(), _removedIds.begin(), _removedIds.end());
+        _removedIds.clear();
+
+        // Depth of each node, going up the hierarchy until a node with a known depth is found
+        _depths.assign(numNodes, INVALID_NODE);
+        UINT32 maxDepth = 0;
+
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            _chain.clear();
+
+            UINT32 idx = i;
+            while (idx != INVALID_NODE && _depths[idx] == INVALID_NODE)
+            {
+                _chain.push_back(idx);
+                idx = GetParentIndex(idx);
+            }
+
+            UINT32 depth = (idx == INVALID_NODE) ? 0 : _depths[idx] + 1;
+            for (auto iter = _chain.rbegin(); iter != _chain.rend(); ++iter)
+                _depths[*iter] = depth++;
+
+            maxDepth = std::max(maxDepth, _depths[i]);
+        }
+
+        // Counting sort by depth, keeping the current order of nodes of a same level
+        _levels.assign(numNodes > 0 ? maxDepth + 2 : 1, 0);
+        for (UINT32 i = 0; i < numNodes; i++)
+            _levels[_depths[i] + 1]++;
+
+        for (UINT32 level = 1; level < (UINT32)_levels.size(); level++)
+            _levels[level] += _levels[level - 1];
+
+        _order.resize(numNodes);
+        _chain.assign(_levels.begin(), _levels.end());
+
+        for (UINT32 i = 0; i < numNodes; i++)
+            _order[_chain[_depths[i]]++] = i;
+
+        Reorder(_ids, _order);
+        Reorder(_parentIds, _order);
+        Reorder(_owners, _order);
+        Reorder(_localTfrms, _order);
+        Reorder(_worldTfrms, _order);
+        Reorder(_worldMatrices, _order);
+        Reorder(_movable, _order);
+        Reorder(_dirty, _order);
+
+        for (UINT32 i = 0; i < numNodes; i++)
+            _indices[_ids[i]] = i;
+
+        _parents.resize(numNodes);
+        for (UINT32 i = 0; i < numNodes; i++)
+            _parents[i] = GetParentIndex(i);
+
+        _structureDirty = false;
+    }
+
+    void TransformHierarchy::UpdateRange(UINT32 begin, UINT32 end)
+    {
+        for (UINT32 i = begin; i < end; i++)
+        {
+            const UINT32 parent = _movable[i] ? _parents[i] : INVALID_NODE;
+
+            if (parent != INVALID_NODE && _dirty[parent] != 0)
+                _dirty[i] |= ParentDirty;
+
+            if (_dirty[i] != 0)
+                ComputeWorld(i, parent != INVALID_NODE ? &_worldTfrms[parent] : nullptr);
+        }
+    }
+
+    void TransformHierarchy::UpdateLevel(UINT32 begin, UINT32 end)
+    {
+        const UINT32 numNodes = end - begin;
+        const UINT32 numThreads = TE_THREAD_HARDWARE_CONCURRENCY;
+
+        if (numNodes < MIN_NODES_PER_TASK * 2 || numThreads <= 1 || !TaskScheduler::IsStarted())
+        {
+            UpdateRange(begin, end);
+            return;
+        }
+
+        // More chunks than threads, so a thread busy with another task doesn't delay the whole level
+        SPtr<LevelJob> job = te_shared_ptr_new<LevelJob>();
+        job->Begin = begin;
+        job->End = end;
+        job->NumChunks = std::min(numNodes / MIN_NODES_PER_TASK, numThreads * 4);
+        job->ChunkSize = (numNodes + job->NumChunks - 1) / job->NumChunks;
+
+        // Tasks starting once all chunks have been processed return without touching the hierarchy
+        const UINT32 numTasks = std::min(job->NumChunks, numThreads) - 1;
+        for (UINT32 i = 0; i < numTasks; i++)
+            gTaskScheduler().AddTask(Task::Create("TransformHierarchy", [this, job]() { RunLevelJob(*job); }));
+
+        RunLevelJob(*job);
+
+        while (job->NumDoneChunks.load() < job->NumChunks)
+            std::this_thread::yield();
+    }
+
+    void TransformHierarchy::RunLevelJob(LevelJob& job)
+    {
+        while (true)
+        {
+            const UINT32 chunk = job.NextChunk++;
+            if (chunk >= job.NumChunks)
+                break;
+
+            const UINT32 begin = job.Begin + chunk * job.ChunkSize;
+            const UINT32 end = std::min(begin + job.ChunkSize, job.End);
+
+            if (begin < end)
+                UpdateRange(begin, end);
+
+            job.NumDoneChunks++;
+        }
+    }
+
+    void TransformHierarchy::ComputeWorld(UINT32 idx, const Transform* parentWorld)
+    {
+        Transform& world = _worldTfrms[idx];
+        world = _localTfrms[idx];
+
+        if (parentWorld)
+            world.MakeWorld(*parentWorld);
+
+        _worldMatrices[idx] = world.GetMatrix();
+    }
+
+    bool TransformHierarchy::IsWorldDirty(UINT32 idx) const
+    {
+        while (idx != INVALID_NODE)
+        {
+            if (_dirty[idx] != 0)
+                return true;
+
+            if (!_movable[idx])
+                return false;
+
+            idx = GetParentIndex(idx);
+        }
+
+        return false;
+    }
+
+    void TransformHierarchy::UpdateWorldLazy(UINT32 idx)
+    {
+        if (_numDirty == 0 || !IsWorldDirty(idx))
+            return;
+
+        // Ancestors the world transform depends on, from the node to the root (or the first immovable ancestor)
+        _chain.clear();
+        while (idx != INVALID_NODE)
+        {
+            _chain.push_back(idx);
+
+            if (!_movable[idx])
+                break;
+
+            idx = GetParentIndex(idx);
+        }
+
+        auto first = (INT32)_chain.size() - 1;
+        while (first >= 0 && _dirty[_chain[first]] == 0)
+            first--;
+
+        // Nodes stay dirty, Update() will compute them again and notify their owners
+        for (INT32 i = first; i >= 0; i--)
+        {
+            const bool hasParent = i + 1 < (INT32)_chain.size();
+            ComputeWorld(_chain[i], hasParent ? &_worldTfrms[_chain[i + 1]] : nullptr);
+        }
+    }
+
+    UINT32 TransformHierarchy::GetParentIndex(UINT32 idx) const
+    {
+        const UINT32 parentId = _parentIds[idx];
+        return (parentId != INVALID_NODE) ? _indices[parentId] : INVALID_NODE;
+    }
+
+    TransformHierarchy& gTransformHierarchy()
+    {
+        return TransformHierarchy::Instance();
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Scene/TeTransform.h"
+#include "Math/TeMatrix4.h"
+#include "Utility/TeModule.h"
+
+#include <atomic>
+
+namespace te
+{
+    /**
+     * Optional storage of the transforms of all scene objects, used instead of the transforms stored in each SceneObject
+     * when the module is started (see START_UP_DESC::UseTransformHierarchy).
+     *
+     * Local and world transforms are kept in contiguous arrays (one array per attribute), sorted by depth in the
+     * hierarchy. World transforms are updated once per frame by Update(), level by level: parents are always processed
+     * before their children, so moving an object with many descendants results in a linear sweep over the arrays, split
+     * between worker threads for large levels.
+     *
+     * SceneObject keeps exposing the same API on top of it. World transforms requested before Update() are computed
+     * lazily from the first dirty ancestor. Components of descendants of a moved object are notified when Update() runs,
+     * instead of immediately.
+     *
+     * @note	Nodes are identified by an id that doesn't change when arrays are sorted. References returned by GetWorld()
+     *			and GetWorldMatrix() are only valid until nodes are added or the hierarchy is updated.
+     */
+    class TE_CORE_EXPORT TransformHierarchy : public Module<TransformHierarchy>
+    {
+    public:
+        /** Id of a node that doesn't exist. */
+        static const UINT32 INVALID_NODE = (UINT32)-1;
+
+        /** Minimum number of nodes of a level processed by a single task. Smaller levels are processed on this thread. */
+        static const UINT32 MIN_NODES_PER_TASK = 1024;
+
+        TransformHierarchy() = default;
+        ~TransformHierarchy() = default;
+
+        TE_MODULE_STATIC_HEADER_MEMBER(TransformHierarchy)
+
+        /**
+         * Adds a node without parent to the hierarchy and returns its id.
+         *
+         * @param[in]	owner		Scene object notified when its world transform changes because of an ancestor.
+         * @param[in]	local		Local transform of the node.
+         * @param[in]	movable		If false, the node doesn't follow its parent and its world transform is its local one.
+         */
+        UINT32 AddNode(SceneObject* owner, const Transform& local, bool movable);
+
+        /** Removes a node from the hierarchy. Its children become roots until they are given a new parent. */
+        void RemoveNode(UINT32 id);
+
+        /** Sets the parent of a node. Use INVALID_NODE for no parent. */
+        void SetParent(UINT32 id, UINT32 parentId);
+
+        /** Sets the local transform of a node, and marks its world transform and the ones of its descendants dirty. */
+        void SetLocal(UINT32 id, const Transform& local);
+
+        /** @copydoc AddNode */
+        void SetMovable(UINT32 id, bool movable);
+
+        /** Returns the world transform of a node, computing it first if the node or one of its ancestors is dirty. */
+        const Transform& GetWorld(UINT32 id);
+
+        /** Returns the world matrix of a node, computing it first if the node or one of its ancestors is dirty. */
+        const Matrix4& GetWorldMatrix(UINT32 id);
+
+        /**
+         * Sorts the nodes by depth if the hierarchy changed, updates all dirty world transforms and notifies owners of
+         * nodes moved because of one of their ancestors. Called by SceneManager::Update() before actors bound to scene
+         * objects are synced, and once more before the scene is rendered for objects moved later in the frame.
+         *
+         * @note	Not thread safe. GetWorld() and GetWorldMatrix() aren't either, as they compute dirty nodes on demand.
+         */
+        void Update();
+
+        /** Returns the number of nodes in the hierarchy. */
+        UINT32 GetNumNodes() const { return (UINT32)_ids.size(); }
+
+    private:
+        /** Work shared by the threads updating a single level of the hierarchy. */
+        struct LevelJob
+        {
+            UINT32 Begin = 0;
+            UINT32 ChunkSize = 0;
+            UINT32 NumChunks = 0;
+            UINT32 End = 0;
+            std::atomic<UINT32> NextChunk{ 0 };
+            std::atomic<UINT32> NumDoneChunks{ 0 };
+        };
+
+        /** Sorts all arrays by depth, and computes the index of the parent and the range of each level. */
+        void Rebuild();
+
+        /** Updates world transforms of dirty nodes in [begin, end). Parents must have been processed already. */
+        void UpdateRange(UINT32 begin, UINT32 end);
+
+        /** Updates all the nodes in [begin, end), splitting the range between worker threads. */
+        void UpdateLevel(UINT32 begin, UINT32 end);
+
+        /** Processes chunks of a level until none is left. */
+        void RunLevelJob(LevelJob& job);
+
+        /** Computes the world transform and matrix of the node at the provided index. */
+        void ComputeWorld(UINT32 idx, const Transform* parentWorld);
+
+        /** Returns true if the node or one of its ancestors is dirty. */
+        bool IsWorldDirty(UINT32 idx) const;
+
+        /** Computes the world transform of the node at the provided index, and of its dirty ancestors. */
+        void UpdateWorldLazy(UINT32 idx);
+
+        /** Returns the index of the parent of the node at the provided index, or INVALID_NODE. */
+        UINT32 GetParentIndex(UINT32 idx) const;
+
+    private:
+        /** Bits of _dirty. */
+        enum DirtyFlags
+        {
+            LocalDirty = 0x01, /**< Local transform of the node changed, its owner has already been notified. */
+            ParentDirty = 0x02 /**< World transform of an ancestor changed. */
+        };
+
+        // Per node data, sorted by depth after Rebuild()
+        Vector<UINT32> _ids;
+        Vector<UINT32> _parentIds;
+        Vector<UINT32> _parents;
+        Vector<SceneObject*> _owners;
+        Vector<Transform> _localTfrms;
+        Vector<Transform> _worldTfrms;
+        Vector<Matrix4> _worldMatrices;
+        Vector<UINT8> _movable;
+        Vector<UINT8> _dirty;
+
+        // Index of the first node of each level, followed by the number of nodes
+        Vector<UINT32> _levels;
+
+        // Index in the per node arrays of each id
+        Vector<UINT32> _indices;
+        Vector<UINT32> _freeIds;
+        Vector<UINT32> _removedIds;
+
+        Vector<UINT32> _depths;
+        Vector<UINT32> _order;
+        Vector<UINT32> _chain;
+        Vector<SceneObject*> _movedOwners;
+
+        UINT32 _numDirty = 0;
+        bool _structureDirty = false;
+    };
+
+    /** Provides easy access to the TransformHierarchy. */
+    TE_CORE_EXPORT TransformHierarchy& gTransformHierarchy();
+}
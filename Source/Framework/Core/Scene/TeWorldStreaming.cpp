@@ -0,0 +1,241 @@
+#include "Scene/TeWorldStreaming.h"
+#include "Scene/TeSceneManager.h"
+#include "Renderer/TeCamera.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Utility/TeTime.h"
+
+namespace te
+{
+    TE_MODULE_STATIC_MEMBER(WorldStreaming)
+
+    /** Returns the distance between a point and a box, 0 if the point is inside the box. */
+    static float GetDistance(const AABox& box, const Vector3& point)
+    {
+        const Vector3 closest = Vector3::Max(box.GetMin(), Vector3::Min(point, box.GetMax()));
+        return closest.Distance(point);
+    }
+
+    UINT32 WorldStreaming::AddCell(const STREAMING_CELL_DESC& desc)
+    {
+        SPtr<StreamingCell> cell = te_shared_ptr_new<StreamingCell>();
+        cell->Desc = desc;
+
+        const UINT32 id = _nextCellId++;
+        _cells[id] = cell;
+
+        return id;
+    }
+
+    void WorldStreaming::RemoveCell(UINT32 id)
+    {
+        auto iterFind = _cells.find(id);
+        if (iterFind == _cells.end())
+            return;
+
+        if (!UnloadCell(*iterFind->second))
+            _removedCells.push_back(iterFind->second);
+
+        _cells.erase(iterFind);
+    }
+
+    StreamingCellState WorldStreaming::GetCellState(UINT32 id) const
+    {
+        auto iterFind = _cells.find(id);
+        if (iterFind == _cells.end())
+            return StreamingCellState::Unloaded;
+
+        return iterFind->second->State;
+    }
+
+    HSceneObject WorldStreaming::GetCellRoot(UINT32 id) const
+    {
+        auto iterFind = _cells.find(id);
+        if (iterFind == _cells.end())
+            return HSceneObject();
+
+        return iterFind->second->Root;
+    }
+
+    void WorldStreaming::Update()
+    {
+        _removedCells.erase(std::remove_if(_removedCells.begin(), _removedCells.end(),
+            [this](const SPtr<StreamingCell>& cell) { return UnloadCell(*cell); }), _removedCells.end());
+
+        if (_cells.empty())
+            return;
+
+        _cameraPositions.clear();
+        for (auto& entry : gSceneManager().GetAllCameras())
+        {
+            if (entry.second->IsMain())
+                _cameraPositions.push_back(entry.second->GetTransform().GetPosition());
+        }
+
+        if (_cameraPositions.empty())
+            return;
+
+        _operations.clear();
+        for (auto& entry : _cells)
+        {
+            StreamingCell& cell = *entry.second;
+
+            if (cell.State == StreamingCellState::Loading)
+            {
+                if (!cell.LoadTask->IsComplete())
+                    continue;
+
+                cell.LoadTask = nullptr;
+                cell.State = StreamingCellState::Loaded;
+            }
+
+            float distance = std::numeric_limits<float>::max();
+            for (auto& position : _cameraPositions)
+                distance = std::min(distance, GetDistance(cell.Desc.Bounds, position));
+
+            const StreamingCellState target = GetTargetState(cell, distance);
+            if (target == cell.State)
+                continue;
+
+            // Loading doesn't run on the main thread, so it is started right away
+            if (cell.State == StreamingCellState::Unloaded && target != StreamingCellState::Unloaded)
+            {
+                if (cell.Desc.LoadResources)
+                {
+                    SPtr<StreamingCell> cellPtr = entry.second;
+                    cell.LoadTask = Task::Create("WorldStreaming", [cellPtr]() { cellPtr->Desc.LoadResources(); });
+                    cell.State = StreamingCellState::Loading;
+
+                    gTaskScheduler().AddTask(cell.LoadTask);
+                }
+                else
+                {
+                    cell.State = StreamingCellState::Loaded;
+                }
+
+                continue;
+            }
+
+            _operations.push_back({ &cell, target, distance });
+        }
+
+        std::sort(_operations.begin(), _operations.end(),
+            [](const CellOperation& a, const CellOperation& b) { return a.Distance < b.Distance; });
+
+        // At least one operation is processed each frame, so cells keep streaming even with a very small budget
+        const UINT64 startTime = gTime().GetTimePrecise();
+        const UINT64 budget = (UINT64)(_timeBudget * 1000.0f);
+
+        for (auto& operation : _operations)
+        {
+            ProcessOperation(*operation.Cell, operation.Target);
+
+            if (gTime().GetTimePrecise() - startTime >= budget)
+                break;
+        }
+    }
+
+    void WorldStreaming::OnShutDown()
+    {
+        for (auto& entry : _cells)
+            _removedCells.push_back(entry.second);
+
+        // Nothing can be deferred anymore, so loading tasks are waited for
+        for (auto& cell : _removedCells)
+        {
+            if (cell->LoadTask != nullptr)
+                cell->LoadTask->Wait();
+
+            UnloadCell(*cell);
+        }
+
+        _removedCells.clear();
+        _cells.clear();
+    }
+
+    StreamingCellState WorldStreaming::GetTargetState(const StreamingCell& cell, float distance) const
+    {
+        const bool created = cell.State == StreamingCellState::Inactive || cell.State == StreamingCellState::Active;
+
+        if (distance <= _activationDistance)
+            return StreamingCellState::Active;
+
+        if (distance <= _loadDistance)
+            return cell.State == StreamingCellState::Active ? StreamingCellState::Active : StreamingCellState::Inactive;
+
+        if (distance <= _unloadDistance)
+        {
+            if (created)
+                return StreamingCellState::Inactive;
+
+            // Cells being loaded finish loading, but their objects are only created once a camera comes closer
+            return cell.State == StreamingCellState::Unloaded ? StreamingCellState::Unloaded : StreamingCellState::Loaded;
+        }
+
+        return StreamingCellState::Unloaded;
+    }
+
+    void WorldStreaming::ProcessOperation(StreamingCell& cell, StreamingCellState target)
+    {
+        if (target == StreamingCellState::Unloaded)
+        {
+            UnloadCell(cell);
+            return;
+        }
+
+        if (cell.State == StreamingCellState::Loaded)
+        {
+            if (target == StreamingCellState::Loaded)
+                return;
+
+            // Deactivated first, so created objects don't get initialized as active if the cell must stay inactive
+            cell.Root = SceneObject::Create(cell.Desc.Name);
+            cell.Root->SetActive(false);
+
+            if (cell.Desc.CreateObjects)
+                cell.Desc.CreateObjects(cell.Root);
+
+            cell.State = StreamingCellState::Inactive;
+        }
+
+        if (cell.State != target)
+        {
+            cell.Root->SetActive(target == StreamingCellState::Active);
+            cell.State = target;
+        }
+    }
+
+    bool WorldStreaming::UnloadCell(StreamingCell& cell)
+    {
+        if (cell.State == StreamingCellState::Unloaded)
+            return true;
+
+        if (cell.LoadTask != nullptr)
+        {
+            // Resources can't be released while they are loaded, so the main thread doesn't wait for the task
+            if (!cell.LoadTask->IsComplete())
+                return false;
+
+            cell.LoadTask = nullptr;
+        }
+
+        // Destroyed immediately, since objects queued for destruction would still use the resources released below
+        if (cell.Root != nullptr)
+        {
+            if (!cell.Root.IsDestroyed())
+                cell.Root->Destroy(true);
+
+            cell.Root = nullptr;
+        }
+
+        if (cell.Desc.UnloadResources)
+            cell.Desc.UnloadResources();
+
+        cell.State = StreamingCellState::Unloaded;
+        return true;
+    }
+
+    WorldStreaming& gWorldStreaming()
+    {
+        return WorldStreaming::Instance();
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Scene/TeSceneObject.h"
+#include "Math/TeAABox.h"
+#include "Utility/TeModule.h"
+
+namespace te
+{
+    class Task;
+
+    /** Description of a cell of the world, see WorldStreaming::AddCell(). */
+    struct STREAMING_CELL_DESC
+    {
+        /** Name of the scene object created as the root of the objects of the cell. */
+        String Name = "StreamingCell";
+
+        /** Area covered by the cell. Distance to the cameras is measured to this box. */
+        AABox Bounds;
+
+        /** Loads the resources used by the cell. Called on a worker thread, must not create scene objects. */
+        std::function<void()> LoadResources;
+
+        /** Creates the scene objects of the cell as children of the provided root. Called on the main thread. */
+        std::function<void(const HSceneObject&)> CreateObjects;
+
+        /** Releases the resources loaded by LoadResources, once the objects of the cell have been destroyed. */
+        std::function<void()> UnloadResources;
+    };
+
+    /** States a streaming cell can be in. */
+    enum class StreamingCellState
+    {
+        Unloaded, /**< Nothing is loaded. */
+        Loading, /**< Resources are being loaded on a worker thread. */
+        Loaded, /**< Resources are loaded, scene objects are not created yet. */
+        Inactive, /**< Scene objects are created but deactivated, so they are not rendered nor simulated. */
+        Active /**< Scene objects are created and active. */
+    };
+
+    /**
+     * Splits the world in cells that are loaded, activated, deactivated and unloaded depending on their distance to the
+     * main cameras, so memory and per-frame cost stay bounded for large levels:
+     *  - Resources of cells closer than the load distance are loaded asynchronously, then their objects are created
+     *    deactivated.
+     *  - Cells closer than the activation distance are activated. They are deactivated again once they are farther than
+     *    the load distance.
+     *  - Cells farther than the unload distance are destroyed and their resources released.
+     *
+     * Operations that must run on the main thread (creating, activating, deactivating and destroying objects) are
+     * processed from the closest cell to the farthest one, until the time budget of the frame is exhausted.
+     */
+    class TE_CORE_EXPORT WorldStreaming : public Module<WorldStreaming>
+    {
+    public:
+        WorldStreaming() = default;
+        ~WorldStreaming() = default;
+
+        TE_MODULE_STATIC_HEADER_MEMBER(WorldStreaming)
+
+        /** Registers a new cell and returns its id. The cell stays unloaded until a camera comes close enough. */
+        UINT32 AddCell(const STREAMING_CELL_DESC& desc);
+
+        /**
+         * Destroys the objects of a cell, releases its resources and unregisters it. If its resources are being loaded,
+         * the cell is unloaded during the first update after loading ends.
+         */
+        void RemoveCell(UINT32 id);
+
+        /** Returns the current state of a cell. */
+        StreamingCellState GetCellState(UINT32 id) const;
+
+        /** Returns the root of the objects of a cell, or null if they are not created. */
+        HSceneObject GetCellRoot(UINT32 id) const;
+
+        /** Sets the distance under which cells are active. */
+        void SetActivationDistance(float distance) { _activationDistance = distance; }
+
+        /** Returns the distance under which cells are active. */
+        float GetActivationDistance() const { return _activationDistance; }
+
+        /** Sets the distance under which cells are loaded. Active cells farther than this distance are deactivated. */
+        void SetLoadDistance(float distance) { _loadDistance = distance; }
+
+        /** Returns the distance under which cells are loaded. */
+        float GetLoadDistance() const { return _loadDistance; }
+
+        /** Sets the distance over which cells are unloaded. */
+        void SetUnloadDistance(float distance) { _unloadDistance = distance; }
+
+        /** Returns the distance over which cells are unloaded. */
+        float GetUnloadDistance() const { return _unloadDistance; }
+
+        /** Sets the time (in milliseconds) main thread operations can take during a single frame. */
+        void SetTimeBudget(float budget) { _timeBudget = budget; }
+
+        /** Returns the time (in milliseconds) main thread operations can take during a single frame. */
+        float GetTimeBudget() const { return _timeBudget; }
+
+        /** Starts loading cells close to the main cameras and processes pending operations. Called once per frame. */
+        void Update();
+
+    protected:
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+    private:
+        /** Cell of the world, shared with the task loading it. */
+        struct StreamingCell
+        {
+            STREAMING_CELL_DESC Desc;
+            StreamingCellState State = StreamingCellState::Unloaded;
+            SPtr<Task> LoadTask;
+            HSceneObject Root;
+        };
+
+        /** Main thread operation to apply to a cell. */
+        struct CellOperation
+        {
+            StreamingCell* Cell;
+            StreamingCellState Target;
+            float Distance;
+        };
+
+        /** Returns the state a cell should be in, given its distance to the closest camera. */
+        StreamingCellState GetTargetState(const StreamingCell& cell, float distance) const;
+
+        /** Moves a cell one step towards the target state. */
+        void ProcessOperation(StreamingCell& cell, StreamingCellState target);
+
+        /**
+         * Destroys the objects of a cell and releases its resources. Returns false, leaving the cell untouched, if its
+         * resources are still being loaded.
+         */
+        bool UnloadCell(StreamingCell& cell);
+
+    private:
+        UnorderedMap<UINT32, SPtr<StreamingCell>> _cells;
+        Vector<SPtr<StreamingCell>> _removedCells; // Removed while loading, unloaded once loading ends
+        UINT32 _nextCellId = 0;
+
+        float _activationDistance = 100.0f;
+        float _loadDistance = 150.0f;
+        float _unloadDistance = 200.0f;
+        float _timeBudget = 2.0f;
+
+        Vector<Vector3> _cameraPositions;
+        Vector<CellOperation> _operations;
+    };
+
+    /** Provides easy access to the WorldStreaming. */
+    TE_CORE_EXPORT WorldStreaming& gWorldStreaming();
+}
@@ -0,0 +1,92 @@
+#include "Serialization/TeBinaryStream.h"
+
+namespace te
+{
+    BinaryWriter::BinaryWriter(UINT32 capacity)
+    {
+        _data.reserve(capacity);
+    }
+
+    void BinaryWriter::Write(const String& value)
+    {
+        Write((UINT32)value.size());
+        Write(value.data(), (UINT32)value.size());
+    }
+
+    void BinaryWriter::Write(const void* data, UINT32 size)
+    {
+        if (size == 0)
+            return;
+
+        const UINT32 offset = Tell();
+        _data.resize(offset + size);
+        memcpy(&_data[offset], data, size);
+    }
+
+    void BinaryWriter::Align(UINT32 alignment)
+    {
+        const UINT32 remainder = Tell() % alignment;
+        if (remainder != 0)
+            _data.resize(Tell() + alignment - remainder, 0);
+    }
+
+    BinaryReader::BinaryReader(const UINT8* data, UINT32 size, UINT32 version)
+        : _data(data)
+        , _size(size)
+        , _version(version)
+    { }
+
+    bool BinaryReader::Read(String& value)
+    {
+        UINT32 length = 0;
+        if (!Read(length))
+            return false;
+
+        const UINT8* data = ReadBytes(length);
+        if (data == nullptr)
+            return false;
+
+        value.assign(reinterpret_cast<const char*>(data), length);
+        return true;
+    }
+
+    bool BinaryReader::Read(void* data, UINT32 size)
+    {
+        const UINT8* src = ReadBytes(size);
+        if (src == nullptr)
+            return false;
+
+        memcpy(data, src, size);
+        return true;
+    }
+
+    BinaryReader BinaryReader::ReadBlock(UINT32 size)
+    {
+        const UINT8* data = ReadBytes(size);
+        if (data == nullptr)
+            return BinaryReader(nullptr, 0, _version);
+
+        return BinaryReader(data, size, _version);
+    }
+
+    void BinaryReader::Align(UINT32 alignment)
+    {
+        const UINT32 remainder = _cursor % alignment;
+        if (remainder != 0)
+            ReadBytes(alignment - remainder);
+    }
+
+    const UINT8* BinaryReader::ReadBytes(UINT32 size)
+    {
+        if (_failed || size > _size - _cursor)
+        {
+            _failed = true;
+            return nullptr;
+        }
+
+        const UINT8* data = _data + _cursor;
+        _cursor += size;
+
+        return data;
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    /** Writes plain data to a growing memory buffer. Used to save data in binary formats, see SceneSerializer. */
+    class TE_CORE_EXPORT BinaryWriter
+    {
+    public:
+        BinaryWriter() = default;
+
+        /** @param[in]	capacity	Number of bytes to allocate before writing anything. */
+        BinaryWriter(UINT32 capacity);
+
+        /** Writes a value of a trivially copyable type. */
+        template<class T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written.");
+            Write(&value, sizeof(T));
+        }
+
+        /** Writes the length of a string followed by its characters. */
+        void Write(const String& value);
+
+        /** Writes @p size bytes. */
+        void Write(const void* data, UINT32 size);
+
+        /**
+         * Writes an array of trivially copyable elements, aligned so it can be read in place with
+         * BinaryReader::ReadArray().
+         */
+        template<class T>
+        void WriteArray(const T* data, UINT32 count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written.");
+
+            Align(alignof(T));
+            Write(data, count * sizeof(T));
+        }
+
+        /** Overwrites a value previously written at @p offset, for example a size only known once data is written. */
+        template<class T>
+        void WriteAt(UINT32 offset, const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written.");
+            memcpy(&_data[offset], &value, sizeof(T));
+        }
+
+        /** Writes zeroes until the size of the data is a multiple of @p alignment. */
+        void Align(UINT32 alignment);
+
+        /** Returns the number of bytes written so far. */
+        UINT32 Tell() const { return (UINT32)_data.size(); }
+
+        /** Returns all the data written so far. */
+        const Vector<UINT8>& GetData() const { return _data; }
+
+    private:
+        Vector<UINT8> _data;
+    };
+
+    /**
+     * Reads data written by a BinaryWriter from a memory buffer it doesn't own. Arrays are returned in place, without
+     * being copied, so the buffer must stay alive while they are used and be aligned to 16 bytes.
+     *
+     * Reading past the end of the buffer doesn't throw: the reader is marked as failed and returns empty values.
+     */
+    class TE_CORE_EXPORT BinaryReader
+    {
+    public:
+        /**
+         * @param[in]	data		Data to read.
+         * @param[in]	size		Size of the data in bytes.
+         * @param[in]	version		Version of the format the data was written with, available to the code reading it.
+         */
+        BinaryReader(const UINT8* data, UINT32 size, UINT32 version = 0);
+
+        /** Reads a value of a trivially copyable type. Returns false if there is not enough data left. */
+        template<class T>
+        bool Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read.");
+            return Read(&value, sizeof(T));
+        }
+
+        /** Reads a string written by BinaryWriter::Write(const String&). */
+        bool Read(String& value);
+
+        /** Copies the next @p size bytes to @p data. */
+        bool Read(void* data, UINT32 size);
+
+        /** Returns the next @p count elements of an array written by BinaryWriter::WriteArray(), without copying them. */
+        template<class T>
+        const T* ReadArray(UINT32 count)
+        {
+            Align(alignof(T));
+
+            // Checked before multiplying, the size of the array could overflow
+            if ((UINT64)count > (UINT64)GetRemaining() / sizeof(T))
+            {
+                _failed = true;
+                return nullptr;
+            }
+
+            const UINT8* data = ReadBytes(count * (UINT32)sizeof(T));
+            if (data == nullptr || ((UINT64)data % alignof(T)) != 0)
+            {
+                _failed = true;
+                return nullptr;
+            }
+
+            return reinterpret_cast<const T*>(data);
+        }
+
+        /** Returns a reader over the next @p size bytes, and skips them. */
+        BinaryReader ReadBlock(UINT32 size);
+
+        /** Skips the next @p size bytes. */
+        void Skip(UINT32 size) { ReadBytes(size); }
+
+        /** Skips bytes until the read position is a multiple of @p alignment. */
+        void Align(UINT32 alignment);
+
+        /** Returns the read position, in bytes. */
+        UINT32 Tell() const { return _cursor; }
+
+        /** Returns the number of bytes left to read. */
+        UINT32 GetRemaining() const { return _size - _cursor; }
+
+        /** Returns the version of the format the data was written with. */
+        UINT32 GetVersion() const { return _version; }
+
+        /** Sets the version of the format the data was written with, usually read from a header. */
+        void SetVersion(UINT32 version) { _version = version; }
+
+        /** Returns true if a read failed because there was not enough data. */
+        bool HasFailed() const { return _failed; }
+
+    private:
+        /** Returns a pointer to the next @p size bytes and skips them, or null if there is not enough data left. */
+        const UINT8* ReadBytes(UINT32 size);
+
+    private:
+        const UINT8* _data;
+        UINT32 _size;
+        UINT32 _cursor = 0;
+        UINT32 _version;
+        bool _failed = false;
+    };
+}
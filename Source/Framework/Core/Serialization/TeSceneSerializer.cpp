@@ -0,0 +1,304 @@
+#include "Serialization/TeSceneSerializer.h"
+#include "Scene/TeSceneManager.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Utility/TeDataStream.h"
+
+#include "Components/TeCCamera.h"
+#include "Components/TeCCameraFlyer.h"
+#include "Components/TeCCameraUI.h"
+#include "Components/TeCLight.h"
+#include "Components/TeCRenderable.h"
+#include "Components/TeCSkybox.h"
+#include "Components/TeCScript.h"
+#include "Components/TeCAnimation.h"
+#include "Components/TeCBone.h"
+#include "Components/TeCAudioSource.h"
+#include "Components/TeCAudioListener.h"
+#include "Components/TeCRigidBody.h"
+#include "Components/TeCSoftBody.h"
+#include "Components/TeCConeTwistJoint.h"
+#include "Components/TeCD6Joint.h"
+#include "Components/TeCHingeJoint.h"
+#include "Components/TeCSliderJoint.h"
+#include "Components/TeCSphericalJoint.h"
+#include "Components/TeCBoxCollider.h"
+#include "Components/TeCPlaneCollider.h"
+#include "Components/TeCSphereCollider.h"
+#include "Components/TeCCylinderCollider.h"
+#include "Components/TeCCapsuleCollider.h"
+#include "Components/TeCMeshCollider.h"
+#include "Components/TeCConeCollider.h"
+
+namespace te
+{
+    /** Index of the parent of objects saved without parent. */
+    static const UINT32 NO_PARENT = (UINT32)-1;
+
+    /** First bytes of the data written by SceneSerializer::Save(). */
+    struct SceneFileHeader
+    {
+        UINT32 Magic;
+        UINT32 Version;
+        UINT32 NumObjects;
+        UINT32 NumComponents;
+    };
+
+    /** Fixed size data of a scene object. Names are stored separately. */
+    struct SerializedSceneObject
+    {
+        UUID Id;
+        Vector3 Position;
+        Quaternion Rotation;
+        Vector3 Scale;
+        UINT32 Parent;
+        UINT32 Mobility;
+        UINT32 Active;
+    };
+
+    typedef std::function<HComponent(const HSceneObject&)> ComponentFactory;
+
+    /** Returns the functions creating components of each type, initialized with the built-in component types. */
+    static UnorderedMap<UINT32, ComponentFactory>& GetComponentFactories()
+    {
+        static UnorderedMap<UINT32, ComponentFactory> factories;
+        static bool initialized = false;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+            SceneSerializer::RegisterComponentType<CCamera>();
+            SceneSerializer::RegisterComponentType<CCameraFlyer>();
+            SceneSerializer::RegisterComponentType<CCameraUI>();
+            SceneSerializer::RegisterComponentType<CLight>();
+            SceneSerializer::RegisterComponentType<CRenderable>();
+            SceneSerializer::RegisterComponentType<CSkybox>();
+            SceneSerializer::RegisterComponentType<CScript>();
+            SceneSerializer::RegisterComponentType<CAnimation>();
+            SceneSerializer::RegisterComponentType<CBone>();
+            SceneSerializer::RegisterComponentType<CAudioSource>();
+            SceneSerializer::RegisterComponentType<CAudioListener>();
+            SceneSerializer::RegisterComponentType<CRigidBody>();
+            SceneSerializer::RegisterComponentType<CSoftBody>();
+            SceneSerializer::RegisterComponentType<CConeTwistJoint>();
+            SceneSerializer::RegisterComponentType<CD6Joint>();
+            SceneSerializer::RegisterComponentType<CHingeJoint>();
+            SceneSerializer::RegisterComponentType<CSliderJoint>();
+            SceneSerializer::RegisterComponentType<CSphericalJoint>();
+            SceneSerializer::RegisterComponentType<CBoxCollider>();
+            SceneSerializer::RegisterComponentType<CPlaneCollider>();
+            SceneSerializer::RegisterComponentType<CSphereCollider>();
+            SceneSerializer::RegisterComponentType<CCylinderCollider>();
+            SceneSerializer::RegisterComponentType<CCapsuleCollider>();
+            SceneSerializer::RegisterComponentType<CMeshCollider>();
+            SceneSerializer::RegisterComponentType<CConeCollider>();
+        }
+
+        return factories;
+    }
+
+    /** Adds an object and its descendants to @p objects in depth-first order, along with the index of their parent. */
+    static void GatherObjects(SceneObject* so, UINT32 parent, Vector<SceneObject*>& objects, Vector<UINT32>& parents)
+    {
+        const auto index = (UINT32)objects.size();
+        objects.push_back(so);
+        parents.push_back(parent);
+
+        for (UINT32 i = 0; i < so->GetNumChildren(); i++)
+            GatherObjects(so->GetChild(i).Get(), index, objects, parents);
+    }
+
+    void SceneSerializer::Save(const HSceneObject& so, BinaryWriter& writer)
+    {
+        UnorderedMap<UINT32, ComponentFactory>& factories = GetComponentFactories();
+
+        Vector<SceneObject*> objects;
+        Vector<UINT32> parents;
+        GatherObjects(so.Get(), NO_PARENT, objects, parents);
+
+        const auto numObjects = (UINT32)objects.size();
+        UINT32 numComponents = 0;
+
+        Vector<SerializedSceneObject> records(numObjects);
+        for (UINT32 i = 0; i < numObjects; i++)
+        {
+            const SceneObject* object = objects[i];
+            SerializedSceneObject& record = records[i];
+
+            record.Id = object->GetUUID();
+            record.Position = object->_localTfrm.GetPosition();
+            record.Rotation = object->_localTfrm.GetRotation();
+            record.Scale = object->_localTfrm.GetScale();
+            record.Parent = parents[i];
+            record.Mobility = (UINT32)object->_mobility;
+            record.Active = object->_activeSelf ? 1 : 0;
+
+            for (auto& component : object->_components)
+            {
+                if (factories.find(component->GetCoreType()) != factories.end())
+                    numComponents++;
+            }
+        }
+
+        writer.Write(SceneFileHeader{ MAGIC, VERSION, numObjects, numComponents });
+        writer.WriteArray(records.data(), numObjects);
+
+        for (auto& object : objects)
+            writer.Write(object->GetName());
+
+        for (UINT32 i = 0; i < numObjects; i++)
+        {
+            for (auto& component : objects[i]->_components)
+            {
+                const UINT32 type = component->GetCoreType();
+                if (factories.find(type) == factories.end())
+                    continue;
+
+                writer.Write(type);
+                writer.Write(i);
+
+                // Size of the component data, so types unknown when loading can be skipped
+                const UINT32 sizeOffset = writer.Tell();
+                writer.Write((UINT32)0);
+
+                const UINT32 start = writer.Tell();
+                component->Serialize(writer);
+                writer.WriteAt(sizeOffset, writer.Tell() - start);
+            }
+        }
+    }
+
+    bool SceneSerializer::Save(const HSceneObject& so, const String& path)
+    {
+        BinaryWriter writer;
+        Save(so, writer);
+
+        FileStream stream(path, DataStream::WRITE);
+        if (stream.Fail())
+            return false;
+
+        const Vector<UINT8>& data = writer.GetData();
+        return stream.Write(data.data(), data.size()) == data.size();
+    }
+
+    HSceneObject SceneSerializer::Load(BinaryReader& reader, const HSceneObject& parent, bool keepUUIDs)
+    {
+        SceneFileHeader header;
+        if (!reader.Read(header) || header.Magic != MAGIC || header.Version > VERSION || header.NumObjects == 0)
+        {
+            TE_DEBUG("Invalid scene data");
+            return HSceneObject();
+        }
+
+        reader.SetVersion(header.Version);
+
+        // Records are read in place, only names are copied
+        const SerializedSceneObject* records = reader.ReadArray<SerializedSceneObject>(header.NumObjects);
+        if (records == nullptr)
+        {
+            TE_DEBUG("Invalid scene data");
+            return HSceneObject();
+        }
+
+        // Parents are always stored before their children, with a single root
+        for (UINT32 i = 0; i < header.NumObjects; i++)
+        {
+            if ((i == 0) != (records[i].Parent == NO_PARENT) || (i > 0 && records[i].Parent >= i))
+            {
+                TE_DEBUG("Invalid scene hierarchy");
+                return HSceneObject();
+            }
+        }
+
+        // Each component is stored with at least its type, object index and size
+        if ((UINT64)header.NumComponents > reader.GetRemaining() / (3 * sizeof(UINT32)))
+        {
+            TE_DEBUG("Invalid scene data");
+            return HSceneObject();
+        }
+
+        HSceneObject root = parent;
+        if (root == nullptr && SceneManager::IsStarted() && gSceneManager().GetMainScene() != nullptr)
+            root = gSceneManager().GetMainScene()->GetRoot();
+
+        // Both counts are bounded by the size of the data at this point
+        GameObjectManager::Instance().Reserve(header.NumObjects + header.NumComponents);
+
+        Vector<HSceneObject> objects;
+        objects.reserve(header.NumObjects);
+
+        String name;
+        for (UINT32 i = 0; i < header.NumObjects; i++)
+        {
+            const SerializedSceneObject& record = records[i];
+            reader.Read(name);
+
+            // Objects are created with a new UUID
+            HSceneObject so = SceneObject::CreateInternal(name);
+            if (keepUUIDs)
+                so->_setUUID(record.Id);
+            so->_localTfrm = Transform(record.Position, record.Rotation, record.Scale);
+            so->_mobility = (ObjectMobility)record.Mobility;
+            so->_activeSelf = record.Active != 0;
+            so->_linkWithoutNotify(i == 0 ? root : objects[record.Parent]);
+
+            objects.push_back(so);
+        }
+
+        // Single pass propagating transforms, so components are created with their final world transform
+        objects[0]->NotifyTransformChanged((TransformChangedFlags)(TCF_Parent | TCF_Transform));
+
+        UnorderedMap<UINT32, ComponentFactory>& factories = GetComponentFactories();
+        for (UINT32 i = 0; i < header.NumComponents; i++)
+        {
+            UINT32 type = 0;
+            UINT32 objectIdx = 0;
+            UINT32 size = 0;
+
+            reader.Read(type);
+            reader.Read(objectIdx);
+            reader.Read(size);
+
+            BinaryReader data = reader.ReadBlock(size);
+            if (reader.HasFailed())
+                break;
+
+            auto iterFind = factories.find(type);
+            if (iterFind == factories.end() || objectIdx >= header.NumObjects)
+                continue;
+
+            HComponent component = iterFind->second(objects[objectIdx]);
+            const UUID uuid = component->GetUUID();
+
+            component->Deserialize(data);
+            if (!keepUUIDs)
+                component->_setUUID(uuid);
+
+            component->Initialize();
+        }
+
+        if (reader.HasFailed())
+            TE_DEBUG("Scene data is truncated, some objects or components were not loaded");
+
+        return objects[0];
+    }
+
+    HSceneObject SceneSerializer::Load(const String& path, const HSceneObject& parent, bool keepUUIDs)
+    {
+        FileStream stream(path, DataStream::READ);
+        if (stream.Fail())
+            return HSceneObject();
+
+        Vector<UINT8> data(stream.Size());
+        if (stream.Read(data.data(), data.size()) != data.size())
+            return HSceneObject();
+
+        BinaryReader reader(data.data(), (UINT32)data.size());
+        return Load(reader, parent, keepUUIDs);
+    }
+
+    void SceneSerializer::RegisterComponentType(UINT32 type, const std::function<HComponent(const HSceneObject&)>& factory)
+    {
+        GetComponentFactories()[type] = factory;
+    }
+}
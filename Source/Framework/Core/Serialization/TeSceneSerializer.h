@@ -0,0 +1,65 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Serialization/TeBinaryStream.h"
+#include "Scene/TeSceneObject.h"
+
+namespace te
+{
+    /**
+     * Saves and loads scene object hierarchies in a versioned binary format:
+     *  - A header with the version of the format and the number of objects and components.
+     *  - Fixed size records (transform, mobility, parent...) of all the objects, in depth-first order, read in place.
+     *  - Names of the objects.
+     *  - Components, each one with its type, its object and the data written by Component::Serialize().
+     *
+     * Components are created from their type id, see RegisterComponentType(). Types that are not registered are skipped
+     * when saving and when loading. Resources are referenced by UUID and must be loaded before the scene.
+     */
+    class TE_CORE_EXPORT SceneSerializer
+    {
+    public:
+        /** Identifies files written by the serializer. */
+        static const UINT32 MAGIC = 0x43534554; // "TESC"
+
+        /**
+         * Version of the format written by Save(). Data written with a more recent version can't be loaded.
+         *  - 1: First version.
+         *  - 2: CRenderable stores all its RenderableProperties.
+         */
+        static const UINT32 VERSION = 2;
+
+        /** Writes a scene object, its descendants and their components. */
+        static void Save(const HSceneObject& so, BinaryWriter& writer);
+
+        /** Writes a scene object, its descendants and their components to a file. Returns false if it can't be written. */
+        static bool Save(const HSceneObject& so, const String& path);
+
+        /**
+         * Creates the scene objects and components read from data written by Save().
+         *
+         * @param[in]	reader		Data to read.
+         * @param[in]	parent		Parent of the loaded hierarchy. If null, it is added to the root of the main scene, or
+         *							left without parent if the scene manager isn't started.
+         * @param[in]	keepUUIDs	If true, objects and components get the UUIDs they were saved with. Otherwise they get
+         *							new ones, so the same data can be loaded several times without duplicating UUIDs.
+         * @return					Root of the loaded hierarchy, or null if the data is invalid.
+         */
+        static HSceneObject Load(BinaryReader& reader, const HSceneObject& parent = HSceneObject(), bool keepUUIDs = false);
+
+        /** Creates the scene objects and components read from a file written by Save(). See Load(). */
+        static HSceneObject Load(const String& path, const HSceneObject& parent = HSceneObject(), bool keepUUIDs = false);
+
+        /** Allows components of type T to be saved and loaded. Built-in component types are registered by default. */
+        template<class T>
+        static void RegisterComponentType()
+        {
+            RegisterComponentType(T::GetComponentType(), [](const HSceneObject& so) {
+                return static_object_cast<Component>(so->AddComponent<T>());
+            });
+        }
+
+        /** Allows components of a type to be saved and loaded, created by @p factory on the provided scene object. */
+        static void RegisterComponentType(UINT32 type, const std::function<HComponent(const HSceneObject&)>& factory);
+    };
+}
@@ -17,6 +17,8 @@
 #include "Resources/TeBuiltinResources.h"
 #include "Scene/TeSceneManager.h"
 #include "Scene/TeGameObjectManager.h"
+#include "Scene/TeTransformHierarchy.h"
+#include "Scene/TeWorldStreaming.h"
 #include "CoreUtility/TeCoreObjectManager.h"
 #include "Renderer/TeRendererMaterialManager.h"
 #include "Animation/TeAnimationManager.h"
@@ -34,6 +36,7 @@
 #include "Importer/TeImporter.h"
 #include "Renderer/TeRenderer.h"
 #include "Profiling/TeProfilerGPU.h"
+#include "Profiling/TeProfilerRenderer.h"
 
 #include "Gui/TeGuiAPI.h"
 
@@ -64,10 +67,15 @@ namespace te
         DynLibManager::StartUp();
         CoreObjectManager::StartUp();
         ProfilerGPU::StartUp();
+        ProfilerRenderer::StartUp();
         RenderAPIManager::StartUp();
         GuiManager::StartUp();
         GpuProgramManager::StartUp();
         GameObjectManager::StartUp();
+
+        if (_startUpDesc.UseTransformHierarchy)
+            TransformHierarchy::StartUp();
+
         RendererManager::StartUp();
         ResourceManager::StartUp();
         ScriptManager::StartUp();
@@ -93,6 +101,7 @@ namespace te
         PhysicsManager::StartUp(_startUpDesc.Physics);
         RendererMaterialManager::StartUp();
         SceneManager::StartUp();
+        WorldStreaming::StartUp();
         Input::StartUp();
         VirtualInput::StartUp();
 
@@ -117,12 +126,17 @@ namespace te
         _window = nullptr;
         _renderer = nullptr;
 
+        WorldStreaming::ShutDown();
         TaskScheduler::ShutDown();
         Importer::ShutDown();
         VirtualInput::ShutDown();
         Input::ShutDown();
         ParamBlockManager::ShutDown();
         SceneManager::ShutDown();
+
+        if (TransformHierarchy::IsStarted())
+            TransformHierarchy::ShutDown();
+
         ScriptManager::ShutDown();
         AnimationManager::ShutDown();
         GameObjectManager::ShutDown();
@@ -136,6 +150,7 @@ namespace te
         RenderAPIManager::ShutDown();
         GpuProgramManager::ShutDown();
         CoreObjectManager::ShutDown();
+        ProfilerRenderer::ShutDown();
         Platform::ShutDown();
         DynLibManager::ShutDown();
         Time::ShutDown();
@@ -165,6 +180,7 @@ namespace te
             PreUpdate();
 
             gScriptManager().Update();
+            gWorldStreaming().Update();
             gSceneManager().Update();
             gAudio().Update();
             gPhysics().Update();
@@ -177,6 +193,9 @@ namespace te
             gScriptManager().PostUpdate();
             PostUpdate();
 
+            if (TransformHierarchy::IsStarted())
+                gTransformHierarchy().Update();
+
             _perFrameData->Animation = AnimationManager::Instance().Update();
 
             DisplayFrameRate();
@@ -20,6 +20,9 @@ namespace te
         RENDER_WINDOW_DESC WindowDesc; /** Describes the window to create during start-up. */
 
         Vector<String> Importers; /** A list of importer plugins to load. */
+
+        /** Stores transforms of scene objects in a TransformHierarchy, updated once per frame. See TransformHierarchy. */
+        bool UseTransformHierarchy = false;
     };
 
     /** Represents the current state of the application */
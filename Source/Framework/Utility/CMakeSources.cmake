@@ -112,6 +112,7 @@ set(TE_UTILITY_INC_UTILITY
     "Utility/Utility/TeUtility.h"
     "Utility/Utility/TeUUID.h"
     "Utility/Utility/TeEvent.h"
+    "Utility/Utility/TeInplaceFunction.h"
     "Utility/Utility/TePlatformUtility.h"
     "Utility/Utility/TeBitwise.h"
     "Utility/Utility/TeDataStream.h"
@@ -130,6 +131,7 @@ set(TE_UTILITY_SRC_UTILITY
     "Utility/Utility/TeDataStream.cpp"
     "Utility/Utility/TeFrameAllocator.cpp"
     "Utility/Utility/TeFileSystem.cpp"
+    "Utility/Utility/TeEvent.cpp"
 )
 
 set(TE_UTILITY_INC_THREADING
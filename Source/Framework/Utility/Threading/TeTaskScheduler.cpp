@@ -1,16 +1,19 @@
 #include "TeTaskScheduler.h"
+#include "Utility/TePoolAllocator.h"
 
 namespace te
 {
-    Task::Task(const String& name, std::function<void()> taskWorker, std::function<void()> callback)
+    Task::Task(const String& name, TaskFunction taskWorker, TaskFunction callback)
         : _name(name)
         , _taskWorker(std::move(taskWorker))
         , _callback(std::move(callback))
     { }
 
-    SPtr<Task> Task::Create(const String& name, std::function<void()> taskWorker, std::function<void()> callback)
+    SPtr<Task> Task::Create(const String& name, TaskFunction taskWorker, TaskFunction callback)
     {
-        return te_shared_ptr_new<Task>(name, std::move(taskWorker), std::move(callback));
+        // The task and its shared pointer data are taken from a pool at once
+        return std::allocate_shared<Task>(StdPoolAllocator<Task, 256, 16>(), name, std::move(taskWorker),
+            std::move(callback));
     }
 
     bool Task::IsComplete() const
@@ -30,7 +33,18 @@ namespace te
 
     void Task::Cancel()
     {
-        _state = 3;
+        {
+            Lock lock(_mutexState);
+            _state = 3;
+        }
+
+        _conditionState.notify_all();
+    }
+
+    void Task::Wait()
+    {
+        Lock lock(_mutexState);
+        _conditionState.wait(lock, [this] { return _state == 2 || _state == 3; });
     }
 
     void Task::Execute()
@@ -40,7 +54,14 @@ namespace te
             _state = 1;
             _taskWorker();
             if (_callback) _callback();
-            _state = 2;
+
+            // Changed with the mutex locked, so a thread starting to wait can't miss the notification
+            {
+                Lock lock(_mutexState);
+                _state = 2;
+            }
+
+            _conditionState.notify_all();
         }        
     }
 
@@ -90,7 +111,7 @@ namespace te
 
         {
             Lock lock(_mutexTasks);
-            _tasks.push_back(task);
+            _tasks.push_back(std::move(task));
         }
 
         // Wake up a thread
@@ -114,7 +135,7 @@ namespace te
                     return;
 
                 // Get next task in the queue.
-                task = _tasks.front();
+                task = std::move(_tasks.front());
 
                 // Remove it from the queue.
                 _tasks.pop_front();
@@ -123,8 +144,9 @@ namespace te
                 lock.unlock();
             }
 
-            // Execute the task.
+            // Execute the task, then release it so its memory goes back to the pool as soon as possible
             task->Execute();
+            task = nullptr;
         }
     }
 
@@ -3,8 +3,8 @@
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Threading/TeThreading.h"
 #include "Utility/TeModule.h"
+#include "Utility/TeInplaceFunction.h"
 
-#include <functional>
 #include <atomic>
 
 namespace te
@@ -12,7 +12,13 @@ namespace te
     class TE_UTILITY_EXPORT Task
     {
     public:
-        Task(const String& name, std::function<void()> taskWorker, std::function<void()> callback = nullptr);
+        /**
+         * Callable executed by a task. Lambdas capturing up to 64 bytes are stored inline, so creating a task doesn't
+         * allocate memory for them.
+         */
+        typedef InplaceFunction<void(), 64> TaskFunction;
+
+        Task(const String& name, TaskFunction taskWorker, TaskFunction callback = nullptr);
 
         /**
          * Creates a new task. Task should be provided to TaskScheduler in order for it to start.
@@ -20,8 +26,10 @@ namespace te
          * @param[in]	name		Name you can use to more easily identify the task.
          * @param[in]	taskWorker	Worker method that does all of the work in the task.
          * @param[in]	callback  	(optional) Method to call when task is complete
+         *
+         * @note	Tasks are allocated from a pool, along with their shared pointer data.
          */
-        static SPtr<Task> Create(const String& name, std::function<void()> taskWorker, std::function<void()> callback = nullptr);
+        static SPtr<Task> Create(const String& name, TaskFunction taskWorker, TaskFunction callback = nullptr);
 
         /** Returns true if the task has completed. */
         bool IsComplete() const;
@@ -32,6 +40,9 @@ namespace te
         /**	Returns true if the task has been canceled. */
         bool IsCanceled() const;
 
+        /** Blocks the calling thread until the task has completed or has been canceled. */
+        void Wait();
+
         /** Cancels the task and removes it from the TaskSchedulers queue. */
         void Cancel();
 
@@ -42,9 +53,12 @@ namespace te
         friend class TaskScheduler;
 
         String _name;
-        std::function<void()> _taskWorker;
-        std::function<void()> _callback;
+        TaskFunction _taskWorker;
+        TaskFunction _callback;
         std::atomic<UINT32> _state{ 0 }; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
+
+        Mutex _mutexState;
+        Signal _conditionState;
     };
 
     /**
@@ -0,0 +1,11 @@
+#include "Utility/TeEvent.h"
+
+namespace te
+{
+    EventCallFrame*& GetCurrentEventCallFrame()
+    {
+        // Defined here rather than inline, so all modules share the same frames
+        static thread_local EventCallFrame* currentFrame = nullptr;
+        return currentFrame;
+    }
+}
@@ -2,8 +2,11 @@
 
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Threading/TeThreading.h"
+#include "Utility/TeInplaceFunction.h"
 
-#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 namespace te
 {
@@ -11,24 +14,56 @@ namespace te
     struct BaseConnectionData
     {
         BaseConnectionData() = default;
+        virtual ~BaseConnectionData() = default;
 
-        virtual ~BaseConnectionData()
+        /** Releases a reference to the connection, deleting it once neither the event nor a handle uses it. */
+        void Release()
         {
-            assert(!HandleLinks && !IsActive);
-        }
-        
-        virtual void Deactivate()
-        {
-            IsActive = false;
+            if (RefCount.fetch_sub(1) == 1)
+                te_delete(this);
         }
 
-        BaseConnectionData* Previous = nullptr;
-        BaseConnectionData* Next = nullptr;
-        bool IsActive = true;
-        UINT16 HandleLinks = 0;
+        std::atomic<bool> IsActive{ true };
+        // One reference is owned by the event, one by each handle
+        std::atomic<UINT32> RefCount{ 1 };
+    };
+
+    /**
+     * Array of the connections of an event. Replaced by another array when connections are added or removed. Arrays are
+     * only reused once no invocation iterates over them, and only deleted with the event.
+     */
+    struct ConnectionList
+    {
+        Vector<BaseConnectionData*> Connections;
+        // Number of invocations iterating over the array, on all threads
+        std::atomic<UINT32> NumInvocations{ 0 };
+        // Incremented each time the array is recycled
+        std::atomic<UINT32> Generation{ 0 };
+    };
+
+    class InternalData;
+
+    /** Connection array iterated over by an event on the current thread. Frames of nested invocations are linked together. */
+    struct EventCallFrame
+    {
+        const InternalData* Data = nullptr;
+        const ConnectionList* List = nullptr;
+        EventCallFrame* Previous = nullptr;
+        // Set when a callback clears or destroys the event, so its data outlives the invocation
+        SPtr<InternalData> KeepAlive;
     };
 
-    /** Internal data for an Event, storing all connections. */
+    /** Returns the innermost invocation of an event on the current thread, or null if there is none. */
+    TE_UTILITY_EXPORT EventCallFrame*& GetCurrentEventCallFrame();
+
+    /**
+     * Internal data for an Event, storing all connections.
+     *
+     * Triggering an event doesn't lock nor allocate: it reads the current connection array, published through an atomic
+     * pointer, and counts itself on that array. Connecting and disconnecting are serialized by a mutex and publish
+     * another array. Replaced arrays, and the connections removed with them, are released once no invocation iterates
+     * over them anymore.
+     */
     class InternalData
     {
     public:
@@ -36,139 +71,279 @@ namespace te
 
         ~InternalData()
         {
-            BaseConnectionData* connection = _connections;
-            while (connection != nullptr)
-            {
-                BaseConnectionData* next = connection->Next;
-                te_free(connection);
-
-                connection = next;
-            }
-
-            connection =_freeConnections;
-            while (connection != nullptr)
-            {
-                BaseConnectionData* next = connection->Next;
-                te_free(connection);
-
-                connection = next;
-            }
+            Clear();
 
-            connection = _newConnections;
-            while (connection != nullptr)
-            {
-                BaseConnectionData* next = connection->Next;
-                te_free(connection);
+            // Invocations keep the event data alive, so none can be in progress anymore
+            for (auto& list : _retiredLists)
+                te_delete(list);
 
-                connection = next;
-            }
+            for (auto& list : _freeLists)
+                te_delete(list);
         }
 
         /** Appends a new connection to the active connection array. */
         void Connect(BaseConnectionData* connection)
         {
-            connection->Previous = _lastConnection;
+            {
+                Lock lock(_mutex);
 
-            if (_lastConnection != nullptr)
-                _lastConnection->Next = connection;
+                ConnectionList* list = AllocateList();
+                if (const ConnectionList* current = _connections.load(std::memory_order_relaxed))
+                    list->Connections = current->Connections;
 
-            _lastConnection = connection;
+                list->Connections.push_back(connection);
+                Publish(list);
+            }
 
-            // First connection
-            if (_connections == nullptr)
-                _connections = connection;
+            CollectRetired();
         }
 
         /**
-         * Disconnects the connection with the specified data, ensuring the event doesn't call its callback again.
+         * Disconnects the connection with the specified data. Once this returns, the event doesn't call its callback
+         * anymore: invocations in progress on other threads are waited for. Invocations in progress on the current
+         * thread skip the callback, unless they are already calling it.
+         *
+         * @note	Disconnecting from a callback while the event is also triggered on another thread waits for that
+         *			invocation to end, so two such callbacks disconnecting at the same time deadlock.
          */
         void Disconnect(BaseConnectionData* connection)
         {
-            RecursiveLock lock(_mutex);
+            Vector<std::pair<ConnectionList*, UINT32>> busyLists;
+
+            {
+                Lock lock(_mutex);
 
-            connection->Deactivate();
-            connection->HandleLinks--;
+                // Already removed by Clear(), but invocations using it might still be in progress
+                if (connection->IsActive.load(std::memory_order_relaxed))
+                {
+                    connection->IsActive.store(false, std::memory_order_relaxed);
+
+                    ConnectionList* list = nullptr;
+                    if (const ConnectionList* current = _connections.load(std::memory_order_relaxed))
+                    {
+                        if (current->Connections.size() > 1)
+                        {
+                            list = AllocateList();
+                            for (auto& entry : current->Connections)
+                            {
+                                if (entry != connection)
+                                    list->Connections.push_back(entry);
+                            }
+                        }
+                    }
+
+                    Publish(list);
+                    _retiredConnections.push_back(connection);
+                }
 
-            //If we are deleting the last event, pointed value by _connections does not exist anymore
-            if (_connections == connection)
-                _connections = nullptr;
+                GetBusyLists(connection, busyLists);
+            }
 
-            if (connection->HandleLinks == 0) 
-                free(connection);       
+            // The caller holds a reference to the connection, so it stays valid while waiting
+            WaitForInvocations(busyLists);
+            CollectRetired();
         }
 
-        /** Disconnects all connections in the event. */
+        /** Disconnects all connections in the event. Invocations in progress on other threads are waited for. */
         void Clear()
         {
-            RecursiveLock lock(_mutex);
+            Vector<std::pair<ConnectionList*, UINT32>> busyLists;
 
-            BaseConnectionData* conn = _connections;
-            while (conn != nullptr)
             {
-                BaseConnectionData* next = conn->Next;
-                conn->Deactivate();
+                Lock lock(_mutex);
 
-                if (conn->HandleLinks == 0)
-                    free(conn);
+                const ConnectionList* current = _connections.load(std::memory_order_relaxed);
+                if (current == nullptr)
+                    return;
 
-                conn = next;
+                for (auto& connection : current->Connections)
+                {
+                    connection->IsActive.store(false, std::memory_order_relaxed);
+                    _retiredConnections.push_back(connection);
+                }
+
+                Publish(nullptr);
+                GetBusyLists(nullptr, busyLists);
             }
 
-            _connections = nullptr;
-            _lastConnection = nullptr;
+            WaitForInvocations(busyLists);
+            CollectRetired();
+        }
+
+        /** Checks if the event has any connection. */
+        bool Empty() const
+        {
+            return _connections.load(std::memory_order_relaxed) == nullptr;
         }
 
         /**
-         * Called when the event handle no longer keeps a reference to the connection data. This means we might be able to
-         * free (and reuse) its memory if the event is done with it too.
+         * Starts iterating over the current connection array and returns it, or returns null if there is no connection.
+         * A returned array must be passed to EndInvoke() once done.
          */
-        void FreeHandle(BaseConnectionData* connection)
+        ConnectionList* BeginInvoke()
         {
-            RecursiveLock lock(_mutex);
+            // Acquire, so the counter of an array allocated by Connect() is seen initialized
+            ConnectionList* list = _connections.load(std::memory_order_acquire);
+            while (list != nullptr)
+            {
+                // Sequentially consistent with Publish(): either the array is still current once counted, or the
+                // thread replacing it sees the invocation and waits for it
+                list->NumInvocations.fetch_add(1);
+
+                ConnectionList* current = _connections.load();
+                if (current == list)
+                    return list;
 
-            connection->HandleLinks--;
+                // Replaced (or recycled) before being counted, try again with the new array
+                EndInvoke(list);
+                list = current;
+            }
+
+            return nullptr;
+        }
 
-            if (connection->HandleLinks == 0 && !connection->IsActive)
-                Free(connection);
+        /** Stops iterating over an array returned by BeginInvoke(), releasing it if it has been replaced. */
+        void EndInvoke(ConnectionList* list)
+        {
+            if (list->NumInvocations.fetch_sub(1) == 1 && _hasRetired.load() && _connections.load() != list)
+                CollectRetired();
         }
 
-        /** Releases connection data and makes it available for re-use when next connection is formed. */
-        void Free(BaseConnectionData* connection)
+    private:
+        /** Returns an empty array, recycling a released one if possible. Must be called with the mutex locked. */
+        ConnectionList* AllocateList()
         {
-            if (connection->Previous != nullptr)
-                connection->Previous->Next = connection->Next;
-            else
-                _connections = connection->Next;
+            if (_freeLists.empty())
+                return te_new<ConnectionList>();
 
-            if (connection->Next != nullptr)
-                connection->Next->Previous = connection->Previous;
-            else
-                _lastConnection = connection->Previous;
+            ConnectionList* list = _freeLists.back();
+            _freeLists.pop_back();
 
-            connection->Previous = nullptr;
-            connection->Next = nullptr;
+            return list;
+        }
+
+        /** Replaces the active connection array. Must be called with the mutex locked. */
+        void Publish(ConnectionList* list)
+        {
+            ConnectionList* previous = _connections.exchange(list);
+            if (previous != nullptr)
+                _retiredLists.push_back(previous);
 
-            if (_freeConnections != nullptr)
+            // Flagged before CollectRetired() reads the invocation counts, so either it or the last EndInvoke() of a
+            // replaced array sees the other
+            _hasRetired.store(true);
+        }
+
+        /**
+         * Outputs the replaced arrays still iterated over, along with their generation. Only outputs the arrays
+         * containing @p connection, unless it is null. Must be called with the mutex locked.
+         */
+        void GetBusyLists(BaseConnectionData* connection, Vector<std::pair<ConnectionList*, UINT32>>& output)
+        {
+            for (auto& list : _retiredLists)
             {
-                connection->Next = _freeConnections;
-                _freeConnections->Previous = connection;
+                if (list->NumInvocations.load() == 0)
+                    continue;
+
+                if (connection != nullptr &&
+                    std::find(list->Connections.begin(), list->Connections.end(), connection) == list->Connections.end())
+                {
+                    continue;
+                }
+
+                output.push_back(std::make_pair(list, list->Generation.load(std::memory_order_relaxed)));
             }
+        }
+
+        /** Recycles replaced arrays and releases removed connections, once no invocation iterates over them. */
+        void CollectRetired()
+        {
+            Vector<BaseConnectionData*> connections;
 
-            _freeConnections = connection;
-            _freeConnections->~BaseConnectionData();
+            {
+                Lock lock(_mutex);
+
+                if (!_hasRetired.load())
+                    return;
+
+                for (auto it = _retiredLists.begin(); it != _retiredLists.end();)
+                {
+                    ConnectionList* list = *it;
+                    if (list->NumInvocations.load() != 0)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    list->Connections.clear();
+                    list->Generation.fetch_add(1, std::memory_order_relaxed);
+                    _freeLists.push_back(list);
+
+                    it = _retiredLists.erase(it);
+                }
+
+                for (auto it = _retiredConnections.begin(); it != _retiredConnections.end();)
+                {
+                    bool isUsed = false;
+                    for (auto& list : _retiredLists)
+                    {
+                        if (std::find(list->Connections.begin(), list->Connections.end(), *it) != list->Connections.end())
+                        {
+                            isUsed = true;
+                            break;
+                        }
+                    }
+
+                    if (isUsed)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    connections.push_back(*it);
+                    it = _retiredConnections.erase(it);
+                }
+
+                _hasRetired.store(!_retiredLists.empty());
+            }
+
+            // Destroying a callback can connect or disconnect callbacks of this event, so the mutex must not be locked
+            for (auto& connection : connections)
+                connection->Release();
         }
 
-        // Pointer to the first connection of the linked list
-        BaseConnectionData* _connections = nullptr; 
-        // Pointer to the last connection added
-        BaseConnectionData* _lastConnection = nullptr;
-        // The list of free connections
-        BaseConnectionData* _freeConnections = nullptr; 
-        // Pointer to the linked representing connections added while iterating through the list (concurrency)
-        BaseConnectionData* _newConnections = nullptr; 
-
-        RecursiveMutex _mutex;
-        bool _isCurrentlyTriggering = false;
+        /** Waits until arrays output by GetBusyLists() are only iterated over by the current thread, or recycled. */
+        static void WaitForInvocations(const Vector<std::pair<ConnectionList*, UINT32>>& lists)
+        {
+            for (auto& entry : lists)
+            {
+                ConnectionList* list = entry.first;
+
+                UINT32 numOwnInvocations = 0;
+                for (EventCallFrame* frame = GetCurrentEventCallFrame(); frame != nullptr; frame = frame->Previous)
+                {
+                    if (frame->List == list)
+                        numOwnInvocations++;
+                }
+
+                // Callbacks are expected to be short, and disconnecting while triggering on another thread is rare
+                while (list->NumInvocations.load() > numOwnInvocations &&
+                    list->Generation.load(std::memory_order_relaxed) == entry.second)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        std::atomic<ConnectionList*> _connections{ nullptr };
+        std::atomic<bool> _hasRetired{ false };
+
+        Vector<ConnectionList*> _retiredLists;
+        Vector<ConnectionList*> _freeLists;
+        Vector<BaseConnectionData*> _retiredConnections;
+
+        Mutex _mutex;
     };
 
     /** Event handler. Allows you to track to which events you subscribed to and disconnect from them when needed. */
@@ -181,20 +356,31 @@ namespace te
             : _connection(connection)
             , _eventData(std::move(eventData))
         {
-            connection->HandleLinks++;
+            connection->RefCount.fetch_add(1);
+        }
+
+        HEvent(const HEvent& other)
+            : _connection(other._connection)
+            , _eventData(other._eventData)
+        {
+            if (_connection != nullptr)
+                _connection->RefCount.fetch_add(1);
         }
 
         ~HEvent()
         {
             if (_connection != nullptr)
-                _eventData->FreeHandle(_connection);
+                _connection->Release();
         }
 
+        /** Disconnects the callback. It isn't called anymore once this returns, unless it is the caller. */
         void Disconnect()
         {
             if (_connection != nullptr)
             {
                 _eventData->Disconnect(_connection);
+                _connection->Release();
+
                 _connection = nullptr;
                 _eventData = nullptr;
             }
@@ -202,11 +388,14 @@ namespace te
 
         HEvent& operator=(const HEvent& rhs)
         {
-            _connection = rhs._connection;
-            _eventData = rhs._eventData;
+            if (rhs._connection != nullptr)
+                rhs._connection->RefCount.fetch_add(1);
 
             if (_connection != nullptr)
-                _connection->HandleLinks++;
+                _connection->Release();
+
+            _connection = rhs._connection;
+            _eventData = rhs._eventData;
 
             return *this;
         }
@@ -218,6 +407,10 @@ namespace te
 
     /**
      * Events allows you to register method callbacks that get notified when the event is triggered.
+     *
+     * Triggering an event is lock-free and doesn't allocate. Callbacks are stored in an InplaceFunction, so binding a
+     * method or a small lambda doesn't allocate either. Callbacks can connect or disconnect callbacks, or destroy the
+     * event, while it is triggered: new connections are only called from the next trigger.
      */
     template <class ReturnType, class... Args>
     class InternalEvent
@@ -225,13 +418,12 @@ namespace te
     public:
         struct ConnectionData : BaseConnectionData
         {
-            void Deactivate() override
-            {
-                Function = nullptr;
-                BaseConnectionData::Deactivate();
-            }
+            template <class F>
+            ConnectionData(F&& function)
+                : Function(std::forward<F>(function))
+            { }
 
-            std::function<ReturnType(Args...)> Function;
+            InplaceFunction<ReturnType(Args...)> Function;
         };
 
         InternalEvent()
@@ -244,42 +436,11 @@ namespace te
         }
 
         /** Register a new callback that will get notified once the event is triggered. */
-        HEvent Connect(std::function<ReturnType(Args...)> function)
+        template <class F>
+        HEvent Connect(F&& function)
         {
-            RecursiveLock lock(_internalData->_mutex);
-
-            ConnectionData* connection = nullptr;
-            if (_internalData->_freeConnections != nullptr)
-            {
-                connection = static_cast<ConnectionData*>(_internalData->_freeConnections);
-                _internalData->_freeConnections = connection->Next;
-
-                new (connection)ConnectionData();
-                if (connection->Next != nullptr)
-                    connection->Next->Previous = nullptr;
-
-                connection->IsActive = true;
-            }
-
-            if (connection == nullptr)
-                connection = te_new<ConnectionData>();
-
-            // If currently iterating over the connection list, delay modifying it until done
-            if (_internalData->_isCurrentlyTriggering)
-            {
-                connection->Previous = _internalData->_newConnections;
-
-                if (_internalData->_newConnections != nullptr)
-                    _internalData->_newConnections->Next = connection;
-
-                _internalData->_newConnections = connection;
-            }
-            else
-            {
-                _internalData->Connect(connection);
-            }
-
-            connection->Function = function;
+            ConnectionData* connection = te_new<ConnectionData>(std::forward<F>(function));
+            _internalData->Connect(connection);
 
             return HEvent(_internalData, connection);
         }
@@ -287,54 +448,57 @@ namespace te
         /** Trigger the event, notifying all register callback methods. */
         void operator() (Args... args)
         {
-            // Increase ref count to ensure this event data isn't destroyed if one of the callbacks
-            // deletes the event itself.
-            SPtr<InternalData> internalData = _internalData;
-
-            RecursiveLock lock(internalData->_mutex);
-            internalData->_isCurrentlyTriggering = true;
-
-            ConnectionData* connection = static_cast<ConnectionData*>(internalData->_connections);
-            while (connection != nullptr)
+            InternalData* internalData = _internalData.get();
+            if (internalData == nullptr)
+                return;
+
+            ConnectionList* list = internalData->BeginInvoke();
+            if (list == nullptr)
+                return;
+
+            // Lets Disconnect() know which arrays are iterated over by this thread, so it doesn't wait for them, and
+            // lets Clear() keep the event data alive if a callback deletes the event itself
+            EventCallFrame*& currentFrame = GetCurrentEventCallFrame();
+            EventCallFrame frame;
+            frame.Data = internalData;
+            frame.List = list;
+            frame.Previous = currentFrame;
+            currentFrame = &frame;
+
+            for (auto& entry : list->Connections)
             {
-                // Save next here in case the callback itself disconnects this connection
-                ConnectionData* next = static_cast<ConnectionData*>(connection->Next);
-
-                if (connection->Function != nullptr)
-                    connection->Function(std::forward<Args>(args)...);
-
-                connection = next;
+                // Skip connections disconnected by a previous callback. Callbacks disconnected on another thread are
+                // waited for by Disconnect(), so the check doesn't need any ordering.
+                if (!entry->IsActive.load(std::memory_order_relaxed))
+                    continue;
+
+                ConnectionData* connection = static_cast<ConnectionData*>(entry);
+                if (connection->Function)
+                    connection->Function(args...);
             }
 
-            internalData->_isCurrentlyTriggering = false;
+            currentFrame = frame.Previous;
+            internalData->EndInvoke(list);
+        }
 
-            // If any new connections were added during the above calls, add them to the connection list
-            if (internalData->_newConnections != nullptr)
+        /** Clear all callbacks from the event. */
+        void Clear()
+        {
+            if (_internalData)
             {
-                BaseConnectionData* lastNewConnection = internalData->_newConnections;
-                while (lastNewConnection != nullptr)
-                    lastNewConnection = lastNewConnection->Next;
+                _internalData->Clear();
 
-                BaseConnectionData* currentConnection = lastNewConnection;
-                while (currentConnection != nullptr)
+                // Called from a callback: the outermost invocation of the event on this thread releases its data
+                EventCallFrame* outermostFrame = nullptr;
+                for (EventCallFrame* frame = GetCurrentEventCallFrame(); frame != nullptr; frame = frame->Previous)
                 {
-                    BaseConnectionData* prevConnection = currentConnection->Previous;
-                    currentConnection->Previous = nullptr;
-                    currentConnection->Previous = nullptr;
-
-                    _internalData->Connect(currentConnection);
-                    currentConnection = prevConnection;
+                    if (frame->Data == _internalData.get())
+                        outermostFrame = frame;
                 }
 
-                internalData->_newConnections = nullptr;
+                if (outermostFrame != nullptr)
+                    outermostFrame->KeepAlive = std::move(_internalData);
             }
-        }
-
-        /** Clear all callbacks from the event. */
-        void Clear()
-        {
-            if(_internalData)
-                _internalData->Clear();
 
             _internalData = nullptr;
         }
@@ -344,8 +508,7 @@ namespace te
          */
         bool Empty() const
         {
-            RecursiveLock lock(_internalData->_mutex);
-            return _internalData->_connections == nullptr;
+            return _internalData == nullptr || _internalData->Empty();
         }
 
     protected:
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace te
+{
+    template <class Signature, size_t Capacity = 32>
+    class InplaceFunction;
+
+    /**
+     * Move-only replacement for std::function storing its callable in an inline buffer of @p Capacity bytes, so
+     * creating, moving and calling it doesn't allocate. Callables that don't fit in the buffer (or can throw when moved)
+     * are allocated on the heap instead.
+     */
+    template <class ReturnType, class... Args, size_t Capacity>
+    class InplaceFunction<ReturnType(Args...), Capacity>
+    {
+        static_assert(Capacity >= sizeof(void*), "Capacity must be large enough to store a pointer.");
+
+    public:
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t) { }
+
+        template <class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, InplaceFunction>::value>>
+        InplaceFunction(F&& function)
+        {
+            Assign(std::forward<F>(function));
+        }
+
+        InplaceFunction(InplaceFunction&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+        ~InplaceFunction()
+        {
+            Reset();
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+
+            return *this;
+        }
+
+        InplaceFunction& operator=(std::nullptr_t)
+        {
+            Reset();
+            return *this;
+        }
+
+        template <class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, InplaceFunction>::value>>
+        InplaceFunction& operator=(F&& function)
+        {
+            Reset();
+            Assign(std::forward<F>(function));
+
+            return *this;
+        }
+
+        /** Calls the stored callable. Must not be empty. */
+        ReturnType operator() (Args... args) const
+        {
+            return _invoke(const_cast<UINT8*>(_storage), std::forward<Args>(args)...);
+        }
+
+        /** Destroys the stored callable, if any. */
+        void Reset()
+        {
+            if (_manage != nullptr)
+                _manage(_storage, nullptr);
+
+            _invoke = nullptr;
+            _manage = nullptr;
+        }
+
+        explicit operator bool() const { return _invoke != nullptr; }
+        bool operator== (std::nullptr_t) const { return _invoke == nullptr; }
+        bool operator!= (std::nullptr_t) const { return _invoke != nullptr; }
+
+    private:
+        typedef ReturnType(*InvokeFunc)(void*, Args&&...);
+
+        /** Moves the callable stored in @p src to @p dst and destroys it, or only destroys it if @p dst is null. */
+        typedef void(*ManageFunc)(void* src, void* dst);
+
+        template <class F>
+        static constexpr bool IsStoredInline()
+        {
+            return sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+                std::is_nothrow_move_constructible<F>::value;
+        }
+
+        template <class F>
+        static F* GetCallable(void* storage)
+        {
+            if constexpr (IsStoredInline<F>())
+                return static_cast<F*>(storage);
+            else
+                return *static_cast<F**>(storage);
+        }
+
+        template <class F>
+        void Assign(F&& function)
+        {
+            typedef std::decay_t<F> Callable;
+
+            // Null function pointers and empty std::function are stored as an empty InplaceFunction
+            if constexpr (std::is_constructible<bool, const Callable&>::value)
+            {
+                if (!static_cast<bool>(function))
+                    return;
+            }
+
+            if constexpr (IsStoredInline<Callable>())
+                new (_storage) Callable(std::forward<F>(function));
+            else
+                *reinterpret_cast<Callable**>(_storage) = te_new<Callable>(std::forward<F>(function));
+
+            _invoke = [](void* storage, Args&&... args) -> ReturnType
+            {
+                if constexpr (std::is_void<ReturnType>::value)
+                    std::invoke(*GetCallable<Callable>(storage), std::forward<Args>(args)...);
+                else
+                    return std::invoke(*GetCallable<Callable>(storage), std::forward<Args>(args)...);
+            };
+
+            _manage = [](void* src, void* dst)
+            {
+                if constexpr (IsStoredInline<Callable>())
+                {
+                    Callable* callable = static_cast<Callable*>(src);
+                    if (dst != nullptr)
+                        new (dst) Callable(std::move(*callable));
+
+                    callable->~Callable();
+                }
+                else
+                {
+                    // Heap allocated callables only need their pointer to be moved
+                    if (dst != nullptr)
+                        *static_cast<Callable**>(dst) = *static_cast<Callable**>(src);
+                    else
+                        te_delete(*static_cast<Callable**>(src));
+                }
+            };
+        }
+
+        void MoveFrom(InplaceFunction& other)
+        {
+            if (other._manage != nullptr)
+                other._manage(other._storage, _storage);
+
+            _invoke = other._invoke;
+            _manage = other._manage;
+
+            other._invoke = nullptr;
+            other._manage = nullptr;
+        }
+
+    private:
+        alignas(std::max_align_t) UINT8 _storage[Capacity];
+        InvokeFunc _invoke = nullptr;
+        ManageFunc _manage = nullptr;
+    };
+}
@@ -232,6 +232,142 @@ namespace te
         UINT32 _numBlocks = 0;
     };
 
+    /**
+     * A memory allocator that allocates elements of the same size, like PoolAllocator, but keeps all freed elements in a
+     * single free list. Allocations and deallocations don't depend on the number of live elements, at the cost of never
+     * returning memory to the heap before the allocator is destroyed.
+     *
+     * @tparam	ElemSize		Size of a single element in the pool. Elements are at least as large as a pointer.
+     * @tparam	ElemsPerBlock	Number of elements the pool is expanded by every time it runs out of free elements.
+     * @tparam	Alignment		Memory alignment of each allocated element.
+     * @tparam	Lock			If true the pool allocator will be made thread safe (at the cost of performance).
+     */
+    template <int ElemSize, int ElemsPerBlock = 512, int Alignment = 4, bool Lock = false>
+    class FreeListPoolAllocator
+    {
+    private:
+        /** Header of a block of ElemsPerBlock elements. Blocks are linked together so they can be freed. */
+        struct MemBlock
+        {
+            MemBlock* NextBlock;
+        };
+
+        /** Freed element, linked to the next freed element. */
+        struct FreeElement
+        {
+            FreeElement* Next;
+        };
+
+    public:
+        FreeListPoolAllocator()
+        {
+            static_assert(ElemsPerBlock > 0, "Number of elements per block must be at least 1.");
+            static_assert(ElemsPerBlock * ActualElemSize <= UINT_MAX, "Pool allocator block size too large.");
+        }
+
+        ~FreeListPoolAllocator()
+        {
+            ScopedLock<Lock> lock(_lockPolicy);
+
+#if TE_DEBUG_MODE == 1
+            assert(_totalNumElems == 0 && "Not all elements were deallocated from the pool.");
+#endif
+
+            while (_blocks != nullptr)
+            {
+                MemBlock* nextBlock = _blocks->NextBlock;
+                te_free(_blocks);
+
+                _blocks = nextBlock;
+            }
+        }
+
+        /** Allocates enough memory for a single element in the pool. */
+        UINT8* Allocate()
+        {
+            ScopedLock<Lock> lock(_lockPolicy);
+
+            _totalNumElems++;
+
+            if (_freeElems != nullptr)
+            {
+                FreeElement* element = _freeElems;
+                _freeElems = element->Next;
+
+                return (UINT8*)element;
+            }
+
+            if (_numUnusedElems == 0)
+                AllocateBlock();
+
+            UINT8* output = _unusedElems;
+            _unusedElems += ActualElemSize;
+            _numUnusedElems--;
+
+            return output;
+        }
+
+        /** Deallocates an element from the pool. */
+        void Free(void* data)
+        {
+            ScopedLock<Lock> lock(_lockPolicy);
+
+            FreeElement* element = (FreeElement*)data;
+            element->Next = _freeElems;
+            _freeElems = element;
+
+            _totalNumElems--;
+        }
+
+        /** Allocates and constructs a single pool element. */
+        template<class T, class... Args>
+        T* Construct(Args &&...args)
+        {
+            T* data = (T*)Allocate();
+            new ((void*)data) T(std::forward<Args>(args)...);
+
+            return data;
+        }
+
+        /** Destructs and deallocates a single pool element. */
+        template<class T>
+        void Destruct(T* data)
+        {
+            data->~T();
+            Free(data);
+        }
+
+    private:
+        /** Allocates a new block of memory using a heap allocator, and makes its elements available. */
+        void AllocateBlock()
+        {
+            constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
+            size_t paddedBlockDataSize = blockDataSize + (Alignment - 1); // Padding for potential alignment correction
+
+            UINT8* data = (UINT8*)te_allocate(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
+
+            void* blockData = data + sizeof(MemBlock);
+            blockData = std::align(Alignment, blockDataSize, blockData, paddedBlockDataSize);
+
+            MemBlock* block = (MemBlock*)data;
+            block->NextBlock = _blocks;
+            _blocks = block;
+
+            _unusedElems = (UINT8*)blockData;
+            _numUnusedElems = ElemsPerBlock;
+        }
+
+        static constexpr int MinElemSize = ElemSize > (int)sizeof(FreeElement) ? ElemSize : (int)sizeof(FreeElement);
+        static constexpr int ActualElemSize = ((MinElemSize + Alignment - 1) / Alignment) * Alignment;
+
+        LockingPolicy<Lock> _lockPolicy;
+        MemBlock* _blocks = nullptr;
+        FreeElement* _freeElems = nullptr;
+        UINT8* _unusedElems = nullptr;
+        UINT32 _numUnusedElems = 0;
+        UINT32 _totalNumElems = 0;
+    };
+
     /**
      * Helper class used by GlobalPoolAlloc that allocates a static pool allocator. GlobalPoolAlloc cannot do it
      * directly since it gets specialized which means the static members would need to be defined in the implementation
@@ -247,6 +383,18 @@ namespace te
     template <class T, int ElemsPerBlock, int Alignment, bool Lock>
     PoolAllocator<sizeof(T), ElemsPerBlock, Alignment, Lock> StaticPoolAllocator<T, ElemsPerBlock, Alignment, Lock>::m;
 
+    /** Helper class that allocates a static FreeListPoolAllocator for elements of type T. */
+    template <class T, int ElemsPerBlock = 512, int Alignment = 4, bool Lock = true>
+    class StaticFreeListPoolAllocator
+    {
+    public:
+        static FreeListPoolAllocator<sizeof(T), ElemsPerBlock, Alignment, Lock> m;
+    };
+
+    template <class T, int ElemsPerBlock, int Alignment, bool Lock>
+    FreeListPoolAllocator<sizeof(T), ElemsPerBlock, Alignment, Lock>
+        StaticFreeListPoolAllocator<T, ElemsPerBlock, Alignment, Lock>::m;
+
     /** Specializable template that allows users to implement globally accessible pool allocators for custom types. */
     template<class T>
     class GlobalPoolAllocator : std::false_type
@@ -295,4 +443,49 @@ namespace te
         ptr->~T();
         te_pool_free(ptr);
     }
+
+    /**
+     * Allocator for the standard library taking single elements from a global FreeListPoolAllocator of elements of type
+     * T. Allocations of several elements at once use the heap. Can be used with std::allocate_shared() so an object and
+     * its shared pointer data come from the pool together.
+     */
+    template<class T, int ElemsPerBlock = 512, int Alignment = 16>
+    class StdPoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        typedef StaticFreeListPoolAllocator<T, ElemsPerBlock, Alignment> Pool;
+
+        static_assert(alignof(T) <= Alignment, "Type requires a larger alignment than the one of the pool.");
+
+        template<class U> struct rebind { typedef StdPoolAllocator<U, ElemsPerBlock, Alignment> other; };
+
+        constexpr StdPoolAllocator() = default;
+        template<class U> constexpr StdPoolAllocator(const StdPoolAllocator<U, ElemsPerBlock, Alignment>&) { }
+
+        template<class U>
+        constexpr bool operator==(const StdPoolAllocator<U, ElemsPerBlock, Alignment>&) const noexcept { return true; }
+
+        template<class U>
+        constexpr bool operator!=(const StdPoolAllocator<U, ElemsPerBlock, Alignment>&) const noexcept { return false; }
+
+        /** Allocates but doesn't initialize @p num elements. */
+        T* allocate(const size_t num)
+        {
+            if (num == 1)
+                return (T*)Pool::m.Allocate();
+
+            return te_allocate<T>((uint32_t)(num * sizeof(T)));
+        }
+
+        /** Deallocates elements allocated by allocate(). */
+        void deallocate(T* ptr, const size_t num)
+        {
+            if (num == 1)
+                Pool::m.Free(ptr);
+            else
+                te_deallocate(ptr);
+        }
+    };
 }
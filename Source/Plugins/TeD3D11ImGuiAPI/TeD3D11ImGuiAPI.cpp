@@ -1,6 +1,7 @@
 #include "TeD3D11ImGuiAPI.h"
 #include "TeCoreApplication.h"
 #include "Platform/TePlatform.h"
+#include "RenderAPI/TeRenderAPI.h"
 
 namespace te
 {
@@ -91,6 +92,9 @@ namespace te
                 ImGui::UpdatePlatformWindows();
                 ImGui::RenderPlatformWindowsDefault();
             }
+
+            // ImGui binds its states directly through the device context
+            RenderAPI::Instance().InvalidateStateCache();
         }
 
         _guiStarted = false;
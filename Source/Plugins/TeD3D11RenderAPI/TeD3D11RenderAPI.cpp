@@ -188,6 +188,9 @@ namespace te
 
     void D3D11RenderAPI::SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
     {
+        if (!_stateCache.SetGraphicsPipeline(pipelineState))
+            return;
+
         D3D11RasterizerState* d3d11RasterizerState = nullptr;
         D3D11BlendState* d3d11BlendState = nullptr;
 
@@ -297,6 +300,9 @@ namespace te
 
     void D3D11RenderAPI::SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
     {
+        if (!_stateCache.SetComputePipeline(pipelineState))
+            return;
+
         SPtr<GpuProgram> program;
         D3D11GpuComputeProgram* d3d11ComputeProgram = nullptr;
 
@@ -533,6 +539,24 @@ namespace te
         UINT32 slotConstBuffers = 0;
         UINT32 numSamplers = 0;
 
+        // Only the sub-range of slots which differs from what is currently bound reaches the device
+        UINT32 first = 0;
+        UINT32 count = 0;
+        bool anythingBound = false;
+
+        auto FilterSlots = [&](GpuProgramType type, RenderAPIStateCache::SlotType slotType, UINT32 startSlot, auto& handles)
+        {
+            bool mustBind = _stateCache.SetSlots(type, slotType, startSlot,
+                reinterpret_cast<void* const*>(handles.data()), (UINT32)handles.size(), first, count);
+
+            anythingBound |= mustBind;
+            return mustBind;
+        };
+
+        const RenderAPIStateCache::SlotType srvSlot = RenderAPIStateCache::SlotType::Texture;
+        const RenderAPIStateCache::SlotType constBufferSlot = RenderAPIStateCache::SlotType::ParamBlock;
+        const RenderAPIStateCache::SlotType samplerSlot = RenderAPIStateCache::SlotType::Sampler;
+
         // NOTE : if constant buffer are not consecutive, we might bind them in several calls
 
         if (_lastFrameGraphicPipeline->d3d11VertexProgram)
@@ -542,9 +566,14 @@ namespace te
             numConstBuffers = (UINT32)_gpuResContainer.constBuffers.size();
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
-            if (numSRVs > 0) context->VSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->VSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
-            if (numSamplers > 0) context->VSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
+            if (numSRVs > 0 && FilterSlots(GPT_VERTEX_PROGRAM, srvSlot, 0, _gpuResContainer.srvs))
+                context->VSSetShaderResources(first, count, &_gpuResContainer.srvs[first]);
+
+            if (numConstBuffers > 0 && FilterSlots(GPT_VERTEX_PROGRAM, constBufferSlot, slotConstBuffers, _gpuResContainer.constBuffers))
+                context->VSSetConstantBuffers(first, count, &_gpuResContainer.constBuffers[first - slotConstBuffers]);
+
+            if (numSamplers > 0 && FilterSlots(GPT_VERTEX_PROGRAM, samplerSlot, 0, _gpuResContainer.samplers))
+                context->VSSetSamplers(first, count, &_gpuResContainer.samplers[first]);
         }
 
         if (_lastFrameGraphicPipeline->d3d11PixelProgram)
@@ -555,18 +584,22 @@ namespace te
             numConstBuffers = (UINT32)_gpuResContainer.constBuffers.size();
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
-            if (numSRVs > 0) 
-                context->PSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
+            if (numSRVs > 0 && FilterSlots(GPT_PIXEL_PROGRAM, srvSlot, 0, _gpuResContainer.srvs))
+                context->PSSetShaderResources(first, count, &_gpuResContainer.srvs[first]);
 
             if (numUAVs > 0)
             {
                 context->OMSetRenderTargetsAndUnorderedAccessViews(
                     D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr, 0, numUAVs, _gpuResContainer.uavs.data(), nullptr);
                 _PSUAVsBound = true;
+                anythingBound = true;
             }
 
-            if (numConstBuffers > 0) context->PSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
-            if (numSamplers > 0) context->PSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
+            if (numConstBuffers > 0 && FilterSlots(GPT_PIXEL_PROGRAM, constBufferSlot, slotConstBuffers, _gpuResContainer.constBuffers))
+                context->PSSetConstantBuffers(first, count, &_gpuResContainer.constBuffers[first - slotConstBuffers]);
+
+            if (numSamplers > 0 && FilterSlots(GPT_PIXEL_PROGRAM, samplerSlot, 0, _gpuResContainer.samplers))
+                context->PSSetSamplers(first, count, &_gpuResContainer.samplers[first]);
         }
 
         if (_lastFrameGraphicPipeline->d3d11GeometryProgram)
@@ -576,9 +609,14 @@ namespace te
             numConstBuffers = (UINT32)_gpuResContainer.constBuffers.size();
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
-            if (numSRVs > 0) context->GSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->GSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
-            if (numSamplers > 0) context->GSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
+            if (numSRVs > 0 && FilterSlots(GPT_GEOMETRY_PROGRAM, srvSlot, 0, _gpuResContainer.srvs))
+                context->GSSetShaderResources(first, count, &_gpuResContainer.srvs[first]);
+
+            if (numConstBuffers > 0 && FilterSlots(GPT_GEOMETRY_PROGRAM, constBufferSlot, slotConstBuffers, _gpuResContainer.constBuffers))
+                context->GSSetConstantBuffers(first, count, &_gpuResContainer.constBuffers[first - slotConstBuffers]);
+
+            if (numSamplers > 0 && FilterSlots(GPT_GEOMETRY_PROGRAM, samplerSlot, 0, _gpuResContainer.samplers))
+                context->GSSetSamplers(first, count, &_gpuResContainer.samplers[first]);
         }
 
         if (_lastFrameGraphicPipeline->d3d11HullProgram)
@@ -588,9 +626,14 @@ namespace te
             numConstBuffers = (UINT32)_gpuResContainer.constBuffers.size();
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
-            if (numSRVs > 0) context->HSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->HSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
-            if (numSamplers > 0) context->HSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
+            if (numSRVs > 0 && FilterSlots(GPT_HULL_PROGRAM, srvSlot, 0, _gpuResContainer.srvs))
+                context->HSSetShaderResources(first, count, &_gpuResContainer.srvs[first]);
+
+            if (numConstBuffers > 0 && FilterSlots(GPT_HULL_PROGRAM, constBufferSlot, slotConstBuffers, _gpuResContainer.constBuffers))
+                context->HSSetConstantBuffers(first, count, &_gpuResContainer.constBuffers[first - slotConstBuffers]);
+
+            if (numSamplers > 0 && FilterSlots(GPT_HULL_PROGRAM, samplerSlot, 0, _gpuResContainer.samplers))
+                context->HSSetSamplers(first, count, &_gpuResContainer.samplers[first]);
         }
 
         if (_lastFrameGraphicPipeline->d3d11DomainProgram)
@@ -600,9 +643,14 @@ namespace te
             numConstBuffers = (UINT32)_gpuResContainer.constBuffers.size();
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
-            if (numSRVs > 0) context->DSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->DSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
-            if (numSamplers > 0) context->DSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
+            if (numSRVs > 0 && FilterSlots(GPT_DOMAIN_PROGRAM, srvSlot, 0, _gpuResContainer.srvs))
+                context->DSSetShaderResources(first, count, &_gpuResContainer.srvs[first]);
+
+            if (numConstBuffers > 0 && FilterSlots(GPT_DOMAIN_PROGRAM, constBufferSlot, slotConstBuffers, _gpuResContainer.constBuffers))
+                context->DSSetConstantBuffers(first, count, &_gpuResContainer.constBuffers[first - slotConstBuffers]);
+
+            if (numSamplers > 0 && FilterSlots(GPT_DOMAIN_PROGRAM, samplerSlot, 0, _gpuResContainer.samplers))
+                context->DSSetSamplers(first, count, &_gpuResContainer.samplers[first]);
         }
 
         if (_lastFrameGraphicPipeline->d3d11ComputeProgram)
@@ -612,13 +660,24 @@ namespace te
             numConstBuffers = (UINT32)_gpuResContainer.constBuffers.size();
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
-            if (numSRVs > 0) context->CSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numUAVs > 0) context->CSSetUnorderedAccessViews(0, numUAVs, _gpuResContainer.uavs.data(), nullptr);
-            if (numConstBuffers > 0) context->CSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
-            if (numSamplers > 0) context->CSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
+            if (numSRVs > 0 && FilterSlots(GPT_COMPUTE_PROGRAM, srvSlot, 0, _gpuResContainer.srvs))
+                context->CSSetShaderResources(first, count, &_gpuResContainer.srvs[first]);
+
+            if (numUAVs > 0)
+            {
+                context->CSSetUnorderedAccessViews(0, numUAVs, _gpuResContainer.uavs.data(), nullptr);
+                anythingBound = true;
+            }
+
+            if (numConstBuffers > 0 && FilterSlots(GPT_COMPUTE_PROGRAM, constBufferSlot, slotConstBuffers, _gpuResContainer.constBuffers))
+                context->CSSetConstantBuffers(first, count, &_gpuResContainer.constBuffers[first - slotConstBuffers]);
+
+            if (numSamplers > 0 && FilterSlots(GPT_COMPUTE_PROGRAM, samplerSlot, 0, _gpuResContainer.samplers))
+                context->CSSetSamplers(first, count, &_gpuResContainer.samplers[first]);
         }
 
-        TE_INC_PROFILER_GPU(NumGpuParamBinds);
+        if (anythingBound)
+            TE_INC_PROFILER_GPU(NumGpuParamBinds);
     }
 
     void D3D11RenderAPI::SetViewport(const Rect2& area)
@@ -639,6 +698,9 @@ namespace te
 
     void D3D11RenderAPI::SetStencilRef(UINT32 value)
     {
+        if (!_stateCache.SetStencilRef(value))
+            return;
+
         _stencilRef = value;
 
         if(_activeDepthStencilState != nullptr)
@@ -656,6 +718,9 @@ namespace te
                 ". Valid range is 0 .. " + ToString(maxBoundVertexBuffers - 1));
         }
 
+        if (!_stateCache.SetVertexBuffers(index, buffers, numBuffers))
+            return;
+
         ID3D11Buffer* dx11buffers[D3D11_MAX_BOUND_VERTEX_BUFFER];
         UINT32 strides[D3D11_MAX_BOUND_VERTEX_BUFFER];
         UINT32 offsets[D3D11_MAX_BOUND_VERTEX_BUFFER];
@@ -671,21 +736,16 @@ namespace te
             offsets[i] = 0;
         }
 
-        if (!_lastFrameGraphicPipeline || _lastFrameGraphicPipeline->vertexBuffer != dx11buffers[0])
-        {
-            _device->GetImmediateContext()->IASetVertexBuffers(index, numBuffers, dx11buffers, strides, offsets);
-
-            if (!_lastFrameGraphicPipeline)
-                _lastFrameGraphicPipeline = te_shared_ptr_new<LastFrameGraphicPipeline>();
-
-            _lastFrameGraphicPipeline->vertexBuffer = dx11buffers[0];
-        }
+        _device->GetImmediateContext()->IASetVertexBuffers(index, numBuffers, dx11buffers, strides, offsets);
 
         TE_INC_PROFILER_GPU(NumVertexBufferBinds);
     }
 
     void D3D11RenderAPI::SetIndexBuffer(const SPtr<IndexBuffer>& buffer)
     {
+        if (!_stateCache.SetIndexBuffer(buffer))
+            return;
+
         SPtr<D3D11IndexBuffer> indexBuffer = std::static_pointer_cast<D3D11IndexBuffer>(buffer);
 
         DXGI_FORMAT indexFormat = DXGI_FORMAT_R16_UINT;
@@ -785,6 +845,9 @@ namespace te
         _activeRenderTarget = target;
         _activeRenderTargetModified = false;
 
+        // D3D11 silently unbinds shader resources which are now bound as outputs
+        _stateCache.InvalidateSlots(RenderAPIStateCache::SlotType::Texture);
+
         UINT32 maxRenderTargets = D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT;
         memset(_activeViews, 0, sizeof(ID3D11RenderTargetView*) * maxRenderTargets);
 
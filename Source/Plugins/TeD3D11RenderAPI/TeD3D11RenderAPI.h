@@ -33,8 +33,6 @@ namespace te
             DrawOperationType drawOperationType = DOT_TRIANGLE_LIST;
 
             ID3D11InputLayout* ia = nullptr;
-
-            ID3D11Buffer* vertexBuffer = nullptr;
         };
 
         struct GpuResourcesContainer {
@@ -2,6 +2,8 @@
 #include "Importer/TeMeshImportOptions.h"
 #include "Mesh/TeMesh.h"
 #include "Mesh/TeMeshData.h"
+#include "Mesh/TeMeshUtility.h"
+#include "RenderAPI/TeVertexDataDesc.h"
 #include "Image/TeColor.h"
 #include "Animation/TeSkeleton.h"
 #include "Animation/TeAnimationUtility.h"
@@ -54,7 +56,7 @@ namespace te
         if (rendererMeshData)
         {
             auto path = std::filesystem::absolute(filePath);
-            SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->GetData(), desc);
+            SPtr<Mesh> mesh = Mesh::_createPtr(GenerateLODs(rendererMeshData->GetData(), *meshImportOptions, desc), desc);
             mesh->SetName(path.filename().generic_string());
             mesh->SetPath(path.generic_string());
 
@@ -79,7 +81,7 @@ namespace te
         if (rendererMeshData)
         {
             auto path = std::filesystem::absolute(filePath);
-            SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->GetData(), desc);
+            SPtr<Mesh> mesh = Mesh::_createPtr(GenerateLODs(rendererMeshData->GetData(), *meshImportOptions, desc), desc);
             mesh->SetName(path.filename().generic_string());
             mesh->SetPath(path.generic_string());
 
@@ -1314,6 +1316,88 @@ namespace te
         return Quaternion((float)quaternion.w, (float)quaternion.x, (float)quaternion.y, (float)quaternion.z);
     }
 
+    SPtr<MeshData> ObjectImporter::GenerateLODs(const SPtr<MeshData>& meshData, const MeshImportOptions& options, MESH_DESC& desc)
+    {
+        if (options.NumLODs == 0 || desc.SubMeshes.empty() || !meshData->GetVertexDesc()->HasElement(VES_POSITION))
+            return meshData;
+
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const UINT32 vertexStride = meshData->GetVertexDesc()->GetVertexStride(0);
+        const Vector3* positions = (const Vector3*)meshData->GetElementData(VES_POSITION);
+
+        Vector<UINT32> lodIndices;
+        Vector<UINT32> sourceIndices;
+        Vector<UINT32> simplifiedIndices;
+        UINT32 numLODs = 0;
+
+        for (auto& subMesh : desc.SubMeshes)
+        {
+            subMesh.LODs.clear();
+
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST)
+                continue;
+
+            // Each level of detail is simplified from the previous one, so the chain stays coherent
+            const UINT8* indices = meshData->GetIndexData() + subMesh.IndexOffset * meshData->GetIndexElementSize();
+            UINT32 indexSize = meshData->GetIndexElementSize();
+            UINT32 numIndices = subMesh.IndexCount;
+
+            for (UINT32 i = 0; i < options.NumLODs; i++)
+            {
+                UINT32 targetNumIndices = (UINT32)(numIndices * options.LODReductionRatio) / 3 * 3;
+                MeshUtility::Simplify(positions, numVertices, indices, numIndices, targetNumIndices, simplifiedIndices,
+                    indexSize, vertexStride);
+
+                // Simplification is stuck, next levels of detail would be identical
+                if (simplifiedIndices.empty() || (UINT32)simplifiedIndices.size() >= numIndices)
+                    break;
+
+                UINT32 indexOffset = meshData->GetNumIndices() + (UINT32)lodIndices.size();
+                subMesh.LODs.push_back(SubMeshLOD(indexOffset, (UINT32)simplifiedIndices.size()));
+                lodIndices.insert(lodIndices.end(), simplifiedIndices.begin(), simplifiedIndices.end());
+
+                sourceIndices.swap(simplifiedIndices);
+                indices = (const UINT8*)sourceIndices.data();
+                indexSize = sizeof(UINT32);
+                numIndices = (UINT32)sourceIndices.size();
+            }
+
+            numLODs = std::max(numLODs, (UINT32)subMesh.LODs.size());
+        }
+
+        if (numLODs == 0)
+            return meshData;
+
+        desc.LODScreenSizes.clear();
+        float screenSize = options.LODScreenSize;
+        for (UINT32 i = 0; i < numLODs; i++)
+        {
+            desc.LODScreenSizes.push_back(screenSize);
+            screenSize *= 0.5f;
+        }
+
+        // Simplified indices are stored after the original ones, vertices are shared by all levels of detail
+        const UINT32 numOriginalIndices = meshData->GetNumIndices();
+        SPtr<MeshData> output = te_shared_ptr_new<MeshData>(numVertices, numOriginalIndices + (UINT32)lodIndices.size(),
+            meshData->GetVertexDesc(), meshData->GetIndexType());
+
+        memcpy(output->GetStreamData(0), meshData->GetStreamData(0), meshData->GetStreamSize());
+        memcpy(output->GetIndexData(), meshData->GetIndexData(), numOriginalIndices * meshData->GetIndexElementSize());
+
+        if (output->GetIndexType() == IT_32BIT)
+        {
+            memcpy(output->GetIndices32() + numOriginalIndices, lodIndices.data(), lodIndices.size() * sizeof(UINT32));
+        }
+        else
+        {
+            UINT16* dest = output->GetIndices16() + numOriginalIndices;
+            for (size_t i = 0; i < lodIndices.size(); i++)
+                dest[i] = (UINT16)lodIndices[i];
+        }
+
+        return output;
+    }
+
     void ObjectImporter::SetMeshImportOptions(const String& filePath, MeshImportOptions& meshImportOptions)
     {
         String extension = Util::GetFileExtension(filePath);
@@ -80,6 +80,13 @@ namespace te
         /** Converts the mesh data from the imported assimp scene into mesh data that can be used for initializing a mesh. */
         SPtr<RendererMeshData> GenerateMeshData(AssimpImportScene& scene, AssimpImportOptions& options, Vector<SubMesh>& subMeshes);
 
+        /**
+         * Simplifies every triangle list sub-mesh of @p meshData according to the LOD settings in @p options. Simplified
+         * indices are appended after the original ones and referenced by SubMesh::LODs of the sub-meshes in @p desc.
+         * Returns @p meshData itself if no level of detail is generated.
+         */
+        SPtr<MeshData> GenerateLODs(const SPtr<MeshData>& meshData, const MeshImportOptions& options, MESH_DESC& desc);
+
         /**	Creates an internal representation of an assimp node from an aiNode object. */
         AssimpImportNode* CreateImportNode(const AssimpImportOptions& options, AssimpImportScene& scene, aiNode* assimpNode, AssimpImportNode* parent);
 
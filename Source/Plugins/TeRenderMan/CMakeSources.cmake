@@ -8,6 +8,9 @@ set (TE_RENDERMAN_INC_NOFILTER
     "TeRendererRenderable.h"
     "TeRendererLight.h"
     "TeRenderCompositor.h"
+    "TeShadowCascades.h"
+    "TeEnvironmentProbes.h"
+    "TeInstanceDataBuffer.h"
 )
 
 set (TE_RENDERERMAN_SRC_NOFILTER
@@ -19,6 +22,9 @@ set (TE_RENDERERMAN_SRC_NOFILTER
     "TeRendererRenderable.cpp"
     "TeRendererLight.cpp"
     "TeRenderCompositor.cpp"
+    "TeShadowCascades.cpp"
+    "TeEnvironmentProbes.cpp"
+    "TeInstanceDataBuffer.cpp"
 )
 
 source_group ("" FILES ${TE_RENDERERMAN_SRC_NOFILTER} ${TE_RENDERMAN_INC_NOFILTER})
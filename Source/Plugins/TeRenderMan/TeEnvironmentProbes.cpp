@@ -0,0 +1,351 @@
+#include "TeEnvironmentProbes.h"
+#include "TeRendererView.h"
+#include "TeRendererScene.h"
+#include "TeRendererRenderable.h"
+#include "TeRenderManOptions.h"
+#include "Renderer/TeRenderable.h"
+#include "Renderer/TeRenderSettings.h"
+#include "Renderer/TeSkybox.h"
+#include "Renderer/TeGpuResourcePool.h"
+#include "RenderAPI/TeRenderAPI.h"
+#include "RenderAPI/TeRenderTexture.h"
+#include "RenderAPI/TeGpuParams.h"
+#include "Material/TeMaterial.h"
+#include "Math/TeQuaternion.h"
+
+namespace te
+{
+    /** Number of frames a probe is kept once no view requires it anymore. */
+    static const UINT64 ENV_PROBE_MAX_UNUSED_FRAMES = 120;
+
+    /** Near plane distance of the views rendering probe faces. */
+    static const float ENV_PROBE_NEAR_PLANE = 0.05f;
+
+    /**
+     * Forward and up directions of each cube map face, in the +X, -X, +Y, -Y, +Z, -Z order. Faces are rendered upside
+     * down and flipped when resolved (see RendererViewData::FlipView), so that cube map texture coordinates match.
+     */
+    static const Vector3 ENV_PROBE_FACE_DIRECTIONS[EnvironmentProbe::NUM_FACES][2] =
+    {
+        { Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f) },
+        { Vector3(-1.0f, 0.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f) },
+        { Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f) },
+        { Vector3(0.0f, -1.0f, 0.0f), Vector3(0.0f, 0.0f, -1.0f) },
+        { Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, -1.0f, 0.0f) },
+        { Vector3(0.0f, 0.0f, -1.0f), Vector3(0.0f, -1.0f, 0.0f) }
+    };
+
+    /** Returns the distance up to which renderables are drawn in probes, and can require them to be updated. */
+    static float GetProbeRange(const RendererViewProperties& viewProps, const RenderManOptions& options)
+    {
+        if (options.DynamicEnvMapRadius <= 0.0f)
+            return viewProps.FarPlane;
+
+        return std::min(options.DynamicEnvMapRadius, viewProps.FarPlane);
+    }
+
+    void EnvironmentProbes::Update(const SceneInfo& sceneInfo, const RendererView& view, const VisibilityInfo& visibility,
+        const RenderManOptions& options, UINT64 frameIdx)
+    {
+        _facesToRender.clear();
+
+        if (frameIdx != _currentFrameIdx)
+        {
+            _currentFrameIdx = frameIdx;
+            _numFacesThisFrame = 0;
+
+            ReleaseUnusedProbes(frameIdx);
+        }
+
+        const RendererViewProperties& viewProps = view.GetProperties();
+        const RenderSettings& settings = view.GetRenderSettings();
+        const float range = GetProbeRange(viewProps, options);
+        const UINT32 size = std::max(options.DynamicEnvMapSize, 1U);
+
+        // Renderables drawn in probes
+        _contributors.clear();
+        for (UINT32 i = 0; i < (UINT32)sceneInfo.Renderables.size(); i++)
+        {
+            if ((sceneInfo.RenderableCullInfos[i].Layer & viewProps.VisibleLayers) == 0)
+                continue;
+
+            if (sceneInfo.Renderables[i]->RenderablePtr->GetUseForDynamicEnvMapping())
+                _contributors.push_back(i);
+        }
+
+        SPtr<Texture> fallback;
+        if (settings.EnableSkybox && sceneInfo.SkyboxElem)
+            fallback = sceneInfo.SkyboxElem->GetTexture();
+
+        // Find probes required by renderables visible in this view
+        const UINT32 numVisible = std::min((UINT32)visibility.Renderables.size(), (UINT32)sceneInfo.Renderables.size());
+        for (UINT32 i = 0; i < numVisible; i++)
+        {
+            if (!visibility.Renderables[i].Visible)
+                continue;
+
+            RendererRenderable& renderable = *sceneInfo.Renderables[i];
+            if (!UsesDynamicEnvMap(renderable))
+                continue;
+
+            EnvironmentProbe& probe = FindOrCreateProbe(renderable.RenderablePtr, size);
+            probe.LastUsedFrame = frameIdx;
+            probe.Position = sceneInfo.RenderableCullInfos[i].Boundaries.GetSphere().GetCenter();
+
+            UINT64 hash = GetSurroundingsHash(sceneInfo, probe, range);
+            if (hash != probe.SurroundingsHash)
+            {
+                probe.SurroundingsHash = hash;
+                probe.DirtyFaces = EnvironmentProbe::ALL_FACES;
+            }
+
+            BindProbe(renderable, probe, fallback);
+        }
+
+        // Sort probes waiting for an update by priority
+        _candidates.clear();
+        for (UINT32 i = 0; i < (UINT32)_probes.size(); i++)
+        {
+            EnvironmentProbe& probe = _probes[i];
+            if (probe.DirtyFaces == 0 || probe.LastUsedFrame != frameIdx)
+                continue;
+
+            const float priority = viewProps.ViewOrigin.Distance(probe.Position) / (float)(1 + probe.FramesWaiting);
+            _candidates.push_back({ probe.Complete, priority, i });
+        }
+
+        // Incomplete probes always come first, they can't be sampled yet. Each group is sorted by priority.
+        std::sort(_candidates.begin(), _candidates.end(),
+            [](const UpdateCandidate& a, const UpdateCandidate& b)
+            {
+                if (a.Complete != b.Complete)
+                    return !a.Complete;
+
+                return a.Priority < b.Priority;
+            });
+
+        // Spend the face budget left for this frame
+        for (auto& candidate : _candidates)
+        {
+            EnvironmentProbe& probe = _probes[candidate.ProbeIdx];
+
+            bool scheduled = false;
+            for (UINT32 face = 0; face < EnvironmentProbe::NUM_FACES; face++)
+            {
+                if (_numFacesThisFrame >= options.DynamicEnvMapFacesPerFrame)
+                    break;
+
+                if ((probe.DirtyFaces & (1 << face)) == 0)
+                    continue;
+
+                _facesToRender.push_back({ candidate.ProbeIdx, face });
+                _numFacesThisFrame++;
+                scheduled = true;
+            }
+
+            if (scheduled)
+                probe.FramesWaiting = 0;
+            else
+                probe.FramesWaiting++;
+        }
+    }
+
+    void EnvironmentProbes::GetFaceViewDesc(const RendererView& view, const EnvironmentProbeFace& face,
+        const RenderManOptions& options, RENDERER_VIEW_DESC& desc) const
+    {
+        const EnvironmentProbe& probe = _probes[face.ProbeIdx];
+        const RendererViewProperties& viewProps = view.GetProperties();
+        const UINT32 size = probe.Texture->Tex->GetProperties().GetWidth();
+
+        const Vector3& forward = ENV_PROBE_FACE_DIRECTIONS[face.Face][0];
+        const Vector3& up = ENV_PROBE_FACE_DIRECTIONS[face.Face][1];
+        const Quaternion rotation(forward.Cross(up), up, -forward);
+
+        const float farPlane = std::max(GetProbeRange(viewProps, options), ENV_PROBE_NEAR_PLANE * 2.0f);
+        const Matrix4 proj = Matrix4::ProjectionPerspective(Degree(90.0f), 1.0f, ENV_PROBE_NEAR_PLANE, farPlane);
+
+        Matrix4 worldMatrix;
+        worldMatrix.SetTRS(probe.Position, rotation, Vector3::ONE);
+
+        Vector<Plane> planes = ConvexVolume(proj).GetPlanes();
+        for (auto& plane : planes)
+            plane = worldMatrix.MultiplyAffine(plane);
+
+        desc.Target.Target = probe.FaceTargets[face.Face];
+        desc.Target.ViewRect = Rect2I(0, 0, size, size);
+        desc.Target.NrmViewRect = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+        desc.Target.TargetWidth = size;
+        desc.Target.TargetHeight = size;
+        desc.Target.NumSamples = 1;
+        desc.Target.ClearFlags = viewProps.Target.ClearFlags;
+        desc.Target.ClearColor = viewProps.Target.ClearColor;
+        desc.Target.ClearDepthValue = viewProps.Target.ClearDepthValue;
+        desc.Target.ClearStencilValue = viewProps.Target.ClearStencilValue;
+
+        desc.MainView = false;
+        desc.OnDemand = false;
+        desc.RunPostProcessing = false;
+        desc.DynamicEnvMappingOnly = true;
+        desc.ExcludedRenderable = probe.Owner;
+
+        desc.CullFrustum = ConvexVolume(planes);
+        desc.VisibleLayers = viewProps.VisibleLayers;
+        desc.NearPlane = ENV_PROBE_NEAR_PLANE;
+        desc.FarPlane = farPlane;
+        desc.FlipView = true;
+
+        desc.ViewOrigin = probe.Position;
+        desc.ViewDirection = forward;
+        desc.ViewTransform = Matrix4::View(probe.Position, rotation);
+        desc.ProjType = PT_PERSPECTIVE;
+        RenderAPI::Instance().ConvertProjectionMatrix(proj, desc.ProjTransform);
+
+        desc.ReductionMode = options.ReductionMode;
+        desc.SceneCamera = nullptr;
+    }
+
+    void EnvironmentProbes::NotifyFaceRendered(const EnvironmentProbeFace& face)
+    {
+        EnvironmentProbe& probe = _probes[face.ProbeIdx];
+        probe.DirtyFaces &= ~(1 << face.Face);
+
+        if (probe.DirtyFaces == 0)
+            probe.Complete = true;
+    }
+
+    void EnvironmentProbes::NotifyRenderableRemoved(Renderable* renderable)
+    {
+        auto iterFind = _probeLookup.find(renderable);
+        if (iterFind == _probeLookup.end())
+            return;
+
+        UINT32 idx = iterFind->second;
+        _probeLookup.erase(iterFind);
+
+        if (idx != (UINT32)_probes.size() - 1)
+        {
+            _probes[idx] = std::move(_probes.back());
+            _probeLookup[_probes[idx].Owner] = idx;
+        }
+
+        _probes.pop_back();
+    }
+
+    void EnvironmentProbes::Clear()
+    {
+        _probes.clear();
+        _probeLookup.clear();
+        _facesToRender.clear();
+    }
+
+    bool EnvironmentProbes::UsesDynamicEnvMap(const RendererRenderable& renderable)
+    {
+        for (auto& element : renderable.Elements)
+        {
+            if (element.MaterialElem && element.MaterialElem->GetProperties().UseDynamicEnvironmentMap)
+                return true;
+        }
+
+        return false;
+    }
+
+    EnvironmentProbe& EnvironmentProbes::FindOrCreateProbe(Renderable* renderable, UINT32 size)
+    {
+        auto iterFind = _probeLookup.find(renderable);
+        if (iterFind != _probeLookup.end())
+        {
+            EnvironmentProbe& probe = _probes[iterFind->second];
+            if (probe.Texture->Tex->GetProperties().GetWidth() != size)
+                CreateProbeTexture(probe, size);
+
+            return probe;
+        }
+
+        _probeLookup[renderable] = (UINT32)_probes.size();
+        _probes.push_back(EnvironmentProbe());
+
+        EnvironmentProbe& probe = _probes.back();
+        probe.Owner = renderable;
+        CreateProbeTexture(probe, size);
+
+        return probe;
+    }
+
+    void EnvironmentProbes::CreateProbeTexture(EnvironmentProbe& probe, UINT32 size)
+    {
+        probe.Texture = gGpuResourcePool().Get(POOLED_RENDER_TEXTURE_DESC::CreateCube(PF_RGBA16F, size, size,
+            TU_RENDERTARGET));
+
+        for (UINT32 face = 0; face < EnvironmentProbe::NUM_FACES; face++)
+        {
+            RENDER_TEXTURE_DESC desc;
+            desc.ColorSurfaces[0].Tex = probe.Texture->Tex;
+            desc.ColorSurfaces[0].Face = face;
+            desc.ColorSurfaces[0].NumFaces = 1;
+            desc.ColorSurfaces[0].MipLevel = 0;
+
+            probe.FaceTargets[face] = RenderTexture::Create(desc);
+        }
+
+        probe.DirtyFaces = EnvironmentProbe::ALL_FACES;
+        probe.Complete = false;
+    }
+
+    UINT64 EnvironmentProbes::GetSurroundingsHash(const SceneInfo& sceneInfo, const EnvironmentProbe& probe,
+        float range) const
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, probe.Position.x);
+        te_hash_combine(hash, probe.Position.y);
+        te_hash_combine(hash, probe.Position.z);
+        te_hash_combine(hash, sceneInfo.SkyboxElem);
+
+        for (auto& idx : _contributors)
+        {
+            if (sceneInfo.Renderables[idx]->RenderablePtr == probe.Owner)
+                continue;
+
+            // Only renderables close enough to be drawn in the probe are relevant
+            const Sphere& bounds = sceneInfo.RenderableCullInfos[idx].Boundaries.GetSphere();
+            const float maxDistance = range + bounds.GetRadius();
+            if (probe.Position.SquaredDistance(bounds.GetCenter()) > maxDistance * maxDistance)
+                continue;
+
+            te_hash_combine(hash, idx);
+            te_hash_combine(hash, bounds.GetCenter().x);
+            te_hash_combine(hash, bounds.GetCenter().y);
+            te_hash_combine(hash, bounds.GetCenter().z);
+            te_hash_combine(hash, bounds.GetRadius());
+        }
+
+        return (UINT64)hash;
+    }
+
+    void EnvironmentProbes::BindProbe(RendererRenderable& renderable, const EnvironmentProbe& probe,
+        const SPtr<Texture>& fallback) const
+    {
+        const SPtr<Texture>& texture = probe.Complete ? probe.Texture->Tex : fallback;
+
+        for (auto& element : renderable.Elements)
+        {
+            if (!element.MaterialElem || !element.MaterialElem->GetProperties().UseDynamicEnvironmentMap)
+                continue;
+
+            for (auto& gpuParams : element.GpuParamsElem)
+                gpuParams->SetTexture("EnvironmentMap", texture);
+
+            gPerMaterialParamDef.gUseEnvironmentMap.Set(element.PerMaterialParamBuffer, probe.Complete ? 1 : 0);
+        }
+    }
+
+    void EnvironmentProbes::ReleaseUnusedProbes(UINT64 frameIdx)
+    {
+        for (UINT32 i = 0; i < (UINT32)_probes.size();)
+        {
+            if (frameIdx - _probes[i].LastUsedFrame > ENV_PROBE_MAX_UNUSED_FRAMES)
+                NotifyRenderableRemoved(_probes[i].Owner);
+            else
+                i++;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    struct SceneInfo;
+    struct VisibilityInfo;
+    struct RENDERER_VIEW_DESC;
+    struct PooledRenderTexture;
+
+    /** Cube map rendered around a renderable using a material with dynamic environment mapping. */
+    struct EnvironmentProbe
+    {
+        static const UINT32 NUM_FACES = 6;
+        static const UINT8 ALL_FACES = (1 << NUM_FACES) - 1;
+
+        /** Renderable the probe has been created for. */
+        Renderable* Owner = nullptr;
+
+        /** World position the cube map is rendered from. */
+        Vector3 Position = Vector3::ZERO;
+
+        SPtr<PooledRenderTexture> Texture;
+        SPtr<RenderTexture> FaceTargets[NUM_FACES];
+
+        /** Hash of the probe position and of the bounds of every renderable drawn in the probe. */
+        UINT64 SurroundingsHash = 0;
+
+        /** Bit mask of the faces which need to be rendered again. */
+        UINT8 DirtyFaces = ALL_FACES;
+
+        /** True once every face has been rendered at least once, the cube map can be sampled. */
+        bool Complete = false;
+
+        /** Number of frames the probe has been waiting for its dirty faces to be rendered. */
+        UINT32 FramesWaiting = 0;
+
+        UINT64 LastUsedFrame = 0;
+    };
+
+    /** Identifies a single face of a probe to render. */
+    struct EnvironmentProbeFace
+    {
+        UINT32 ProbeIdx;
+        UINT32 Face;
+    };
+
+    /**
+     * Keeps track of the dynamic environment maps required by renderables visible in the main views, and decides which
+     * cube map faces are rendered each frame.
+     *
+     * Probes are cached from one frame to another and their faces are only rendered again when the probe moved, or when
+     * a renderable drawn in the probe moved. No more than RenderManOptions::DynamicEnvMapFacesPerFrame faces are
+     * rendered in a frame: probes which were never completely rendered come first, then probes closer to the view.
+     * Probes waiting for a long time get a higher priority so every probe is eventually updated. Until a probe is
+     * complete, its renderable keeps sampling the skybox.
+     */
+    class EnvironmentProbes
+    {
+    public:
+        EnvironmentProbes() = default;
+
+        /**
+         * Finds or creates probes for renderables visible in the provided view, invalidates probes whose surroundings
+         * changed, binds probe cube maps to the materials which use them and selects faces to render this frame (see
+         * GetFacesToRender()).
+         *
+         * @param[in]	sceneInfo		Information about the scene.
+         * @param[in]	view			Main view the probes are required for.
+         * @param[in]	visibility		Visibility of the renderables for the view.
+         * @param[in]	options			Renderer options providing the face budget and the probe resolution.
+         * @param[in]	frameIdx		Index of the current frame. The face budget is shared by all views of a frame.
+         */
+        void Update(const SceneInfo& sceneInfo, const RendererView& view, const VisibilityInfo& visibility,
+            const RenderManOptions& options, UINT64 frameIdx);
+
+        /** Returns faces selected by the last call to Update(). */
+        const Vector<EnvironmentProbeFace>& GetFacesToRender() const { return _facesToRender; }
+
+        /** Fills a view description able to render the provided face, using the properties of the main view. */
+        void GetFaceViewDesc(const RendererView& view, const EnvironmentProbeFace& face, const RenderManOptions& options,
+            RENDERER_VIEW_DESC& desc) const;
+
+        /** Marks the face as up to date. To be called once the face has been rendered. */
+        void NotifyFaceRendered(const EnvironmentProbeFace& face);
+
+        /** Releases the probe of a renderable removed from the scene. */
+        void NotifyRenderableRemoved(Renderable* renderable);
+
+        /** Releases all probes. */
+        void Clear();
+
+        /** Returns true if one of the materials of the renderable requires a dynamic environment map. */
+        static bool UsesDynamicEnvMap(const RendererRenderable& renderable);
+
+    private:
+        /** Probe waiting for faces to be rendered. */
+        struct UpdateCandidate
+        {
+            /** Incomplete probes can't be sampled yet, they are updated before all the others. */
+            bool Complete;
+
+            /** Distance to the view divided by the number of frames the probe waited. Lowest first. */
+            float Priority;
+
+            UINT32 ProbeIdx;
+        };
+
+        /** Returns the probe of the renderable, creating it if needed. */
+        EnvironmentProbe& FindOrCreateProbe(Renderable* renderable, UINT32 size);
+
+        /** (Re)creates the cube map of a probe and the render targets of its faces. */
+        void CreateProbeTexture(EnvironmentProbe& probe, UINT32 size);
+
+        /**
+         * Computes a hash of everything which requires the probe to be rendered again if it changes. Only renderables
+         * closer than @p range from the probe are taken into account.
+         */
+        UINT64 GetSurroundingsHash(const SceneInfo& sceneInfo, const EnvironmentProbe& probe, float range) const;
+
+        /**
+         * Assigns the probe cube map on materials of the renderable using dynamic environment mapping, or @p fallback
+         * if the probe is not complete yet.
+         */
+        void BindProbe(RendererRenderable& renderable, const EnvironmentProbe& probe, const SPtr<Texture>& fallback) const;
+
+        /** Releases probes not used by any view for a while. */
+        void ReleaseUnusedProbes(UINT64 frameIdx);
+
+    private:
+        Vector<EnvironmentProbe> _probes;
+        UnorderedMap<Renderable*, UINT32> _probeLookup;
+
+        Vector<EnvironmentProbeFace> _facesToRender;
+
+        UINT64 _currentFrameIdx = std::numeric_limits<UINT64>::max();
+        UINT32 _numFacesThisFrame = 0;
+
+        // Temporary buffers, kept in order to avoid allocations every frame
+        Vector<UINT32> _contributors;
+        Vector<UpdateCandidate> _candidates;
+    };
+}
@@ -0,0 +1,89 @@
+#include "TeInstanceDataBuffer.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "RenderAPI/TeGpuParams.h"
+
+namespace te
+{
+    InstanceDataBuffer::InstanceDataBuffer(UINT32 initialNumInstances)
+    {
+        if (initialNumInstances > 0)
+            CreateBuffer(initialNumInstances);
+    }
+
+    InstanceDataBuffer::~InstanceDataBuffer()
+    {
+        Destroy();
+    }
+
+    void InstanceDataBuffer::BeginFrame()
+    {
+        _head = 0;
+        _flushed = 0;
+        _pendingBinds.clear();
+    }
+
+    UINT32 InstanceDataBuffer::Allocate(UINT32 count)
+    {
+        const UINT32 first = _head;
+        _head += count;
+
+        // CPU side data is kept from one frame to another, so it only grows during the first frames
+        if (_head > (UINT32)_data.size())
+            _data.resize(_head);
+
+        return first;
+    }
+
+    void InstanceDataBuffer::Bind(const SPtr<GpuParams>& gpuParams)
+    {
+        _pendingBinds.push_back(gpuParams);
+    }
+
+    void InstanceDataBuffer::Flush()
+    {
+        if (_head > _flushed)
+        {
+            UINT32 first = _flushed;
+
+            // Instances already rendered this frame don't need to be uploaded again in the new buffer
+            if (_head > _capacity)
+                CreateBuffer(std::max(_head, _capacity * 2));
+
+            // The first upload of a frame discards the buffer, so the GPU can keep reading instances of the previous
+            // frame. Later uploads never touch ranges used by draws already submitted.
+            const BufferWriteType writeType = first == 0 ? BWT_DISCARD : BTW_NO_OVERWRITE;
+            const UINT32 instanceSize = NUM_ELEMENTS_PER_INSTANCE * sizeof(Vector4);
+            _buffer->WriteData(first * instanceSize, (_head - first) * instanceSize, &_data[first], writeType);
+
+            _flushed = _head;
+        }
+
+        for (auto& gpuParams : _pendingBinds)
+        {
+            if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "InstanceData"))
+                gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "InstanceData", _buffer);
+        }
+
+        _pendingBinds.clear();
+    }
+
+    void InstanceDataBuffer::Destroy()
+    {
+        _buffer = nullptr;
+        _capacity = 0;
+        _pendingBinds.clear();
+    }
+
+    void InstanceDataBuffer::CreateBuffer(UINT32 numInstances)
+    {
+        GPU_BUFFER_DESC desc;
+        desc.ElementCount = numInstances * NUM_ELEMENTS_PER_INSTANCE;
+        desc.ElementSize = 0;
+        desc.Type = GBT_STANDARD;
+        desc.Format = BF_32X4F;
+        desc.Usage = GBU_DYNAMIC;
+
+        _buffer = GpuBuffer::Create(desc);
+        _capacity = numInstances;
+    }
+}
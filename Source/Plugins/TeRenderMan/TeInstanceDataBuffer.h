@@ -0,0 +1,69 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+
+namespace te
+{
+    /**
+     * Per-frame storage of the data of all the instances drawn with instancing, in a single GPU buffer. Shaders read it
+     * as a buffer of float4 (InstanceData), indexed by the instance ID added to the offset of the draw (gInstanceOffset
+     * in PerInstanceBuffer).
+     *
+     * Data of a frame is written on the CPU side first, then each range written since the previous flush is uploaded at
+     * once. The GPU buffer grows on demand, so the number of instances of a single draw is not limited.
+     */
+    class InstanceDataBuffer
+    {
+    public:
+        /** Number of float4 elements used by a single instance in the GPU buffer. */
+        static const UINT32 NUM_ELEMENTS_PER_INSTANCE = sizeof(PerInstanceData) / sizeof(Vector4);
+
+        /** @param[in]	initialNumInstances		Number of instances the GPU buffer can hold before growing. */
+        InstanceDataBuffer(UINT32 initialNumInstances = 0);
+        ~InstanceDataBuffer();
+
+        /** Rewinds the buffer. Instances allocated during the previous frame can be reused. */
+        void BeginFrame();
+
+        /**
+         * Allocates data for @p count consecutive instances. Returns the index of the first instance, which is the
+         * offset shaders must add to the instance ID. Data must be written using GetData() before the next Flush().
+         */
+        UINT32 Allocate(UINT32 count);
+
+        /** Returns the data of an instance previously allocated. */
+        PerInstanceData& GetData(UINT32 instanceIdx) { return _data[instanceIdx]; }
+
+        /** Assigns the GPU buffer to the parameters during the next Flush(), once it is known it won't grow anymore. */
+        void Bind(const SPtr<GpuParams>& gpuParams);
+
+        /**
+         * Uploads instances allocated since the last flush and binds the GPU buffer to parameters provided through Bind().
+         * Must be called before the instances are used for rendering, and after all the data has been written.
+         */
+        void Flush();
+
+        /** Destroys the GPU buffer. */
+        void Destroy();
+
+        /** Returns the number of instances allocated since the beginning of the frame. */
+        UINT32 GetNumUsedInstances() const { return _head; }
+
+    private:
+        /** (Re)creates the GPU buffer, large enough to hold @p numInstances instances. */
+        void CreateBuffer(UINT32 numInstances);
+
+    private:
+        SPtr<GpuBuffer> _buffer;
+        UINT32 _capacity = 0;
+
+        Vector<PerInstanceData> _data;
+        UINT32 _head = 0;
+        UINT32 _flushed = 0;
+
+        Vector<SPtr<GpuParams>> _pendingBinds;
+    };
+
+    /** Per-frame data of instanced renderables. Rewound at the beginning of each frame. */
+    extern SPtr<InstanceDataBuffer> gInstanceDataBuffer;
+}
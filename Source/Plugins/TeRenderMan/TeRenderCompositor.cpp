@@ -42,7 +42,12 @@ namespace te
             // If Material is the same as the previous object, we only set constant buffer params
             // Instead, we set full gpu params
             // We also set camera buffer view here (because it will set PerCameraBuffer correctly for the current pass on this material only once)
-            if (!lastMaterial || lastMaterial != entry.RenderElem->MaterialElem)
+            // Renderables sharing a material can each have their own dynamic environment map, their textures must
+            // always be bound
+            const bool useDynamicEnvMap = view.GetRenderSettings().EnableDynamicEnvMapping &&
+                entry.RenderElem->MaterialElem->GetProperties().UseDynamicEnvironmentMap;
+
+            if (!lastMaterial || lastMaterial != entry.RenderElem->MaterialElem || useDynamicEnvMap)
             {
                 // If Globall Illumination is enabled and if a Skybox with a texture exists,,
                 // We bind this texture for this material
@@ -57,7 +62,8 @@ namespace te
                     } 
                 }
 
-                if (!entry.RenderElem->MaterialElem->GetProperties().UseEnvironmentMap)
+                // Dynamic environment maps are assigned by EnvironmentProbes, which falls back on the skybox itself
+                if (!entry.RenderElem->MaterialElem->GetProperties().UseEnvironmentMap && !useDynamicEnvMap)
                 {
                     if (view.GetRenderSettings().EnableSkybox)
                     {
@@ -866,7 +872,8 @@ namespace te
 
         gRendererUtility().Blit(input, Rect2I::EMPTY, viewProps.FlipView, false);
 
-        if (inputs.View.GetSceneCamera()->IsMain() && GuiAPI::Instance().IsGuiInitialized())
+        Camera* camera = inputs.View.GetSceneCamera();
+        if (camera && camera->IsMain() && GuiAPI::Instance().IsGuiInitialized())
             GuiAPI::Instance().EndFrame();
 
         gRenderer()->SetLastRenderTexture(RenderOutputType::Final, postProcessNode->GetLastOutput());
@@ -3,6 +3,7 @@
 #include "TeRendererScene.h"
 #include "TeRenderManOptions.h"
 #include "TeRenderCompositor.h"
+#include "TeInstanceDataBuffer.h"
 #include "Renderer/TeCamera.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Renderer/TeGpuResourcePool.h"
@@ -10,12 +11,14 @@
 #include "Manager/TeRendererManager.h"
 #include "CoreUtility/TeCoreObjectManager.h"
 #include "Profiling/TeProfilerGPU.h"
+#include "Profiling/TeProfilerRenderer.h"
 #include "Utility/TeTime.h"
 #include "Gui/TeGuiAPI.h"
 
 namespace te
 {
-    SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
+    SPtr<GpuParamBlockRingBuffer> gPerInstanceParamRingBuffer;
+    SPtr<InstanceDataBuffer> gInstanceDataBuffer;
 
     RenderMan::RenderMan()
     { }
@@ -29,10 +32,9 @@ namespace te
         RendererUtility::StartUp();
         GpuResourcePool::StartUp();
 
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER; i++)
-        {
-            gPerInstanceParamBuffer[i] = gPerInstanceParamDef.CreateBuffer();
-        }
+        gPerInstanceParamRingBuffer = te_shared_ptr_new<GpuParamBlockRingBuffer>(
+            gPerInstanceParamDef.GetBlockSize(), STANDARD_FORWARD_INITIAL_INSTANCED_BLOCKS_NUMBER);
+        gInstanceDataBuffer = te_shared_ptr_new<InstanceDataBuffer>(STANDARD_FORWARD_INITIAL_INSTANCES_NUMBER);
 
         _options = te_shared_ptr_new<RenderManOptions>();
         _options->InstancingMode = RenderManInstancing::Manual;
@@ -40,6 +42,7 @@ namespace te
         _scene = te_shared_ptr_new<RendererScene>(_options);
 
         _mainViewGroup = te_new<RendererViewGroup>(nullptr, 0, _options);
+        _probeViewGroup = te_new<RendererViewGroup>(nullptr, 0, _options);
 
         RenderCompositor::RegisterNodeType<RCNodeGpuInitializationPass>();
         RenderCompositor::RegisterNodeType<RCNodeForwardPass>();
@@ -58,28 +61,36 @@ namespace te
 
     void RenderMan::Destroy()
     {
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER; i++)
+        if (gPerInstanceParamRingBuffer)
         {
-            gPerInstanceParamBuffer[i]->Destroy();
+            gPerInstanceParamRingBuffer->Destroy();
+            gPerInstanceParamRingBuffer = nullptr;
         }
 
-        if (gPerLightsParamBuffer)
+        if (gInstanceDataBuffer)
         {
-            gPerLightsParamBuffer->Destroy();
-            gPerLightsParamBuffer = nullptr;
+            gInstanceDataBuffer->Destroy();
+            gInstanceDataBuffer = nullptr;
         }
 
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER; i++)
+        if (gPerLightsParamBuffer)
         {
-            if (gPerInstanceParamBuffer[i])
-                gPerInstanceParamBuffer[i] = nullptr;
+            gPerLightsParamBuffer->Destroy();
+            gPerLightsParamBuffer = nullptr;
         }
 
+        // Batches must be released while the scene still exists, they notify the renderer on destruction
+        _scene->ClearStaticBatches(false);
+        _environmentProbes.Clear();
         _scene = nullptr;
 
         RenderCompositor::CleanUp();
 
         te_delete(_mainViewGroup);
+        te_delete(_probeViewGroup);
+
+        if (_probeView)
+            te_delete(_probeView);
 
         GpuResourcePool::ShutDown();
         RendererUtility::ShutDown();
@@ -99,11 +110,15 @@ namespace te
     void RenderMan::RenderAll(PerFrameData& perFrameData)
     {
         gProfilerGPU().BeginFrame();
+        gProfilerRenderer().BeginFrame();
 
         _renderTextures.Clear();
 
         CoreObjectManager::Instance().FrameSync();
 
+        // Static batches requested by the user are built once all renderables are up to date
+        _scene->UpdateStaticBatches();
+
         const SceneInfo& sceneInfo = _scene->GetSceneInfo();
 
         FrameTimings timings;
@@ -114,14 +129,14 @@ namespace te
         // Update global per-frame hardware buffers
         _scene->SetParamFrameParams(timings.Time, timings.TimeDelta);
 
-        sceneInfo.RenderableReady.resize(sceneInfo.Renderables.size(), false);
-        sceneInfo.RenderableReady.assign(sceneInfo.Renderables.size(), false);
+        // Per-instance blocks used during last frame can be reused
+        gPerInstanceParamRingBuffer->BeginFrame();
+        gInstanceDataBuffer->BeginFrame();
 
         FrameInfo frameInfo(timings, perFrameData);
 
-        // Update per-frame data for all renderable objects
-        for (UINT32 i = 0; i < sceneInfo.Renderables.size(); i++)
-            _scene->PrepareRenderable(i, frameInfo);
+        // Update per-frame data of renderable objects which moved recently
+        _scene->PrepareRenderables(frameInfo);
 
         // Gather all views
         for (auto& rtInfo : sceneInfo.RenderTargets)
@@ -145,24 +160,47 @@ namespace te
 
             _mainViewGroup->SetViews(views.data(), (UINT32)views.size());
 
-            if (_options->CullingFlags & (UINT32)RenderManCulling::Frustum ||
-                _options->CullingFlags & (UINT32)RenderManCulling::Occlusion)
-            {
-                _mainViewGroup->DetermineVisibility(sceneInfo);
-            }
-            else // Set all objects as visible
             {
-                _mainViewGroup->SetAllObjectsAsVisible(sceneInfo);
+                TE_PROFILE_RENDERER_STAGE(Visibility);
+
+                if (_options->CullingFlags & (UINT32)RenderManCulling::Frustum ||
+                    _options->CullingFlags & (UINT32)RenderManCulling::Occlusion)
+                {
+                    _mainViewGroup->DetermineVisibility(sceneInfo);
+                }
+                else // Set all objects as visible
+                {
+                    _mainViewGroup->SetAllObjectsAsVisible(sceneInfo);
+                }
             }
 
+            TE_ADD_PROFILER_RENDERER(NumViews, (UINT32)views.size());
+
             for (auto& view : views)
             {
-                _mainViewGroup->GenerateInstanced(sceneInfo, _options->InstancingMode);
-                _mainViewGroup->GenerateRenderQueue(sceneInfo, *view, _options->InstancingMode);
+                // Refresh a few faces of the environment maps required by this view. Faces are rendered before the
+                // view builds its queues, so they don't overwrite the instance parameters the view will draw with
+                if (view->GetProperties().NeedDynamicEnvMapCompute && view->GetRenderSettings().EnableDynamicEnvMapping)
+                    RenderEnvironmentProbes(*view, frameInfo);
+
+                {
+                    TE_PROFILE_RENDERER_STAGE(Instancing);
+                    _mainViewGroup->GenerateInstanced(sceneInfo, _options->InstancingMode);
+                }
+
+                {
+                    TE_PROFILE_RENDERER_STAGE(QueueBuild);
+                    _mainViewGroup->GenerateRenderQueue(sceneInfo, *view, _options->InstancingMode);
+                }
+
+                // Upload all per-instance data written for this view at once
+                gPerInstanceParamRingBuffer->Flush();
+                gInstanceDataBuffer->Flush();
 
                 _scene->SetParamCameraParams(view->GetSceneCamera()->GetRenderSettings()->SceneLightColor);
                 _scene->SetParamSkyboxParams(view->GetSceneCamera()->GetRenderSettings()->EnableSkybox);
 
+                TE_PROFILE_RENDERER_STAGE(Submission);
                 if (RenderSingleView(*_mainViewGroup, *view, frameInfo))
                     anythingDrawn = true;
             }
@@ -175,6 +213,7 @@ namespace te
 
         GpuResourcePool::Instance().Update();
 
+        gProfilerRenderer().EndFrame();
         gProfilerGPU().EndFrame();
     }
 
@@ -250,6 +289,47 @@ namespace te
         view.EndFrame();
     }
 
+    void RenderMan::RenderEnvironmentProbes(const RendererView& view, const FrameInfo& frameInfo)
+    {
+        const SceneInfo& sceneInfo = _scene->GetSceneInfo();
+
+        _environmentProbes.Update(sceneInfo, view, _mainViewGroup->GetVisibilityInfo(), *_options,
+            frameInfo.Timings.FrameIdx);
+
+        const Vector<EnvironmentProbeFace>& faces = _environmentProbes.GetFacesToRender();
+        if (faces.empty())
+            return;
+
+        SPtr<RenderSettings> settings = te_shared_ptr_new<RenderSettings>(view.GetRenderSettings());
+
+        for (auto& face : faces)
+        {
+            RENDERER_VIEW_DESC viewDesc;
+            _environmentProbes.GetFaceViewDesc(view, face, *_options, viewDesc);
+
+            if (!_probeView)
+                _probeView = te_new<RendererView>(viewDesc);
+            else
+                _probeView->SetView(viewDesc);
+
+            _probeView->SetRenderSettings(settings);
+
+            RendererView* probeViews[] = { _probeView };
+            _probeViewGroup->SetViews(probeViews, 1);
+
+            // Always culled, the view only renders renderables flagged for dynamic environment mapping
+            _probeViewGroup->DetermineVisibility(sceneInfo);
+            _probeViewGroup->GenerateInstanced(sceneInfo, _options->InstancingMode);
+            _probeViewGroup->GenerateRenderQueue(sceneInfo, *_probeView, _options->InstancingMode);
+
+            gPerInstanceParamRingBuffer->Flush();
+            gInstanceDataBuffer->Flush();
+
+            RenderSingleView(*_probeViewGroup, *_probeView, frameInfo);
+            _environmentProbes.NotifyFaceRendered(face);
+        }
+    }
+
     bool RenderMan::RenderOverlay(RendererView& view, const FrameInfo& frameInfo)
     {
         // view.GetPerViewBuffer()->FlushToGPU(); TODO
@@ -325,6 +405,7 @@ namespace te
 
     void RenderMan::NotifyRenderableRemoved(Renderable* renderable)
     {
+        _environmentProbes.NotifyRenderableRemoved(renderable);
         _scene->UnregisterRenderable(renderable);
     }
 
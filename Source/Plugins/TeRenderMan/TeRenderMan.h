@@ -2,6 +2,7 @@
 
 #include "TeRenderManPrerequisites.h"
 #include "Renderer/TeRenderer.h"
+#include "TeEnvironmentProbes.h"
 
 namespace te
 {
@@ -77,6 +78,13 @@ namespace te
         /** Renders all objects visible by the provided view. */
         void RenderSingleViewInternal(const RendererViewGroup& viewGroup, RendererView& view, const FrameInfo& frameInfo);
 
+        /**
+         * Renders the dynamic environment map faces scheduled for the provided view, within the per-frame face budget.
+         * Must be called after visibility of the view has been determined, but before its instanced draws and render
+         * queues are generated, since instance parameters of renderables are shared by all views.
+         */
+        void RenderEnvironmentProbes(const RendererView& view, const FrameInfo& frameInfo);
+
         /** @copydoc Renderer::NotifyCameraAdded */
         void NotifyCameraAdded(Camera* camera) override;
 
@@ -132,6 +140,11 @@ namespace te
         // Helpers to avoid memory allocations
         RendererViewGroup* _mainViewGroup = nullptr;
 
+        // Dynamic environment maps, and the view used to render their faces
+        EnvironmentProbes _environmentProbes;
+        RendererView* _probeView = nullptr;
+        RendererViewGroup* _probeViewGroup = nullptr;
+
         // Keep track of all previously generated render textures
         // This structure is cleared when calling RenderAll()
         RenderTextures _renderTextures;
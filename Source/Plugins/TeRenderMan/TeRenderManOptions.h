@@ -30,5 +30,54 @@ namespace te
          * By default, we will try to batch objects which share same geometry and same material
         */
         RenderManInstancing InstancingMode = RenderManInstancing::Manual;
+
+        /**
+         * When a view group contains multiple views (e.g. cube map faces, stereo or split-screen cameras), renderables
+         * are culled once against a volume enclosing all the views, and only the ones inside it are tested against each
+         * view. Otherwise each view culls the whole scene on its own.
+         */
+        bool CombinedViewCulling = true;
+
+        /**
+         * Size of the cells of the grid used to split static batches (see Renderer::BatchRenderables()). Renderables are
+         * only merged with renderables in the same cell, which keeps batches small enough to be culled efficiently. If
+         * zero or less, batches are not split.
+         */
+        float StaticBatchingCellSize = 32.0f;
+
+        /**
+         * Scales the projected screen size of renderables before selecting the level of detail of their mesh. Values
+         * greater than one keep detailed levels of detail longer.
+         */
+        float LODBias = 1.0f;
+
+        /**
+         * Fraction of a level of detail screen size the projected size must move past before switching to another level
+         * of detail. Prevents popping when a renderable stays around a screen size threshold.
+         */
+        float LODHysteresis = 0.1f;
+
+        /**
+         * Maximum number of dynamic environment map faces rendered in a frame. Each face requires rendering the scene
+         * once more, so probes are updated over several frames when more faces need to be rendered.
+         */
+        UINT32 DynamicEnvMapFacesPerFrame = 1;
+
+        /** Width and height, in pixels, of each face of dynamic environment maps. */
+        UINT32 DynamicEnvMapSize = 256;
+
+        /**
+         * Influence radius of dynamic environment maps. Only renderables closer than this distance to a probe are drawn
+         * in it, and only their changes require its faces to be rendered again. If zero or less, the far plane of the
+         * view is used.
+         */
+        float DynamicEnvMapRadius = 50.0f;
+
+        /**
+         * Radial and spot lights whose importance for all views of a group is lower than this value are culled. The
+         * importance of a light is its intensity, multiplied by its brightest color channel and by the fraction of the
+         * viewport height covered by its bounds. Zero disables the culling.
+         */
+        float LightImportanceThreshold = 0.001f;
     };
 }
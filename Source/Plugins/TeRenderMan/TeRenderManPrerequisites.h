@@ -2,19 +2,22 @@
 
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Renderer/TeParamBlocks.h"
+#include "RenderAPI/TeGpuParamBlockRingBuffer.h"
 #include "Math/TeMatrix4.h"
 #include "Math/TeVector2.h"
 
 #define STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE 128
 #define STANDARD_FORWARD_MIN_INSTANCED_BLOCK_SIZE 2
-#define STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER 128
+#define STANDARD_FORWARD_INITIAL_INSTANCED_BLOCKS_NUMBER 8
+#define STANDARD_FORWARD_INITIAL_INSTANCES_NUMBER 1024
 
-#define STANDARD_FORWARD_MAX_VERTICES_COMBINED_MESH 4096
+#define STANDARD_FORWARD_MAX_VERTICES_COMBINED_MESH 65536
 
 #define STANDARD_FORWARD_MAX_NUM_LIGHTS 24
 
 namespace te
 {
+    /** Data of a single instance, as stored in the instance data buffer. Size must be a multiple of 16 bytes. */
     struct PerInstanceData
     {
         Matrix4 gMatWorld;
@@ -149,12 +152,14 @@ namespace te
 
     extern PerMaterialParamDef gPerMaterialParamDef;
 
+    /** Data of the instances themselves is stored in a buffer shared by all draws, see InstanceDataBuffer. */
     TE_PARAM_BLOCK_BEGIN(PerInstanceParamDef)
-        TE_PARAM_BLOCK_ENTRY_ARRAY(PerInstanceData, gInstances, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gInstanceOffset)
     TE_PARAM_BLOCK_END
 
     extern PerInstanceParamDef gPerInstanceParamDef;
-    extern SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
+    /** Per-frame ring of per-instance blocks, grown on demand. Rewound at the beginning of each frame. */
+    extern SPtr<GpuParamBlockRingBuffer> gPerInstanceParamRingBuffer;
 
     TE_PARAM_BLOCK_BEGIN(PerLightsParamDef)
         TE_PARAM_BLOCK_ENTRY_ARRAY(LightData, gLights, STANDARD_FORWARD_MAX_NUM_LIGHTS)
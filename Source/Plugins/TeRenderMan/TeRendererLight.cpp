@@ -1,6 +1,7 @@
 #include "TeRendererLight.h"
 #include "TeRendererView.h"
 #include "TeRendererScene.h"
+#include "TeRenderManOptions.h"
 
 namespace te
 {
@@ -68,8 +69,11 @@ namespace te
         , _numShadowedLights { }
     { }
 
-    void VisibleLightData::Update(const SceneInfo& sceneInfo, const RendererViewGroup& viewGroup)
+    void VisibleLightData::Update(const SceneInfo& sceneInfo, const RendererViewGroup& viewGroup,
+        const RenderManOptions& options)
     {
+        const float threshold = options.LightImportanceThreshold;
+
         const VisibilityInfo& visibility = viewGroup.GetVisibilityInfo();
 
         for (UINT32 i = 0; i < (UINT32)LightType::Count; i++)
@@ -92,6 +96,9 @@ namespace te
             if (!visibility.RadialLights[i])
                 continue;
 
+            if (!IsImportant(sceneInfo.RadialLights[i], sceneInfo.RadialLightWorldBounds[i], viewGroup, threshold))
+                continue;
+
             _visibleLights[(UINT32)LightType::Radial].push_back(&sceneInfo.RadialLights[i]);
         }
 
@@ -101,6 +108,9 @@ namespace te
             if (!visibility.SpotLights[i])
                 continue;
 
+            if (!IsImportant(sceneInfo.SpotLights[i], sceneInfo.SpotLightWorldBounds[i], viewGroup, threshold))
+                continue;
+
             _visibleLights[(UINT32)LightType::Spot].push_back(&sceneInfo.SpotLights[i]);
         }
 
@@ -156,100 +166,110 @@ namespace te
     void VisibleLightData::GatherInfluencingLights(const Bounds& bounds,
         const LightData* (&output)[STANDARD_FORWARD_MAX_NUM_LIGHTS], Vector3I& counts) const
     {
-        UINT32 outputIndices[STANDARD_FORWARD_MAX_NUM_LIGHTS];
-        UINT32 numInfluencingLights = 0;
-
-        UINT32 numDirLights = GetNumDirLights();
-        for (UINT32 i = 0; i < numDirLights; i++)
+        /** Light selected for the object, with its importance. */
+        struct LightCandidate
         {
-            if (numInfluencingLights >= STANDARD_FORWARD_MAX_NUM_LIGHTS)
-                return;
-
-            outputIndices[numInfluencingLights] = i;
-            numInfluencingLights++;
-        }
+            float Importance;
+            UINT32 Idx;
+        };
 
-        UINT32 pointLightOffset = numInfluencingLights;
+        // The least important selected light is on top of the heap, so it can be replaced in logarithmic time
+        auto lessImportant = [](const LightCandidate& a, const LightCandidate& b) { return a.Importance > b.Importance; };
 
-        float distances[STANDARD_FORWARD_MAX_NUM_LIGHTS];
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_NUM_LIGHTS; i++)
-            distances[i] = std::numeric_limits<float>::max();
+        LightCandidate candidates[STANDARD_FORWARD_MAX_NUM_LIGHTS];
+        UINT32 numCandidates = 0;
 
-        // Note: This is an ad-hoc way of evaluating light influence, a better way might be wanted
-        UINT32 numLights = (UINT32)_visibleLightData.size();
-        UINT32 furthestLightIdx = (UINT32)-1;
-        float furthestDistance = 0.0f;
-        for (UINT32 j = numDirLights; j < numLights; j++)
-        {
-            const LightData* lightData = &_visibleLightData[j];
+        counts = Vector3I(0, 0, 0);
 
-            Sphere lightSphere(lightData->Position, lightData->BoundsRadius);
-            if (bounds.GetSphere().Intersects(lightSphere))
-            {
-                float distance = bounds.GetSphere().GetCenter().SquaredDistance(lightData->Position);
+        // Directional lights always influence the object
+        const UINT32 numDirLights = std::min(GetNumDirLights(), (UINT32)STANDARD_FORWARD_MAX_NUM_LIGHTS);
+        for (UINT32 i = 0; i < numDirLights; i++)
+            output[i] = &_visibleLightData[i];
 
-                // See where in the array can we fit the light
-                if (numInfluencingLights < STANDARD_FORWARD_MAX_NUM_LIGHTS)
-                {
-                    outputIndices[numInfluencingLights] = j;
-                    distances[numInfluencingLights] = distance;
+        counts.x = (INT32)numDirLights;
 
-                    if (distance > furthestDistance)
-                    {
-                        furthestLightIdx = numInfluencingLights;
-                        furthestDistance = distance;
-                    }
+        const UINT32 maxCandidates = STANDARD_FORWARD_MAX_NUM_LIGHTS - numDirLights;
+        const Sphere& boundsSphere = bounds.GetSphere();
 
-                    numInfluencingLights++;
-                }
-                else if (distance < furthestDistance)
-                {
-                    outputIndices[furthestLightIdx] = j;
-                    distances[furthestLightIdx] = distance;
+        const auto numLights = (UINT32)_visibleLightData.size();
+        for (UINT32 i = GetNumDirLights(); i < numLights && maxCandidates > 0; i++)
+        {
+            const LightData& lightData = _visibleLightData[i];
+            if (!boundsSphere.Intersects(Sphere(lightData.Position, lightData.BoundsRadius)))
+                continue;
 
-                    furthestDistance = distance;
-                    for (UINT32 k = 0; k < STANDARD_FORWARD_MAX_NUM_LIGHTS; k++)
-                    {
-                        if (distances[k] > furthestDistance)
-                        {
-                            furthestDistance = distances[k];
-                            furthestLightIdx = k;
-                        }
-                    }
-                }
+            const float importance = GetLightImportance(lightData, boundsSphere);
+            if (numCandidates < maxCandidates)
+            {
+                candidates[numCandidates++] = { importance, i };
+                std::push_heap(candidates, candidates + numCandidates, lessImportant);
+            }
+            else if (importance > candidates[0].Importance)
+            {
+                std::pop_heap(candidates, candidates + numCandidates, lessImportant);
+                candidates[numCandidates - 1] = { importance, i };
+                std::push_heap(candidates, candidates + numCandidates, lessImportant);
             }
         }
 
-        // Output actual light data, sorted by type
-        counts = Vector3I(0, 0, 0);
+        // Output lights in the order of the light buffer, so radial lights come before spot lights
+        std::sort(candidates, candidates + numCandidates,
+            [](const LightCandidate& a, const LightCandidate& b) { return a.Idx < b.Idx; });
 
-        for (UINT32 i = 0; i < pointLightOffset; i++)
+        const UINT32 spotLightIdx = GetNumDirLights() + GetNumRadialLights();
+        for (UINT32 i = 0; i < numCandidates; i++)
         {
-            output[i] = &_visibleLightData[outputIndices[i]];
-            counts.x += 1;
+            output[numDirLights + i] = &_visibleLightData[candidates[i].Idx];
+
+            if (candidates[i].Idx >= spotLightIdx)
+                counts.z += 1;
+            else
+                counts.y += 1;
         }
+    }
 
-        UINT32 outputIdx = pointLightOffset;
-        UINT32 spotLightIdx = GetNumDirLights() + GetNumRadialLights();
-        for (UINT32 i = pointLightOffset; i < numInfluencingLights; i++)
-        {
-            bool isSpot = outputIndices[i] >= spotLightIdx;
-            if (isSpot)
-                continue;
+    float VisibleLightData::GetLightImportance(const LightData& light, const Sphere& bounds)
+    {
+        const float brightness = light.Intensity * std::max(light.Color.x, std::max(light.Color.y, light.Color.z));
+
+        // Attenuation at the point of the bounds closest to the light
+        const float distance = std::max(bounds.GetCenter().Distance(light.Position) - bounds.GetRadius(), 0.0f);
+        const float attenuation = 1.0f / (1.0f + light.LinearAttenuation * distance +
+            light.QuadraticAttenuation * distance * distance);
 
-            output[outputIdx++] = &_visibleLightData[outputIndices[i]];
-            counts.y += 1;
+        // Fades to zero at the light range so lights far away are always less important than close ones
+        const float range = std::max(light.AttenuationRadius, light.BoundsRadius);
+        float window = 1.0f;
+        if (range > 0.0f)
+        {
+            const float ratio = std::min(distance / range, 1.0f);
+            window = (1.0f - ratio * ratio) * (1.0f - ratio * ratio);
         }
 
-        for (UINT32 i = pointLightOffset; i < numInfluencingLights; i++)
+        return brightness * attenuation * window;
+    }
+
+    bool VisibleLightData::IsImportant(const RendererLight& light, const Sphere& lightBounds,
+        const RendererViewGroup& viewGroup, float threshold)
+    {
+        if (threshold <= 0.0f)
+            return true;
+
+        const Color color = light._internal->GetColor();
+        const float brightness = light._internal->GetIntensity() * std::max(color.r, std::max(color.g, color.b));
+
+        for (UINT32 i = 0; i < viewGroup.GetNumViews(); i++)
         {
-            bool isSpot = outputIndices[i] >= spotLightIdx;
-            if (!isSpot)
+            const RendererView* view = viewGroup.GetView(i);
+            if (!view->ShouldDraw3D())
                 continue;
 
-            output[outputIdx++] = &_visibleLightData[outputIndices[i]];
-            counts.z += 1;
+            const float coverage = std::min(view->GetProjectedScreenSize(lightBounds), 1.0f);
+            if (brightness * coverage >= threshold)
+                return true;
         }
+
+        return false;
     }
     
     void VisibleLightData::GatherLights(const LightData* (&output)[STANDARD_FORWARD_MAX_NUM_LIGHTS],
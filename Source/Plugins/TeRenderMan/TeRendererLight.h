@@ -2,6 +2,7 @@
 
 #include "TeRenderManPrerequisites.h"
 #include "Renderer/TeLight.h"
+#include "Math/TeSphere.h"
 
 namespace te
 {
@@ -47,12 +48,12 @@ namespace te
          * Updates the internal buffers with a new set of lights. Before calling make sure that light visibility has
          * been calculated for the provided view group.
          */
-        void Update(const SceneInfo& sceneInfo, const RendererViewGroup& viewGroup);
+        void Update(const SceneInfo& sceneInfo, const RendererViewGroup& viewGroup, const RenderManOptions& options);
 
         /**
          * Scans the list of lights visible in the view frustum to find the ones influencing the object described by
          * the provided bounds. A maximum number of STANDARD_FORWARD_MAX_NUM_LIGHTS will be output. If there are more
-         * influencing lights, only the most important ones will be returned.
+         * influencing lights, only the most important ones will be returned (see GetLightImportance()).
          *
          * The lights will be output in the following order: directional, radial, spot. @p counts will contain the number
          * of directional lights (component 'x'), number of radial lights (component 'y') and number of spot lights
@@ -97,6 +98,20 @@ namespace te
         /** Returns a list of all visible lights of the specified type. */
         const Vector<const RendererLight*>& GetLights(LightType type) const { return _visibleLights[(UINT32)type]; }
 
+        /**
+         * Estimates how much a radial or spot light contributes to the lighting of an object, from the light intensity
+         * and color, and from its attenuation at the point of the object bounds closest to the light.
+         */
+        static float GetLightImportance(const LightData& light, const Sphere& bounds);
+
+    private:
+        /**
+         * Returns false if the light contribution to all views of the group is too low to be worth rendering (see
+         * RenderManOptions::LightImportanceThreshold).
+         */
+        static bool IsImportant(const RendererLight& light, const Sphere& lightBounds, const RendererViewGroup& viewGroup,
+            float threshold);
+
     private:
         INT32 _numLights[(UINT32)LightType::Count];
         UINT32 _numShadowedLights[(UINT32)LightType::Count];
@@ -9,28 +9,25 @@ namespace te
     PerMaterialParamDef gPerMaterialParamDef;
     PerObjectParamDef gPerObjectParamDef;
 
-    void PerObjectBuffer::UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
-        const Matrix4& prevTfrm, Renderable* renderable)
+    void PerObjectBuffer::UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const RendererRenderable& rendererRenderable)
     {
-        const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
+        const Renderable* renderable = rendererRenderable.RenderablePtr;
         const UINT32 layer = Bitwise::MostSignificantBit(renderable->GetLayer());
 
-        gPerObjectParamDef.gMatWorld.Set(buffer, tfrm);
-        gPerObjectParamDef.gMatInvWorld.Set(buffer, tfrm.InverseAffine());
-        gPerObjectParamDef.gMatWorldNoScale.Set(buffer, tfrmNoScale);
-        gPerObjectParamDef.gMatInvWorldNoScale.Set(buffer, tfrmNoScale.InverseAffine());
-        gPerObjectParamDef.gMatPrevWorld.Set(buffer, prevTfrm);
+        gPerObjectParamDef.gMatWorld.Set(buffer, rendererRenderable.WorldTfrm);
+        gPerObjectParamDef.gMatInvWorld.Set(buffer, rendererRenderable.InvWorldTfrm);
+        gPerObjectParamDef.gMatWorldNoScale.Set(buffer, rendererRenderable.WorldNoScaleTfrm);
+        gPerObjectParamDef.gMatInvWorldNoScale.Set(buffer, rendererRenderable.InvWorldNoScaleTfrm);
+        gPerObjectParamDef.gMatPrevWorld.Set(buffer, rendererRenderable.PrevWorldTfrm);
         gPerObjectParamDef.gLayer.Set(buffer, (INT32)layer);
         gPerObjectParamDef.gHasAnimation.Set(buffer, (UINT32)renderable->IsAnimated() ? 1 : 0);
         gPerObjectParamDef.gWriteVelocity.Set(buffer, (UINT32)renderable->GetWriteVelocity() ? 1 : 0);
         gPerObjectParamDef.gCastLights.Set(buffer, (UINT32)renderable->GetCastLights() ? 1 : 0);
     }
 
-    void PerObjectBuffer::UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer, 
-        SPtr<GpuParamBlockBuffer>& perInstanceBuffer, PerInstanceData* instanceData, UINT32 instanceCounter)
+    void PerObjectBuffer::UpdatePerInstance(const SPtr<GpuParamBlockBuffer>& perInstanceBuffer, UINT32 instanceOffset)
     {
-        for (size_t i = 0; i < instanceCounter; i++)
-            gPerInstanceParamDef.gInstances.Set(perInstanceBuffer, instanceData[i], (UINT32)i);
+        gPerInstanceParamDef.gInstanceOffset.Set(perInstanceBuffer, instanceOffset);
     }
 
     void PerObjectBuffer::UpdatePerMaterial(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, const MaterialProperties& properties)
@@ -111,7 +108,7 @@ namespace te
 
     void RenderableElement::Draw() const
     {
-        gRendererUtility().Draw(MeshElem, *SubMeshElem, InstanceCount);
+        gRendererUtility().Draw(MeshElem, *SubMeshElem, InstanceCount, LODIdx);
     }
 
     RendererRenderable::RendererRenderable()
@@ -124,11 +121,14 @@ namespace te
 
     void RendererRenderable::UpdatePerObjectBuffer()
     {
-        PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, WorldTfrm, PrevWorldTfrm, RenderablePtr);
+        PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, *this);
     }
 
-    void RendererRenderable::UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId)
+    void RendererRenderable::UpdateMatrices()
     {
-        PerObjectBuffer::UpdatePerInstance(PerObjectParamBuffer, gPerInstanceParamBuffer[blockId], instanceData, instanceCounter);
+        WorldTfrm = RenderablePtr->GetMatrix();
+        InvWorldTfrm = WorldTfrm.InverseAffine();
+        WorldNoScaleTfrm = RenderablePtr->GetMatrixNoScale();
+        InvWorldNoScaleTfrm = WorldNoScaleTfrm.InverseAffine();
     }
 }
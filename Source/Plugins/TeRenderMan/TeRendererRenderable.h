@@ -11,25 +11,20 @@ namespace te
     {
     public:
         /** 
-         * Updates the provided buffer with the data from the provided matrices. 
+         * Updates the provided buffer with the matrices and properties of a renderable.
          *
          *  @param[in]	buffer	      Buffer which will be filled with data
-         *  @param[in]	tfrm	      World matrix of current object
-         *  @param[in]	prevTfrm	  Previous World matrix of current object
-         *  @param[in]	RenderablePtr Pointer to the current Renderable we want to update
+         *  @param[in]	renderable    Renderable we want to update, its matrices must be up to date
          */
-        static void UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
-            const Matrix4& prevTfrm, Renderable* RenderablePtr);
+        static void UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const RendererRenderable& renderable);
 
         /** 
-         * Update the provided instance buffer
+         * Writes the offset of the first instance of a draw in the instance data buffer (see InstanceDataBuffer)
          * 
-         *  @param[in]	perObjectBuffer	    Per object Buffer which will be filled with data
          *  @param[in]	perInstanceBuffer	Per instance Buffer which will be filled with data
-         *  @param[in]	instanceData	    data list we want to store inside instance buffer
+         *  @param[in]	instanceOffset	    index of the first instance of the draw in the instance data buffer
          */
-        static void UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer,
-            SPtr<GpuParamBlockBuffer>& perInstanceBuffer, PerInstanceData* instanceData, UINT32 instanceCounter);
+        static void UpdatePerInstance(const SPtr<GpuParamBlockBuffer>& perInstanceBuffer, UINT32 instanceOffset);
 
         /**
          * Update the provided material buffer
@@ -76,19 +71,27 @@ namespace te
         /** Updates the per-object GPU buffer according to the currently set properties. */
         void UpdatePerObjectBuffer();
 
-        /** 
-         * Updates the per-instance GPU buffer according to the currently set properties. 
-         *
-         * @param[in]	instanceData	Array with max with of 64
-         * @param[in]	instanceCounter	Number of valid element to store in array
-         * @param[in]	blockId	        We create only 8 instance buffer, we need to know in which we want to register data
+        /**
+         * Updates the world matrix from the renderable and recomputes matrices derived from it. Must be called each time
+         * the transform of the renderable changes.
          */
-        void UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId);
+        void UpdateMatrices();
 
         Matrix4 WorldTfrm = Matrix4::IDENTITY;
         Matrix4 PrevWorldTfrm = Matrix4::IDENTITY;
+
+        /** Matrices derived from the world matrix, cached so they are not computed again for renderables not moving. */
+        Matrix4 InvWorldTfrm = Matrix4::IDENTITY;
+        Matrix4 WorldNoScaleTfrm = Matrix4::IDENTITY;
+        Matrix4 InvWorldNoScaleTfrm = Matrix4::IDENTITY;
         PrevFrameDirtyState PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
 
+        /** True if the renderable is in the list of renderables processed by RendererScene::PrepareRenderables(). */
+        bool PrepareQueued = false;
+
+        /** Value of SceneInfo::RenderableReadyIdx when the renderable was made ready for rendering for the last time. */
+        UINT64 ReadyIdx = std::numeric_limits<UINT64>::max();
+
         Renderable* RenderablePtr;
         Vector<RenderableElement> Elements;
 
@@ -12,6 +12,8 @@
 #include "RenderAPI/TeGpuPipelineState.h"
 #include "Resources/TeBuiltinResources.h"
 #include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshData.h"
+#include "RenderAPI/TeVertexDataDesc.h"
 
 namespace te
 {
@@ -69,6 +71,212 @@ namespace te
         }
     }
 
+    /** Key used to group sub-meshes which can be merged together in the same static batch. */
+    struct StaticBatchKey
+    {
+        Material* MaterialElem = nullptr;
+        UINT64 Layer = 0;
+        UINT32 Flags = 0;
+        float CullDistanceFactor = 1.0f;
+        size_t VertexLayout = 0;
+        INT32 CellX = 0;
+        INT32 CellY = 0;
+        INT32 CellZ = 0;
+
+        bool operator==(const StaticBatchKey& rhs) const
+        {
+            return MaterialElem == rhs.MaterialElem && Layer == rhs.Layer && Flags == rhs.Flags &&
+                CullDistanceFactor == rhs.CullDistanceFactor && VertexLayout == rhs.VertexLayout &&
+                CellX == rhs.CellX && CellY == rhs.CellY && CellZ == rhs.CellZ;
+        }
+    };
+
+    struct StaticBatchKeyHash
+    {
+        size_t operator()(const StaticBatchKey& key) const
+        {
+            size_t hash = 0;
+            te_hash_combine(hash, key.MaterialElem);
+            te_hash_combine(hash, key.Layer);
+            te_hash_combine(hash, key.Flags);
+            te_hash_combine(hash, key.CullDistanceFactor);
+            te_hash_combine(hash, key.VertexLayout);
+            te_hash_combine(hash, key.CellX);
+            te_hash_combine(hash, key.CellY);
+            te_hash_combine(hash, key.CellZ);
+
+            return hash;
+        }
+    };
+
+    /** A single sub-mesh to merge in a static batch. */
+    struct StaticBatchEntry
+    {
+        Renderable* Source;
+        UINT32 SubMeshIdx;
+    };
+
+    /** Vertices and indices of a static batch being built, in world space. */
+    struct StaticBatchGeometry
+    {
+        Vector<UINT8> Vertices;
+        Vector<UINT32> Indices;
+        UINT32 NumVertices = 0;
+    };
+
+    /** Returns true if all sub-meshes of a renderable can be merged in static batches. */
+    static bool CanBeStaticBatched(Renderable* renderable)
+    {
+        if (renderable->GetMobility() != ObjectMobility::Immovable && !renderable->GetCanBeMerged())
+            return false;
+
+        if (renderable->GetInstancing() || renderable->IsAnimated())
+            return false;
+
+        SPtr<Mesh> mesh = renderable->GetMesh();
+        if (mesh == nullptr || mesh->GetSkeleton() != nullptr)
+            return false;
+
+        // Only single stream meshes are merged, vertices are copied as a whole
+        SPtr<VertexDataDesc> vertexDesc = mesh->GetVertexDesc();
+        if (!vertexDesc->HasElement(VES_POSITION))
+            return false;
+
+        for (UINT32 i = 0; i < vertexDesc->GetNumElements(); i++)
+        {
+            if (vertexDesc->GetElement(i).GetStreamIdx() != 0)
+                return false;
+        }
+
+        MeshProperties& meshProps = mesh->GetProperties();
+        for (UINT32 i = 0; i < meshProps.GetNumSubMeshes(); i++)
+        {
+            if (meshProps.GetSubMesh(i).DrawOp != DOT_TRIANGLE_LIST)
+                return false;
+
+            // Transparent objects need to be sorted back to front, they can't be merged
+            SPtr<Material> material = renderable->GetMaterial(i);
+            if (material == nullptr || material->GetShader() == nullptr ||
+                material->GetShader()->GetFlags() & (UINT32)ShaderFlag::Transparent)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /** Returns a hash identifying how vertices are laid out in memory. */
+    static size_t GetVertexLayoutHash(const VertexDataDesc& vertexDesc)
+    {
+        size_t hash = 0;
+        for (UINT32 i = 0; i < vertexDesc.GetNumElements(); i++)
+        {
+            const VertexElement& element = vertexDesc.GetElement(i);
+            te_hash_combine(hash, (UINT32)element.GetSemantic());
+            te_hash_combine(hash, element.GetSemanticIdx());
+            te_hash_combine(hash, (UINT32)element.GetType());
+            te_hash_combine(hash, element.GetStreamIdx());
+        }
+
+        return hash;
+    }
+
+    /** Transforms a 3D vector stored in a vertex element, which can be either a FLOAT3 or a FLOAT4 (w is untouched). */
+    static void TransformVertexElement(UINT8* data, const VertexDataDesc& vertexDesc, VertexElementSemantic semantic,
+        const Matrix4& tfrm, bool isDirection)
+    {
+        const VertexElement* element = vertexDesc.GetElement(semantic);
+        if (element == nullptr || (element->GetType() != VET_FLOAT3 && element->GetType() != VET_FLOAT4))
+            return;
+
+        Vector3* value = (Vector3*)(data + vertexDesc.GetElementOffsetFromStream(semantic));
+        if (isDirection)
+        {
+            *value = tfrm.MultiplyDirection(*value);
+            value->Normalize();
+        }
+        else
+        {
+            *value = tfrm.MultiplyAffine(*value);
+        }
+    }
+
+    /** Copies vertices and indices of a sub-mesh, in world space, at the end of the provided batch geometry. */
+    static void AppendStaticBatchSubMesh(StaticBatchGeometry& geometry, const MeshData& meshData, const SubMesh& subMesh,
+        const Matrix4& tfrm)
+    {
+        const VertexDataDesc& vertexDesc = *meshData.GetVertexDesc();
+        const UINT32 stride = vertexDesc.GetVertexStride(0);
+        const UINT8* srcVertices = meshData.GetStreamData(0);
+        const Matrix4 normalTfrm = tfrm.InverseAffine().Transpose();
+        const bool indices32 = meshData.GetIndexElementSize() == sizeof(UINT32);
+
+        // Tangents only follow the orientation of the mesh, they are renormalized once transformed like normals
+        Vector3 position;
+        Quaternion rotation;
+        Vector3 scale;
+        tfrm.Decomposition(position, rotation, scale);
+        const Matrix4 tangentTfrm = Matrix4::Rotation(rotation);
+
+        // Sub-meshes usually share vertices with other sub-meshes, only referenced vertices are copied
+        UnorderedMap<UINT32, UINT32> remap;
+        for (UINT32 i = subMesh.IndexOffset; i < subMesh.IndexOffset + subMesh.IndexCount; i++)
+        {
+            UINT32 index = indices32 ? meshData.GetIndices32()[i] : (UINT32)meshData.GetIndices16()[i];
+
+            auto iterFind = remap.find(index);
+            if (iterFind != remap.end())
+            {
+                geometry.Indices.push_back(iterFind->second);
+                continue;
+            }
+
+            UINT32 newIndex = geometry.NumVertices++;
+            remap[index] = newIndex;
+            geometry.Indices.push_back(newIndex);
+
+            size_t offset = geometry.Vertices.size();
+            geometry.Vertices.resize(offset + stride);
+
+            UINT8* dest = geometry.Vertices.data() + offset;
+            memcpy(dest, srcVertices + (size_t)index * stride, stride);
+
+            TransformVertexElement(dest, vertexDesc, VES_POSITION, tfrm, false);
+            TransformVertexElement(dest, vertexDesc, VES_NORMAL, normalTfrm, true);
+            TransformVertexElement(dest, vertexDesc, VES_TANGENT, tangentTfrm, true);
+            TransformVertexElement(dest, vertexDesc, VES_BITANGENT, tangentTfrm, true);
+        }
+    }
+
+    /** Creates a renderable drawing the provided geometry with a single draw call. */
+    static SPtr<Renderable> CreateStaticBatchRenderable(StaticBatchGeometry& geometry, const SPtr<VertexDataDesc>& vertexDesc,
+        Renderable* templateRenderable, const SPtr<Material>& material)
+    {
+        SPtr<MeshData> meshData = MeshData::Create(geometry.NumVertices, (UINT32)geometry.Indices.size(), vertexDesc);
+        memcpy(meshData->GetStreamData(0), geometry.Vertices.data(), geometry.Vertices.size());
+        memcpy(meshData->GetIndices32(), geometry.Indices.data(), geometry.Indices.size() * sizeof(UINT32));
+
+        SPtr<Mesh> mesh = Mesh::_createPtr(meshData, MU_STATIC, DOT_TRIANGLE_LIST);
+
+        RenderableProperties properties = templateRenderable->GetProperties();
+        properties.Instancing = false;
+        properties.CanBeMerged = false;
+
+        SPtr<Renderable> renderable = Renderable::CreateEmpty();
+        renderable->SetMesh(mesh);
+        renderable->SetMaterial(0, material);
+        renderable->SetLayer(templateRenderable->GetLayer());
+        renderable->SetPorperties(properties);
+        renderable->SetMobility(ObjectMobility::Immovable);
+        renderable->Initialize();
+
+        // Everything has already been sent to the renderer by Initialize()
+        renderable->MarkCoreClean();
+
+        return renderable;
+    }
+
     RendererScene::RendererScene(const SPtr<RenderManOptions>& options)
         : _options(options)
     { 
@@ -275,10 +483,11 @@ namespace te
         renderable->SetRendererId(renderableId);
         _info.Renderables.push_back(te_new<RendererRenderable>());
         _info.RenderableCullInfos.push_back(CullInfo(renderable->GetBounds(), renderable->GetLayer(), renderable->GetCullDistanceFactor()));
+        _info.RenderableCullInfos.back().Version = ++_cullInfoVersion;
 
         RendererRenderable* rendererRenderable = _info.Renderables.back();
         rendererRenderable->RenderablePtr = renderable;
-        rendererRenderable->WorldTfrm = renderable->GetMatrix();
+        rendererRenderable->UpdateMatrices();
         rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
         rendererRenderable->UpdatePerObjectBuffer();
@@ -300,27 +509,30 @@ namespace te
     {
         UINT32 renderableId = renderable->GetRendererId();
 
-        // If element can be merged, we check if it still exist on renderer side
-        if (renderable->GetCanBeMerged())
+        // A merged renderable has been modified, its batch is not valid anymore
+        if (_staticBatchSources.find(renderable) != _staticBatchSources.end())
         {
-            if (renderableId > _info.Renderables.size())
-                return;
-            if (_info.Renderables[renderableId]->RenderablePtr != renderable)
-                return;
+            ClearStaticBatches();
+            return;
         }
 
+        if (!IsRegistered(renderable))
+            return;
+
         RendererRenderable* rendererRenderable = _info.Renderables[renderableId];
 
         if(rendererRenderable->PreviousFrameDirtyState != PrevFrameDirtyState::Updated)
             rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
 
-        rendererRenderable->WorldTfrm = renderable->GetMatrix();
+        rendererRenderable->UpdateMatrices();
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Updated;
+        QueuePrepareRenderable(rendererRenderable);
 
         _info.Renderables[renderableId]->UpdatePerObjectBuffer();
         _info.RenderableCullInfos[renderableId].Layer = renderable->GetLayer();
         _info.RenderableCullInfos[renderableId].Boundaries = renderable->GetBounds();
         _info.RenderableCullInfos[renderableId].CullDistanceFactor = renderable->GetCullDistanceFactor();
+        _info.RenderableCullInfos[renderableId].Version = ++_cullInfoVersion;
 
         if (_options->InstancingMode == RenderManInstancing::Manual)
         {
@@ -341,15 +553,17 @@ namespace te
     { 
         UINT32 renderableId = renderable->GetRendererId();
 
-        // If element can be merged, we check if it still exist on renderer side
-        if (renderable->GetCanBeMerged())
+        // A merged renderable has been removed, its geometry must not be drawn anymore
+        if (_staticBatchSources.find(renderable) != _staticBatchSources.end())
         {
-            if (renderableId > _info.Renderables.size())
-                return;
-            if (_info.Renderables[renderableId]->RenderablePtr != renderable)
-                return;
+            _staticBatchSources.erase(renderable);
+            ClearStaticBatches();
+            return;
         }
 
+        if (!IsRegistered(renderable))
+            return;
+
         Renderable* lastRenderable = _info.Renderables.back()->RenderablePtr;
         UINT32 lastRenderableId = lastRenderable->GetRendererId();
 
@@ -371,6 +585,13 @@ namespace te
                 _info.RenderablesInstanced.erase(iter);
         }
 
+        if (rendererRenderable->PrepareQueued)
+        {
+            auto iter = std::find(_dirtyRenderables.begin(), _dirtyRenderables.end(), rendererRenderable);
+            std::swap(*iter, _dirtyRenderables.back());
+            _dirtyRenderables.pop_back();
+        }
+
         // Last element is the one we want to erase
         _info.Renderables.erase(_info.Renderables.end() - 1);
         _info.RenderableCullInfos.erase(_info.RenderableCullInfos.end() - 1);
@@ -379,7 +600,166 @@ namespace te
     }
 
     void RendererScene::BatchRenderables()
-    { }
+    {
+        // Renderables are usually created and modified right before this call. Batches are built at the beginning of
+        // next frame, once all pending changes have been synced with the renderer
+        _staticBatchingRequested = true;
+    }
+
+    void RendererScene::UpdateStaticBatches()
+    {
+        if (!_staticBatchingRequested)
+            return;
+
+        _staticBatchingRequested = false;
+        ClearStaticBatches();
+
+        const float cellSize = _options->StaticBatchingCellSize;
+
+        UnorderedMap<StaticBatchKey, Vector<StaticBatchEntry>, StaticBatchKeyHash> groups;
+        Vector<Renderable*> sources;
+
+        // Group all sub-meshes which can be merged by material, properties and cell
+        for (auto& rendererRenderable : _info.Renderables)
+        {
+            Renderable* renderable = rendererRenderable->RenderablePtr;
+            if (!CanBeStaticBatched(renderable))
+                continue;
+
+            SPtr<Mesh> mesh = renderable->GetMesh();
+            const RenderableProperties& properties = renderable->GetProperties();
+            const size_t vertexLayout = GetVertexLayoutHash(*mesh->GetVertexDesc());
+
+            for (UINT32 i = 0; i < mesh->GetProperties().GetNumSubMeshes(); i++)
+            {
+                StaticBatchKey key;
+                key.MaterialElem = renderable->GetMaterial(i).get();
+                key.Layer = renderable->GetLayer();
+                key.Flags = (properties.CastShadows ? 1 << 0 : 0) | (properties.ReceiveShadows ? 1 << 1 : 0) |
+                    (properties.CastLights ? 1 << 2 : 0) | (properties.WriteVelocity ? 1 << 3 : 0) |
+                    (properties.UseForDynamicEnvMapping ? 1 << 4 : 0);
+                key.CullDistanceFactor = properties.CullDistanceFactor;
+                key.VertexLayout = vertexLayout;
+
+                if (cellSize > 0.0f)
+                {
+                    const Vector3 center = renderable->GetSubMeshBounds(i).GetBox().GetCenter();
+                    key.CellX = Math::FloorToInt(center.x / cellSize);
+                    key.CellY = Math::FloorToInt(center.y / cellSize);
+                    key.CellZ = Math::FloorToInt(center.z / cellSize);
+                }
+
+                groups[key].push_back({ renderable, i });
+            }
+
+            sources.push_back(renderable);
+        }
+
+        if (sources.empty())
+            return;
+
+        // Mesh data is read only once for meshes shared by several renderables
+        UnorderedMap<Mesh*, SPtr<MeshData>> meshDatas;
+        auto GetMeshData = [&](const SPtr<Mesh>& mesh) -> const SPtr<MeshData>&
+        {
+            auto iterFind = meshDatas.find(mesh.get());
+            if (iterFind != meshDatas.end())
+                return iterFind->second;
+
+            SPtr<MeshData> meshData = mesh->GetCachedData();
+            if (meshData == nullptr)
+            {
+                meshData = mesh->AllocateBuffer();
+                mesh->ReadData(*meshData);
+            }
+
+            return meshDatas[mesh.get()] = meshData;
+        };
+
+        struct PendingBatch
+        {
+            StaticBatchGeometry Geometry;
+            SPtr<VertexDataDesc> VertexDesc;
+            Renderable* Template;
+            SPtr<Material> MaterialElem;
+        };
+
+        Vector<PendingBatch> pendingBatches;
+        for (auto& group : groups)
+        {
+            Vector<StaticBatchEntry>& entries = group.second;
+            Renderable* templateRenderable = entries[0].Source;
+
+            pendingBatches.push_back(PendingBatch());
+            pendingBatches.back().VertexDesc = templateRenderable->GetMesh()->GetVertexDesc();
+            pendingBatches.back().Template = templateRenderable;
+            pendingBatches.back().MaterialElem = templateRenderable->GetMaterial(entries[0].SubMeshIdx);
+
+            for (auto& entry : entries)
+            {
+                SPtr<Mesh> mesh = entry.Source->GetMesh();
+                const SubMesh& subMesh = mesh->GetProperties().GetSubMesh(entry.SubMeshIdx);
+
+                // Start a new batch when the current one is full, it keeps culling efficient
+                if (pendingBatches.back().Geometry.NumVertices > 0 &&
+                    pendingBatches.back().Geometry.NumVertices + subMesh.IndexCount > STANDARD_FORWARD_MAX_VERTICES_COMBINED_MESH)
+                {
+                    PendingBatch newBatch;
+                    newBatch.VertexDesc = pendingBatches.back().VertexDesc;
+                    newBatch.Template = pendingBatches.back().Template;
+                    newBatch.MaterialElem = pendingBatches.back().MaterialElem;
+                    pendingBatches.push_back(newBatch);
+                }
+
+                AppendStaticBatchSubMesh(pendingBatches.back().Geometry, *GetMeshData(mesh), subMesh, entry.Source->GetMatrix());
+            }
+        }
+
+        // Merged renderables are replaced by batches
+        for (auto& source : sources)
+        {
+            UnregisterRenderable(source);
+            _staticBatchSources.insert(source);
+        }
+
+        for (auto& batch : pendingBatches)
+        {
+            if (batch.Geometry.NumVertices == 0)
+                continue;
+
+            _staticBatches.push_back(CreateStaticBatchRenderable(batch.Geometry, batch.VertexDesc, batch.Template,
+                batch.MaterialElem));
+        }
+
+        TE_DEBUG("Static batching : " + ToString((UINT32)sources.size()) + " renderables merged into " +
+            ToString((UINT32)_staticBatches.size()) + " batches");
+    }
+
+    bool RendererScene::IsRegistered(Renderable* renderable) const
+    {
+        UINT32 renderableId = renderable->GetRendererId();
+
+        return renderableId < (UINT32)_info.Renderables.size() && 
+            _info.Renderables[renderableId]->RenderablePtr == renderable;
+    }
+
+    void RendererScene::ClearStaticBatches(bool restoreSources)
+    {
+        // Once unregistered, batches are ignored when they notify the renderer about their destruction
+        for (auto& batch : _staticBatches)
+            UnregisterRenderable(batch.get());
+
+        _staticBatches.clear();
+
+        UnorderedSet<Renderable*> sources = std::move(_staticBatchSources);
+        _staticBatchSources.clear();
+
+        if (restoreSources)
+        {
+            for (auto& source : sources)
+                RegisterRenderable(source);
+        }
+    }
 
     void RendererScene::SetMeshData(RendererRenderable* rendererRenderable, Renderable* renderable)
     {
@@ -505,34 +885,52 @@ namespace te
         }
     }
 
-    void RendererScene::PrepareRenderable(UINT32 idx, const FrameInfo& frameInfo)
+    void RendererScene::PrepareRenderables(const FrameInfo& frameInfo)
     {
-        RendererRenderable* rendererRenderable = _info.Renderables[idx];
+        _info.RenderableReadyIdx++;
 
-        if (rendererRenderable->PreviousFrameDirtyState != PrevFrameDirtyState::Clean)
+        // Renderables are kept in the list until their previous frame transform caught up with the current one
+        UINT32 numDirtyRenderables = 0;
+        for (auto& rendererRenderable : _dirtyRenderables)
         {
             if (rendererRenderable->PreviousFrameDirtyState == PrevFrameDirtyState::Updated)
                 rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::CopyMostRecent;
             else if (rendererRenderable->PreviousFrameDirtyState == PrevFrameDirtyState::CopyMostRecent)
             {
-                rendererRenderable->PrevWorldTfrm = _info.Renderables[idx]->WorldTfrm;
+                rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
                 rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
                 rendererRenderable->UpdatePerObjectBuffer();
             }
+
+            if (rendererRenderable->PreviousFrameDirtyState != PrevFrameDirtyState::Clean)
+                _dirtyRenderables[numDirtyRenderables++] = rendererRenderable;
+            else
+                rendererRenderable->PrepareQueued = false;
         }
+
+        _dirtyRenderables.resize(numDirtyRenderables);
     }
 
-    void RendererScene::PrepareVisibleRenderable(UINT32 idx, const FrameInfo& frameInfo)
+    void RendererScene::QueuePrepareRenderable(RendererRenderable* rendererRenderable)
     {
-        if (_info.RenderableReady[idx])
+        if (rendererRenderable->PrepareQueued)
             return;
 
+        rendererRenderable->PrepareQueued = true;
+        _dirtyRenderables.push_back(rendererRenderable);
+    }
+
+    void RendererScene::PrepareVisibleRenderable(UINT32 idx, const FrameInfo& frameInfo)
+    {
         RendererRenderable* rendererRenderable = _info.Renderables[idx];
 
+        if (rendererRenderable->ReadyIdx == _info.RenderableReadyIdx)
+            return;
+
         if(frameInfo.PerFrameDatas.Animation != nullptr)
             rendererRenderable->RenderablePtr->UpdateAnimationBuffers(*frameInfo.PerFrameDatas.Animation);
 
-        _info.RenderableReady[idx] = true;
+        rendererRenderable->ReadyIdx = _info.RenderableReadyIdx;
     }
 
     RENDERER_VIEW_DESC RendererScene::CreateViewDesc(Camera* camera) const
@@ -33,9 +33,8 @@ namespace te
         // FrameBuffer data
         SPtr<GpuParamBlockBuffer> PerFrameParamBuffer;
 
-        // Buffers for various transient data that gets rebuilt every frame
-        //// Rebuilt every frame
-        mutable Vector<bool> RenderableReady;
+        // Incremented every frame. A renderable is ready for rendering once its RendererRenderable::ReadyIdx matches it
+        UINT64 RenderableReadyIdx = 0;
     };
 
     /** Contains information about the scene (e.g. renderables, lights, cameras) required by the renderer. */
@@ -81,9 +80,28 @@ namespace te
         /** Removes a renderable object from the scene. */
         void UnregisterRenderable(Renderable* renderable);
 
-        /** All renderables market as "mergeable" will be merged into several bigger mesh according to their material */
+        /** 
+         * All renderables marked as "mergeable" or immovable will be merged into several bigger mesh according to their
+         * material and position. Batches are built at the beginning of next frame, see UpdateStaticBatches().
+         */
         void BatchRenderables();
 
+        /**
+         * Builds static batches if they have been requested with BatchRenderables(). To be called at the start of every
+         * frame, once all pending changes have been synced with the renderer.
+         *
+         * Merged renderables are removed from the scene and replaced by one renderable per batch. If a merged renderable
+         * is modified or removed afterwards, all batches are dissolved and merged renderables are registered back
+         * individually. Call BatchRenderables() again to rebuild them.
+         */
+        void UpdateStaticBatches();
+
+        /** 
+         * Destroys all static batches. If @p restoreSources is true, renderables which have been merged are registered 
+         * back in the scene.
+         */
+        void ClearStaticBatches(bool restoreSources = true);
+
         /** Sometimes, we just want to update data on a mesh without removing and adding renderable (heavy operation) */
         void UpdateMeshData(RendererRenderable* rendererRenderable, Renderable* renderable);
 
@@ -103,12 +121,13 @@ namespace te
         void SetParamSkyboxParams(bool enabled);
 
         /**
-         * Performs necessary per-frame updates to a renderable. This must be called once every frame for every renderable.
+         * Performs necessary per-frame updates to renderables. This must be called once every frame. Only renderables
+         * which have been updated recently are processed, so the cost depends on how many renderables moved and not on
+         * the number of renderables in the scene.
          *
-         * @param[in]	idx			Index of the renderable to prepare.
          * @param[in]	frameInfo	Global information describing the current frame.
          */
-        void PrepareRenderable(UINT32 idx, const FrameInfo& frameInfo);
+        void PrepareRenderables(const FrameInfo& frameInfo);
 
         /**
          * Performs necessary steps to make a renderable ready for rendering. This must be called at least once every frame
@@ -130,8 +149,24 @@ namespace te
          */
         void UpdateCameraRenderTargets(Camera* camera, bool remove = false);
 
+        /** Returns true if the renderable is currently registered in the scene. Merged renderables are not. */
+        bool IsRegistered(Renderable* renderable) const;
+
+        /** Adds the renderable to the list of renderables processed by PrepareRenderables(), if not already in it. */
+        void QueuePrepareRenderable(RendererRenderable* rendererRenderable);
+
     private:
         SceneInfo _info;
         SPtr<RenderManOptions> _options;
+
+        // Renderables whose previous frame data is not up to date yet
+        Vector<RendererRenderable*> _dirtyRenderables;
+
+        // Last value assigned to CullInfo::Version
+        UINT64 _cullInfoVersion = 0;
+
+        Vector<SPtr<Renderable>> _staticBatches;
+        UnorderedSet<Renderable*> _staticBatchSources;
+        bool _staticBatchingRequested = false;
     };
 }
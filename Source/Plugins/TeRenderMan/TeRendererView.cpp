@@ -4,18 +4,20 @@
 #include "TeRenderCompositor.h"
 #include "TeRenderManOptions.h"
 #include "TeRendererRenderable.h"
+#include "TeInstanceDataBuffer.h"
 #include "Renderer/TeCamera.h"
 #include "Renderer/TeRenderable.h"
 #include "Renderer/TeRenderSettings.h"
 #include "Material/TeMaterial.h"
 #include "Material/TeShader.h"
 #include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshUtility.h"
+#include "Profiling/TeProfilerRenderer.h"
 
 namespace te
 {
     PerCameraParamDef gPerCameraParamDef;
 
-    PerInstanceData RendererView::_instanceDataPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
     Vector<InstancedBuffer> RendererView::_instancedBuffersPool(8);
 
     /** Struct used to compare two instanced buffer */
@@ -55,6 +57,7 @@ namespace te
 
         _forwardOpaqueQueue = te_shared_ptr_new<RenderQueue>();
         _forwardTransparentQueue = te_shared_ptr_new<RenderQueue>();
+        _forwardTransparentQueue->SetCoherentSorting(true);
 
         _compositor = te_unique_ptr_new<RenderCompositor>();
     }
@@ -92,6 +95,9 @@ namespace te
             transparentStateReduction = StateReduction::Distance; // Transparent object MUST be sorted by distance
 
         _forwardTransparentQueue = te_shared_ptr_new<RenderQueue>(transparentStateReduction);
+
+        // Order of transparent elements only changes slightly from one frame to another
+        _forwardTransparentQueue->SetCoherentSorting(true);
     }
 
     void RendererView::SetRenderSettings(const SPtr<RenderSettings>& settings)
@@ -221,7 +227,26 @@ namespace te
         if (!ShouldDraw3D())
             return;
 
-        CalculateVisibility(cullInfos, _visibility.Renderables);
+        UpdateVisibilityCache((UINT32)renderables.size());
+
+        UINT32 numCulled[4] = { 0, 0, 0, 0 };
+
+        const bool filtered = _properties.DynamicEnvMappingOnly || _properties.ExcludedRenderable;
+        for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
+        {
+            if (filtered && !AcceptsRenderable(*renderables[i]->RenderablePtr))
+                continue;
+
+            const CullResult result = CullCached(i, cullInfos[i]);
+            if (result == CullResult::Visible)
+                _visibility.Renderables[i].Visible = true;
+
+            numCulled[(UINT32)result]++;
+        }
+
+        TE_ADD_PROFILER_RENDERER(NumCulledByLayer, numCulled[(UINT32)CullResult::CulledByLayer]);
+        TE_ADD_PROFILER_RENDERER(NumCulledByDistance, numCulled[(UINT32)CullResult::CulledByDistance]);
+        TE_ADD_PROFILER_RENDERER(NumCulledByFrustum, numCulled[(UINT32)CullResult::CulledByFrustum]);
 
         if (visibility != nullptr)
         {
@@ -284,40 +309,124 @@ namespace te
         }
     }
 
-    void RendererView::CalculateVisibility(const Vector<CullInfo>& cullInfos, Vector<RenderableVisibility>& visibility) const
+    CullResult RendererView::Cull(const CullInfo& cullInfo) const
     {
-        UINT64 cameraLayers = _properties.VisibleLayers;
-        const ConvexVolume& worldFrustum = _properties.CullFrustum;
-        const Vector3& worldCameraPosition = _properties.ViewOrigin;
-        float baseCullDistance = _renderSettings->CullDistance;
+        if ((cullInfo.Layer & _properties.VisibleLayers) == 0)
+            return CullResult::CulledByLayer;
 
-        for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+        // Do distance culling
+        const Sphere& boundingSphere = cullInfo.Boundaries.GetSphere();
+        const Vector3& worldRenderablePosition = boundingSphere.GetCenter();
+
+        float distanceToCameraSq = _properties.ViewOrigin.SquaredDistance(worldRenderablePosition);
+        float correctedCullDistance = cullInfo.CullDistanceFactor * _renderSettings->CullDistance;
+        float maxDistanceToCamera = correctedCullDistance + boundingSphere.GetRadius();
+
+        if (distanceToCameraSq > maxDistanceToCamera* maxDistanceToCamera)
+            return CullResult::CulledByDistance;
+
+        // Do frustum culling
+        // Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
+        // operations, as it is trivial to update them. Also consider spatial partitioning.
+        if (!_properties.CullFrustum.Intersects(boundingSphere))
+            return CullResult::CulledByFrustum;
+
+        // More precise with the box
+        if (!_properties.CullFrustum.Intersects(cullInfo.Boundaries.GetBox()))
+            return CullResult::CulledByFrustum;
+
+        return CullResult::Visible;
+    }
+
+    CullResult RendererView::CullCached(UINT32 idx, const CullInfo& cullInfo)
+    {
+        if (_cachedCullVersions[idx] == cullInfo.Version)
+            return _cachedCullResults[idx];
+
+        const CullResult result = Cull(cullInfo);
+        _cachedCullResults[idx] = result;
+        _cachedCullVersions[idx] = cullInfo.Version;
+
+        return result;
+    }
+
+    void RendererView::UpdateVisibilityCache(UINT32 numRenderables)
+    {
+        // Version 0 is never assigned to a registered renderable, entries using it are always tested again
+        const Matrix4 viewProj = _properties.ProjTransformNoAA * _properties.ViewTransform;
+        if (viewProj != _cachedViewProj || _properties.ViewOrigin != _cachedViewOrigin ||
+            _renderSettings->CullDistance != _cachedCullDistance || _properties.VisibleLayers != _cachedVisibleLayers)
         {
-            if ((cullInfos[i].Layer & cameraLayers) == 0)
-                continue;
+            _cachedViewProj = viewProj;
+            _cachedViewOrigin = _properties.ViewOrigin;
+            _cachedCullDistance = _renderSettings->CullDistance;
+            _cachedVisibleLayers = _properties.VisibleLayers;
+
+            _cachedCullVersions.assign(_cachedCullVersions.size(), 0);
+        }
 
-            // Do distance culling
-            const Sphere& boundingSphere = cullInfos[i].Boundaries.GetSphere();
-            const Vector3& worldRenderablePosition = boundingSphere.GetCenter();
+        // Renderables removed from the scene are swapped with the last one, which always has a different version
+        _cachedCullResults.resize(numRenderables, CullResult::Visible);
+        _cachedCullVersions.resize(numRenderables, 0);
+    }
 
-            float distanceToCameraSq = worldCameraPosition.SquaredDistance(worldRenderablePosition);
-            float correctedCullDistance = cullInfos[i].CullDistanceFactor * baseCullDistance;
-            float maxDistanceToCamera = correctedCullDistance + boundingSphere.GetRadius();
+    bool RendererView::AcceptsRenderable(const Renderable& renderable) const
+    {
+        if (&renderable == _properties.ExcludedRenderable)
+            return false;
 
-            if (distanceToCameraSq > maxDistanceToCamera* maxDistanceToCamera)
-                continue;
+        if (_properties.DynamicEnvMappingOnly && !renderable.GetUseForDynamicEnvMapping())
+            return false;
 
-            // Do frustum culling
-            // Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-            // operations, as it is trivial to update them. Also consider spatial partitioning.
-            if (worldFrustum.Intersects(boundingSphere))
-            {
-                // More precise with the box
-                const AABox& boundingBox = cullInfos[i].Boundaries.GetBox();
+        return true;
+    }
+
+    Sphere RendererView::GetFrustumBoundingSphere() const
+    {
+        const Matrix4& proj = _properties.ProjTransform;
+        const bool perspective = _properties.ProjType == PT_PERSPECTIVE;
 
-                if (worldFrustum.Intersects(boundingBox))
-                    visibility[i].Visible = true;
+        // Find view space corners of the frustum by reversing the projection of the NDC corners
+        Vector3 corners[8];
+        for (UINT32 i = 0; i < 8; i++)
+        {
+            float depth = (i & 4) ? _properties.FarPlane : _properties.NearPlane;
+            float ndcX = (i & 1) ? 1.0f : -1.0f;
+            float ndcY = (i & 2) ? 1.0f : -1.0f;
+
+            if (perspective)
+            {
+                corners[i].x = depth * (ndcX + proj[0][2]) / proj[0][0];
+                corners[i].y = depth * (ndcY + proj[1][2]) / proj[1][1];
             }
+            else
+            {
+                corners[i].x = (ndcX - proj[0][3]) / proj[0][0];
+                corners[i].y = (ndcY - proj[1][3]) / proj[1][1];
+            }
+
+            corners[i].z = -depth;
+        }
+
+        Vector3 center = Vector3::ZERO;
+        for (auto& corner : corners)
+            center += corner;
+
+        center /= 8.0f;
+
+        float radius = 0.0f;
+        for (auto& corner : corners)
+            radius = std::max(radius, center.Distance(corner));
+
+        return Sphere(_properties.ViewTransform.InverseAffine().MultiplyAffine(center), radius);
+    }
+
+    void RendererView::CalculateVisibility(const Vector<CullInfo>& cullInfos, Vector<RenderableVisibility>& visibility) const
+    {
+        for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+        {
+            if (IsVisible(cullInfos[i]))
+                visibility[i].Visible = true;
         }
     }
 
@@ -349,7 +458,49 @@ namespace te
         }
     }
 
-    void RendererView::QueueRenderElements(const SceneInfo& sceneInfo)
+    float RendererView::GetProjectedScreenSize(const Sphere& bounds) const
+    {
+        // Projected radius in NDC, NDC height is 2 so it is also the fraction of the viewport height covered by the diameter
+        if (_properties.ProjType == PT_ORTHOGRAPHIC)
+            return bounds.GetRadius() * _properties.ProjTransform[1][1];
+
+        const float distance = std::max((_properties.ViewOrigin - bounds.GetCenter()).Length(), bounds.GetRadius());
+        if (distance <= 0.0f)
+            return std::numeric_limits<float>::max();
+
+        return bounds.GetRadius() * std::abs(_properties.ProjTransform[1][1]) / distance;
+    }
+
+    UINT32 RendererView::SelectLOD(const SceneInfo& sceneInfo, UINT32 renderableIdx, const RenderManOptions& options)
+    {
+        if (_renderableLODs.size() != sceneInfo.Renderables.size())
+            _renderableLODs.resize(sceneInfo.Renderables.size(), std::make_pair((UINT64)0, 0U));
+
+        Renderable* renderable = sceneInfo.Renderables[renderableIdx]->RenderablePtr;
+
+        // Renderables are moved to other indices when one is unregistered, the previous level of detail only applies
+        // if it was selected for the same renderable
+        std::pair<UINT64, UINT32>& previousLOD = _renderableLODs[renderableIdx];
+        if (previousLOD.first != renderable->GetInternalID())
+            previousLOD = std::make_pair(renderable->GetInternalID(), 0U);
+
+        const SPtr<Mesh>& mesh = renderable->GetMesh();
+        if (mesh == nullptr)
+            return 0;
+
+        const Vector<float>& screenSizes = mesh->GetProperties().GetLODScreenSizes();
+        if (screenSizes.empty())
+            return 0;
+
+        const float screenSize = GetProjectedScreenSize(sceneInfo.RenderableCullInfos[renderableIdx].Boundaries.GetSphere())
+            * options.LODBias;
+        const UINT32 lod = MeshUtility::SelectLOD(screenSizes, screenSize, previousLOD.second, options.LODHysteresis);
+
+        previousLOD.second = lod;
+        return lod;
+    }
+
+    void RendererView::QueueRenderElements(const SceneInfo& sceneInfo, const RenderManOptions& options)
     {
         const ConvexVolume& worldFrustum = _properties.CullFrustum;
 
@@ -359,6 +510,8 @@ namespace te
             if (!_visibility.Renderables[i].Visible)
                 continue;
 
+            const UINT32 lod = SelectLOD(sceneInfo, i, options);
+
             UINT32 j = 0;
             for (auto& renderElem : sceneInfo.Renderables[i]->Elements)
             {
@@ -379,6 +532,9 @@ namespace te
                 UINT32 shaderFlags = renderElem.MaterialElem->GetShader()->GetFlags();
                 UINT32 techniqueIdx = renderElem.DefaultTechniqueIdx;
 
+                // Elements are shared by all views, but a view is always queued right before being rendered
+                renderElem.LODIdx = lod;
+
                 // Note: I could keep renderables in multiple separate arrays, so I don't need to do the check here
                 if (shaderFlags & (UINT32)ShaderFlag::Transparent)
                     _forwardTransparentQueue->Add(&renderElem, distanceToCamera, techniqueIdx);
@@ -389,74 +545,75 @@ namespace te
             }
         }
 
-        _forwardOpaqueQueue->Sort();
-        _forwardTransparentQueue->Sort();
+        {
+            TE_PROFILE_RENDERER_STAGE(Sort);
+
+            _forwardOpaqueQueue->Sort();
+            _forwardTransparentQueue->Sort();
+        }
+
+        TE_ADD_PROFILER_RENDERER(NumOpaqueElements, (UINT32)_forwardOpaqueQueue->GetSortedElements().size());
+        TE_ADD_PROFILER_RENDERER(NumTransparentElements, (UINT32)_forwardTransparentQueue->GetSortedElements().size());
     }
 
-    void RendererView::QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffer)
+    void RendererView::QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffer,
+        const RenderManOptions& options)
     {
-        // We now have a list of similar objects to render
-        // However, each instance can't be bigger than 128 elements
-        // So we divide the size of the list by 128 to know how many instance blocks we will render
-        UINT32 instBlockCount = ((UINT32)instancedBuffer.Idx.size() / STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE) + 1;
-        UINT32 instancedObjectCounter = 0;
+        // We now have a list of similar objects to render. Their data is written in the instance data buffer, which
+        // grows if needed, so all instances using the same level of detail are rendered with a single draw
+        const auto numInstances = (UINT32)instancedBuffer.Idx.size();
+        if (numInstances == 0)
+            return;
 
-        if (instBlockCount > STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
-        {
-            instBlockCount = STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER;
-            TE_DEBUG("Maximum number of instanced block reached : " + ToString(instBlockCount));
-        }
+        _instanceLODs.resize(numInstances);
+        for (UINT32 i = 0; i < numInstances; i++)
+            _instanceLODs[i] = std::make_pair(SelectLOD(sceneInfo, instancedBuffer.Idx[i], options), instancedBuffer.Idx[i]);
 
-        // For each instance block we retrieve all necessary data
-        for (UINT32 currInstBlock = 0; currInstBlock < instBlockCount; currInstBlock++)
-        {
-            // We need to know start and end of element for this instance block
-            UINT32 lowerBlockBound = currInstBlock * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
-            UINT32 upperBlockBound = (currInstBlock + 1) * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
+        // Most of the time all instances use the same level of detail, and the list is already sorted
+        std::stable_sort(_instanceLODs.begin(), _instanceLODs.end(),
+            [](const std::pair<UINT32, UINT32>& a, const std::pair<UINT32, UINT32>& b) { return a.first < b.first; });
 
-            if (upperBlockBound > (UINT32)instancedBuffer.Idx.size())
-                upperBlockBound = (UINT32)instancedBuffer.Idx.size();
+        UINT32 lowerBound = 0;
+        while (lowerBound < numInstances)
+        {
+            const UINT32 lod = _instanceLODs[lowerBound].first;
 
-            if (lowerBlockBound == upperBlockBound)
-                break;
+            UINT32 upperBound = lowerBound + 1;
+            while (upperBound < numInstances && _instanceLODs[upperBound].first == lod)
+                upperBound++;
 
-            // We will use first element of this block for its data (each element has same internal data)
-            UINT32 idx = instancedBuffer.Idx[lowerBlockBound];
+            // We will use first element of this draw for its data (each element has same internal data)
+            UINT32 idx = _instanceLODs[lowerBound].second;
 
             const AABox& boundingBox = sceneInfo.RenderableCullInfos[idx].Boundaries.GetBox();
             const float distanceToCamera = (_properties.ViewOrigin - boundingBox.GetCenter()).Length();
 
-            PerInstanceData data;
+            const UINT32 instanceOffset = gInstanceDataBuffer->Allocate(upperBound - lowerBound);
 
-            for (auto subElemIdx = lowerBlockBound; subElemIdx < upperBlockBound; subElemIdx++)
+            SPtr<GpuParamBlockBuffer> instanceBuffer = gPerInstanceParamRingBuffer->Allocate();
+            PerObjectBuffer::UpdatePerInstance(instanceBuffer, instanceOffset);
+
+            for (auto subElemIdx = lowerBound; subElemIdx < upperBound; subElemIdx++)
             {
-                UINT32 elemId = instancedBuffer.Idx[subElemIdx];
-                const Renderable* renderable = sceneInfo.Renderables[elemId]->RenderablePtr;
-                const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
-
-                //Once all this stuff is done, we need to write into perinstance buffer
-                //GpuParamBlockBuffer* buffer = sceneInfo.Renderables[elemId]->PerObjectParamBuffer.get();
-
-                data.gMatWorld = sceneInfo.Renderables[elemId]->WorldTfrm;
-                data.gMatInvWorld = sceneInfo.Renderables[elemId]->WorldTfrm.InverseAffine();
-                data.gMatWorldNoScale = tfrmNoScale;
-                data.gMatInvWorldNoScale = tfrmNoScale.InverseAffine();
-                data.gMatPrevWorld = sceneInfo.Renderables[elemId]->PrevWorldTfrm;
+                UINT32 elemId = _instanceLODs[subElemIdx].second;
+
+                const RendererRenderable* rendererRenderable = sceneInfo.Renderables[elemId];
+                const Renderable* renderable = rendererRenderable->RenderablePtr;
+
+                // Data is written once, straight into the instance data buffer. Upload is done when it is flushed.
+                // Matrices are cached by the renderable when its transform changes, so this is only a copy
+                PerInstanceData& data = gInstanceDataBuffer->GetData(instanceOffset + subElemIdx - lowerBound);
+                data.gMatWorld = rendererRenderable->WorldTfrm;
+                data.gMatInvWorld = rendererRenderable->InvWorldTfrm;
+                data.gMatWorldNoScale = rendererRenderable->WorldNoScaleTfrm;
+                data.gMatInvWorldNoScale = rendererRenderable->InvWorldNoScaleTfrm;
+                data.gMatPrevWorld = rendererRenderable->PrevWorldTfrm;
                 data.gLayer = (UINT32)renderable->GetLayer();
                 data.gHasAnimation = (renderable->IsAnimated()) ? 1 : 0;
                 data.gWriteVelocity = (renderable->GetWriteVelocity()) ? 1 : 0;
                 data.gCastLights = (renderable->GetCastLights()) ? 1 : 0;
-
-                _instanceDataPool[currInstBlock][subElemIdx - lowerBlockBound] = data;
-                instancedObjectCounter++;
-
-                if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE* STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
-                    break;
             }
 
-            // We update per object and per instance buffer
-            sceneInfo.Renderables[idx]->UpdatePerInstanceBuffer(_instanceDataPool[currInstBlock], upperBlockBound - lowerBlockBound, currInstBlock);
-
             // We create all instanced render element using first RendererRenderable data
             for (auto& renderElem : sceneInfo.Renderables[idx]->Elements)
             {
@@ -468,7 +625,8 @@ namespace te
                 elem->AnimType = renderElem.AnimType;
                 elem->DefaultTechniqueIdx = renderElem.DefaultTechniqueIdx;
                 elem->Type = renderElem.Type;
-                elem->InstanceCount = (UINT32)(upperBlockBound - lowerBlockBound);
+                elem->InstanceCount = (UINT32)(upperBound - lowerBound);
+                elem->LODIdx = lod;
 
                 elem->GpuParamsElem.resize(renderElem.GpuParamsElem.size());
                 std::copy(renderElem.GpuParamsElem.begin(), renderElem.GpuParamsElem.end(), elem->GpuParamsElem.data());
@@ -485,13 +643,15 @@ namespace te
                     _forwardOpaqueQueue->Add(elem, distanceToCamera, techniqueIdx);
 
                 for (auto& gpuParams : renderElem.GpuParamsElem)
-                    gpuParams->SetParamBlockBuffer("PerInstanceBuffer", gPerInstanceParamBuffer[currInstBlock]);
+                {
+                    gpuParams->SetParamBlockBuffer("PerInstanceBuffer", instanceBuffer);
+                    gInstanceDataBuffer->Bind(gpuParams);
+                }
 
                 CheckIfDynamicEnvMappingNeeded(renderElem);
             }
 
-            if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE* STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
-                break;
+            lowerBound = upperBound;
         }
     }
 
@@ -541,8 +701,17 @@ namespace te
         gPerCameraParamDef.gViewDir.Set(_paramBuffer, _properties.ViewDirection);
         gPerCameraParamDef.gViewOrigin.Set(_paramBuffer, _properties.ViewOrigin);
 
-        gPerCameraParamDef.gViewportX.Set(_paramBuffer, static_cast<UINT32>(_camera->GetViewport()->GetArea().x));
-        gPerCameraParamDef.gViewportY.Set(_paramBuffer, static_cast<UINT32>(_camera->GetViewport()->GetArea().y));
+        // Manually constructed views (e.g. environment probe faces) have no camera
+        if (_camera)
+        {
+            gPerCameraParamDef.gViewportX.Set(_paramBuffer, static_cast<UINT32>(_camera->GetViewport()->GetArea().x));
+            gPerCameraParamDef.gViewportY.Set(_paramBuffer, static_cast<UINT32>(_camera->GetViewport()->GetArea().y));
+        }
+        else
+        {
+            gPerCameraParamDef.gViewportX.Set(_paramBuffer, static_cast<UINT32>(_properties.Target.ViewRect.x));
+            gPerCameraParamDef.gViewportY.Set(_paramBuffer, static_cast<UINT32>(_properties.Target.ViewRect.y));
+        }
 
         Vector4 ndcToUV = GetNDCToUV();
         gPerCameraParamDef.gClipToUVScaleOffset.Set(_paramBuffer, ndcToUV);
@@ -662,11 +831,30 @@ namespace te
         _visibility.Renderables.resize(sceneInfo.Renderables.size(), RenderableVisibility());
         _visibility.Renderables.assign(sceneInfo.Renderables.size(), RenderableVisibility());
 
-        for (UINT32 i = 0; i < numViews; i++)
+        if (_options->CombinedViewCulling && numViews > 1)
         {
-            _views[i]->DetermineVisible(sceneInfo.Renderables, sceneInfo.RenderableCullInfos, &_visibility.Renderables);
+            DetermineVisibilityCombined(sceneInfo);
+        }
+        else
+        {
+            for (UINT32 i = 0; i < numViews; i++)
+            {
+                _views[i]->DetermineVisible(sceneInfo.Renderables, sceneInfo.RenderableCullInfos, &_visibility.Renderables);
+            }
+        }
+
+#if TE_PROFILING_ENABLED
+        UINT32 numVisible = 0;
+        for (auto& visibility : _visibility.Renderables)
+        {
+            if (visibility.Visible)
+                numVisible++;
         }
 
+        TE_ADD_PROFILER_RENDERER(NumRenderables, (UINT32)sceneInfo.Renderables.size());
+        TE_ADD_PROFILER_RENDERER(NumVisibleRenderables, numVisible);
+#endif
+
         // Calculate light visibility for all views
         const auto numRadialLights = (UINT32)sceneInfo.RadialLights.size();
         _visibility.RadialLights.resize(numRadialLights, false);
@@ -700,7 +888,78 @@ namespace te
         // Note: I'm determining light visibility for the entire group. It might be more performance
         // efficient to do it per view. Additionally I'm using a single GPU buffer to hold their information, which is
         // then updated when each view group is rendered. It might be better to keep one buffer reserved per-view.
-        _visibleLightData.Update(sceneInfo, *this);
+        _visibleLightData.Update(sceneInfo, *this, *_options);
+    }
+
+    void RendererViewGroup::DetermineVisibilityCombined(const SceneInfo& sceneInfo)
+    {
+        const auto numRenderables = (UINT32)sceneInfo.Renderables.size();
+
+        // Find views rendering geometry, and a volume enclosing all of them
+        _cullViews.clear();
+
+        Sphere bounds;
+        UINT64 layers = 0;
+        for (auto& view : _views)
+        {
+            view->_visibility.Renderables.clear();
+            view->_visibility.Renderables.resize(numRenderables, RenderableVisibility());
+
+            if (!view->ShouldDraw3D())
+                continue;
+
+            view->UpdateVisibilityCache(numRenderables);
+
+            Sphere viewBounds = view->GetFrustumBoundingSphere();
+            if (_cullViews.empty())
+                bounds = viewBounds;
+            else
+                bounds.Merge(viewBounds);
+
+            layers |= view->GetProperties().VisibleLayers;
+            _cullViews.push_back(view);
+        }
+
+        UINT32 numCulled[4] = { 0, 0, 0, 0 };
+        const auto numCullViews = (UINT32)_cullViews.size();
+
+        // Renderables outside of the combined volume are rejected once for all views, the others are tested against
+        // each view in the same pass
+        for (UINT32 i = 0; i < numRenderables; i++)
+        {
+            const CullInfo& cullInfo = sceneInfo.RenderableCullInfos[i];
+            if ((cullInfo.Layer & layers) == 0)
+            {
+                numCulled[(UINT32)CullResult::CulledByLayer] += numCullViews;
+                continue;
+            }
+
+            if (!bounds.Intersects(cullInfo.Boundaries.GetSphere()))
+            {
+                numCulled[(UINT32)CullResult::CulledByFrustum] += numCullViews;
+                continue;
+            }
+
+            const Renderable& renderable = *sceneInfo.Renderables[i]->RenderablePtr;
+            for (auto& view : _cullViews)
+            {
+                if (!view->AcceptsRenderable(renderable))
+                    continue;
+
+                const CullResult result = view->CullCached(i, cullInfo);
+                numCulled[(UINT32)result]++;
+
+                if (result != CullResult::Visible)
+                    continue;
+
+                view->_visibility.Renderables[i].Visible = true;
+                _visibility.Renderables[i].Visible = true;
+            }
+        }
+
+        TE_ADD_PROFILER_RENDERER(NumCulledByLayer, numCulled[(UINT32)CullResult::CulledByLayer]);
+        TE_ADD_PROFILER_RENDERER(NumCulledByDistance, numCulled[(UINT32)CullResult::CulledByDistance]);
+        TE_ADD_PROFILER_RENDERER(NumCulledByFrustum, numCulled[(UINT32)CullResult::CulledByFrustum]);
     }
 
     void RendererViewGroup::SetAllObjectsAsVisible(const SceneInfo& sceneInfo)
@@ -804,9 +1063,6 @@ namespace te
     {
         if (instancingMode == RenderManInstancing::Automatic || instancingMode == RenderManInstancing::Manual)
         {
-            const UINT32 maxInstElement = STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE * STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER;
-            UINT32 totalInstElem = 0;
-
             for (auto& element : view._instancedElements)
                 te_pool_delete<RenderableElement>(static_cast<RenderableElement*>(element));
 
@@ -814,13 +1070,6 @@ namespace te
 
             for (auto& instancedBuffer : RendererView::_instancedBuffersPool)
             {
-                totalInstElem += ((UINT32)instancedBuffer.Idx.size() / STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE + 1) * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
-                if (totalInstElem > maxInstElement)
-                {
-                    UINT32 amountInstToRemove = totalInstElem - maxInstElement;
-                    instancedBuffer.Idx.resize(instancedBuffer.Idx.size() - amountInstToRemove);
-                }
-
                 bool hasTransparentElement = false;
 
                 for (UINT32 i = 0; i < instancedBuffer.MaterialCount; i++)
@@ -844,20 +1093,17 @@ namespace te
                         }
                     }
 
-                    view.QueueRenderInstancedElements(sceneInfo, instancedBuffer);
+                    view.QueueRenderInstancedElements(sceneInfo, instancedBuffer, *_options);
                 }
-
-                if (totalInstElem > maxInstElement)
-                    break;
             }
 
             if (view.ShouldDraw3D())
-                view.QueueRenderElements(sceneInfo);
+                view.QueueRenderElements(sceneInfo, *_options);
         }
         else
         {
             if (view.ShouldDraw3D())
-                view.QueueRenderElements(sceneInfo);
+                view.QueueRenderElements(sceneInfo, *_options);
         }
     }
 
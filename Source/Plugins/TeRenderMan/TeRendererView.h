@@ -40,6 +40,12 @@ namespace te
 
         /** When enabled, post-processing effects (like tonemapping) will be executed. */
         bool RunPostProcessing = false;
+
+        /** If true, only renderables with UseForDynamicEnvMapping set are rendered (e.g. environment probe faces). */
+        bool DynamicEnvMappingOnly = false;
+
+        /** Renderable never rendered by this view (e.g. the renderable an environment probe is rendered for). */
+        const Renderable* ExcludedRenderable = nullptr;
     };
 
     /** Data shared between RENDERER_VIEW_TARGET_DESC and RendererViewTargetProperties */
@@ -67,7 +73,7 @@ namespace te
     struct RENDERER_VIEW_DESC : RendererViewData
     {
         RENDERER_VIEW_TARGET_DESC Target;
-        Camera* SceneCamera;
+        Camera* SceneCamera = nullptr;
 
         StateReduction ReductionMode;
     };
@@ -132,6 +138,21 @@ namespace te
         UINT64 Layer;
         Bounds Boundaries;
         float CullDistanceFactor;
+
+        /**
+         * Unique value assigned each time the information changes (e.g. the renderable moved). Views reuse their
+         * visibility results as long as it doesn't change.
+         */
+        UINT64 Version = 0;
+    };
+
+    /** Result of the culling of an object against a view. */
+    enum class CullResult : UINT8
+    {
+        Visible,
+        CulledByLayer, /**< None of the object layers is visible by the view. */
+        CulledByDistance, /**< Object is further than the cull distance. */
+        CulledByFrustum /**< Object is outside of the view frustum. */
     };
 
     /** Contains information about a single view into the scene, used by the renderer. */
@@ -225,6 +246,25 @@ namespace te
          */
         void CalculateVisibility(const Vector<CullInfo>& cullInfos, Vector<RenderableVisibility>& visibility) const;
 
+        /** Returns true if the object is on a visible layer, within cull distance and intersects the view frustum. */
+        bool IsVisible(const CullInfo& cullInfo) const { return Cull(cullInfo) == CullResult::Visible; }
+
+        /** Same as IsVisible(), but returns the reason why the object is not visible. */
+        CullResult Cull(const CullInfo& cullInfo) const;
+
+        /**
+         * Same as Cull(), but reuses the result computed for the renderable at index @p idx during a previous frame if
+         * neither the view nor the renderable cull information changed since. UpdateVisibilityCache() must have been
+         * called for the current frame.
+         */
+        CullResult CullCached(UINT32 idx, const CullInfo& cullInfo);
+
+        /** Returns the fraction of the viewport height covered by the provided bounds, once projected. */
+        float GetProjectedScreenSize(const Sphere& bounds) const;
+
+        /** Returns a world space sphere enclosing the view frustum, between the near and far planes. */
+        Sphere GetFrustumBoundingSphere() const;
+
         /**
          * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
          * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
@@ -242,14 +282,15 @@ namespace te
          * by calling determineVisible(). After the call render elements can be retrieved from the queues using
          * getOpaqueQueue or getTransparentQueue() calls.
          */
-        void QueueRenderElements(const SceneInfo& sceneInfo);
+        void QueueRenderElements(const SceneInfo& sceneInfo, const RenderManOptions& options);
 
         /**
          * Inserts all visible instanced renderable elements into render queues. Assumes visibility has been calculated beforehand
          * by calling determineVisible(). After the call render elements can be retrieved from the queues using
          * getOpaqueQueue or getTransparentQueue() calls.
          */
-        void QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffers);
+        void QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffers,
+            const RenderManOptions& options);
 
         /** Returns the visibility mask calculated with the last call to determineVisible(). */
         const VisibilityInfo& GetVisibilityInfo() const { return _visibility; }
@@ -309,6 +350,26 @@ namespace te
 
         void CheckIfDynamicEnvMappingNeeded(const RenderElement& element);
 
+        /** Returns false if the renderable is filtered out by the view (see RendererViewData::DynamicEnvMappingOnly). */
+        bool AcceptsRenderable(const Renderable& renderable) const;
+
+        /**
+         * Prepares cached visibility results for @p numRenderables renderables, and discards all of them if the view
+         * culls differently than when they were computed.
+         */
+        void UpdateVisibilityCache(UINT32 numRenderables);
+
+        /**
+         * Selects the level of detail of a renderable mesh, from the projected screen size of the renderable. In order to
+         * prevent popping, thresholds are moved away from the level of detail used during the previous frame.
+         *
+         * @param[in]	sceneInfo		Information about the scene.
+         * @param[in]	renderableIdx	Index of the renderable in @p sceneInfo.
+         * @param[in]	options			Renderer options providing LOD bias and hysteresis.
+         * @return						Level of detail to draw, 0 being the full detail mesh.
+         */
+        UINT32 SelectLOD(const SceneInfo& sceneInfo, UINT32 renderableIdx, const RenderManOptions& options);
+
     private:
         RendererViewProperties _properties;
         mutable RendererViewContext _context;
@@ -321,6 +382,23 @@ namespace te
         VisibilityInfo _visibility;
         UINT32 _viewIdx = 0;
 
+        // Internal ID of the renderable at each index and level of detail it used during the previous frame
+        Vector<std::pair<UINT64, UINT32>> _renderableLODs;
+
+        // Level of detail and renderable index of each instance of an instanced draw, kept in order to avoid allocations
+        Vector<std::pair<UINT32, UINT32>> _instanceLODs;
+
+        // Visibility of each renderable computed during previous frames, with the CullInfo::Version it has been computed
+        // for. Kept apart from _visibility which is modified once the render queues are generated.
+        Vector<CullResult> _cachedCullResults;
+        Vector<UINT64> _cachedCullVersions;
+
+        // View parameters cached visibility results are valid for
+        Matrix4 _cachedViewProj = Matrix4::ZERO;
+        Vector3 _cachedViewOrigin = Vector3::ZERO;
+        float _cachedCullDistance = 0.0f;
+        UINT64 _cachedVisibleLayers = 0;
+
         // On-demand drawing 
         // _redrawForFrames, _redrawForSeconds and _waitingOnAutoExposureFrame are not used because I don't manage auto exposure yet
         // TODO need to be used with auto exposure
@@ -337,7 +415,6 @@ namespace te
 
         Vector<RenderableElement*> _instancedElements; //Elements are updated every frame
 
-        static PerInstanceData _instanceDataPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
         static Vector<InstancedBuffer> _instancedBuffersPool;
 
         // Exposure
@@ -401,12 +478,21 @@ namespace te
     private:
         friend class RenderView;
 
+        /**
+         * Culls renderables against all the views at once (see RenderManOptions::CombinedViewCulling). Objects are first
+         * tested against a sphere enclosing every view frustum, and only the ones inside it are tested against each view.
+         */
+        void DetermineVisibilityCombined(const SceneInfo& sceneInfo);
+
     private:
         SPtr<RenderManOptions> _options;
         Vector<RendererView*> _views;
         VisibilityInfo _visibility;
 
         VisibleLightData _visibleLightData;
+
+        // Temporary buffer, kept in order to avoid allocations every frame
+        Vector<RendererView*> _cullViews;
     };
 
     IMPLEMENT_GLOBAL_POOL(RenderableElement, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE)
@@ -0,0 +1,122 @@
+#include "TeShadowCascades.h"
+#include "TeRendererView.h"
+
+namespace te
+{
+    /** Cascade radius is rounded up to a multiple of 1 / CASCADE_RADIUS_QUANTIZATION to avoid precision flickering. */
+    static const float CASCADE_RADIUS_QUANTIZATION = 16.0f;
+
+    INT32 ShadowCascades::SelectCascade(const LightShadowInfo& shadows, float viewDepth)
+    {
+        for (UINT32 i = 0; i < (UINT32)shadows.Maps.size(); i++)
+        {
+            if (viewDepth < shadows.Maps[i].SplitFar)
+                return (INT32)i;
+        }
+
+        return -1;
+    }
+
+    float ShadowCascades::GetSplitDistance(UINT32 idx, UINT32 numCascades, float nearDist, float farDist, float exponent)
+    {
+        // Each cascade covers a depth range @p exponent times larger than the previous one
+        float total = 0.0f;
+        float partial = 0.0f;
+        float scale = 1.0f;
+
+        for (UINT32 i = 0; i < numCascades; i++)
+        {
+            if (i < idx)
+                partial += scale;
+
+            total += scale;
+            scale *= exponent;
+        }
+
+        return nearDist + (farDist - nearDist) * (partial / total);
+    }
+
+    Sphere ShadowCascades::GetSliceBounds(const Matrix4& projTransform, ProjectionType projType, const Matrix4& invView,
+        float sliceNear, float sliceFar)
+    {
+        // Half size of the view frustum at a depth of one (perspective) or at any depth (orthographic)
+        const float halfWidth = 1.0f / std::abs(projTransform[0][0]);
+        const float halfHeight = 1.0f / std::abs(projTransform[1][1]);
+        const bool perspective = projType == PT_PERSPECTIVE;
+
+        Vector3 corners[8];
+        for (UINT32 i = 0; i < 2; i++)
+        {
+            const float depth = i == 0 ? sliceNear : sliceFar;
+            const float scale = perspective ? depth : 1.0f;
+
+            corners[i * 4 + 0] = Vector3(-halfWidth * scale, -halfHeight * scale, -depth);
+            corners[i * 4 + 1] = Vector3(halfWidth * scale, -halfHeight * scale, -depth);
+            corners[i * 4 + 2] = Vector3(halfWidth * scale, halfHeight * scale, -depth);
+            corners[i * 4 + 3] = Vector3(-halfWidth * scale, halfHeight * scale, -depth);
+        }
+
+        Vector3 center = Vector3::ZERO;
+        for (auto& corner : corners)
+            center += corner;
+
+        center /= 8.0f;
+
+        float radius = 0.0f;
+        for (auto& corner : corners)
+            radius = std::max(radius, center.Distance(corner));
+
+        radius = std::ceil(radius * CASCADE_RADIUS_QUANTIZATION) / CASCADE_RADIUS_QUANTIZATION;
+        return Sphere(invView.MultiplyAffine(center), radius);
+    }
+
+    Vector3 ShadowCascades::SnapToTexels(const Vector3& center, float radius, const Quaternion& lightRotation,
+        UINT32 shadowMapSize)
+    {
+        const Matrix4 lightView = Matrix4::View(Vector3::ZERO, lightRotation);
+        const float texelSize = (2.0f * radius) / (float)std::max(shadowMapSize, 1U);
+
+        Vector3 lightSpaceCenter = lightView.MultiplyAffine(center);
+        lightSpaceCenter.x = std::floor(lightSpaceCenter.x / texelSize) * texelSize;
+        lightSpaceCenter.y = std::floor(lightSpaceCenter.y / texelSize) * texelSize;
+
+        return lightView.InverseAffine().MultiplyAffine(lightSpaceCenter);
+    }
+
+    ConvexVolume ShadowCascades::GetCasterVolume(const Vector3& center, float radius, const Quaternion& lightRotation)
+    {
+        const Vector3 right = lightRotation.XAxis();
+        const Vector3 up = lightRotation.YAxis();
+        const Vector3 back = lightRotation.ZAxis(); // Points toward the light
+
+        Vector<Plane> planes;
+        planes.reserve(5);
+
+        planes.push_back(Plane(right, right.Dot(center) - radius));
+        planes.push_back(Plane(-right, -right.Dot(center) - radius));
+        planes.push_back(Plane(up, up.Dot(center) - radius));
+        planes.push_back(Plane(-up, -up.Dot(center) - radius));
+        planes.push_back(Plane(back, back.Dot(center) - radius));
+
+        return ConvexVolume(planes);
+    }
+
+    void ShadowCascades::CullCasters(const Vector<CullInfo>& cullInfos, const ConvexVolume& volume,
+        const Vector<UINT32>& candidates, Vector<UINT32>& output)
+    {
+        output.clear();
+        for (auto& idx : candidates)
+        {
+            const Bounds& bounds = cullInfos[idx].Boundaries;
+
+            // Cheap sphere test first, most casters are rejected by it
+            if (!volume.Intersects(bounds.GetSphere()))
+                continue;
+
+            if (!volume.Intersects(bounds.GetBox()))
+                continue;
+
+            output.push_back(idx);
+        }
+    }
+}
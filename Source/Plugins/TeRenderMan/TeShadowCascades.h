@@ -0,0 +1,102 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeConvexVolume.h"
+#include "Math/TeSphere.h"
+#include "Math/TeQuaternion.h"
+
+namespace te
+{
+    struct CullInfo;
+    class RendererLight;
+
+    /** Information required to render a single shadow map (a cascade of a directional light, or a spot light). */
+    struct ShadowMapInfo
+    {
+        Matrix4 ViewTransform = Matrix4::IDENTITY;
+        Matrix4 ProjTransform = Matrix4::IDENTITY;
+        Matrix4 ViewProjTransform = Matrix4::IDENTITY;
+
+        /** World space volume a renderable must intersect in order to cast a shadow in this map. */
+        ConvexVolume CasterVolume;
+
+        /** Indices (in SceneInfo::Renderables) of the renderables to draw in this map. */
+        Vector<UINT32> Casters;
+
+        /** Range of view depth covered by the map. Only relevant for directional light cascades. */
+        float SplitNear = 0.0f;
+        float SplitFar = 0.0f;
+    };
+
+    /** Shadow maps of a single light. */
+    struct LightShadowInfo
+    {
+        const RendererLight* Light = nullptr;
+
+        /** One map per cascade for directional lights, a single map for spot lights. */
+        Vector<ShadowMapInfo> Maps;
+    };
+
+    /**
+     * Math required to fit directional light cascades and to cull shadow casters, for a shadow pass to use. Doesn't
+     * depend on any renderer state.
+     */
+    class ShadowCascades
+    {
+    public:
+        /**
+         * Returns the index of the cascade to sample for a point at the provided view depth, or -1 if the point is
+         * beyond the last cascade.
+         */
+        static INT32 SelectCascade(const LightShadowInfo& shadows, float viewDepth);
+
+        /**
+         * Returns the view depth at which the cascade @p idx starts. @p idx equal to @p numCascades returns the end of
+         * the last cascade.
+         *
+         * @param[in]	idx				Index of the cascade.
+         * @param[in]	numCascades		Number of cascades.
+         * @param[in]	nearDist		View depth at which the first cascade starts.
+         * @param[in]	farDist			View depth at which the last cascade ends.
+         * @param[in]	exponent		Ratio between the depth ranges of two consecutive cascades.
+         */
+        static float GetSplitDistance(UINT32 idx, UINT32 numCascades, float nearDist, float farDist, float exponent);
+
+        /**
+         * Returns a world space sphere enclosing the slice of a view frustum between two view depths. Its radius only
+         * depends on the shape of the slice, not on the view orientation, so the shadow map resolution of a cascade
+         * stays the same when the view rotates.
+         *
+         * @param[in]	projTransform	Projection matrix of the view.
+         * @param[in]	projType		Projection type of the view.
+         * @param[in]	invView			Inverse of the view matrix.
+         * @param[in]	sliceNear		View depth at which the slice starts.
+         * @param[in]	sliceFar		View depth at which the slice ends.
+         */
+        static Sphere GetSliceBounds(const Matrix4& projTransform, ProjectionType projType, const Matrix4& invView,
+            float sliceNear, float sliceFar);
+
+        /**
+         * Moves the center of a cascade on the texel grid of its shadow map, in the plane perpendicular to the light
+         * direction, so shadow edges don't shimmer when the view moves.
+         *
+         * @param[in]	center			World space center of the cascade.
+         * @param[in]	radius			Radius of the cascade.
+         * @param[in]	lightRotation	Rotation of the light.
+         * @param[in]	shadowMapSize	Width and height of the shadow map, in texels.
+         */
+        static Vector3 SnapToTexels(const Vector3& center, float radius, const Quaternion& lightRotation,
+            UINT32 shadowMapSize);
+
+        /**
+         * Returns the volume a renderable must intersect in order to cast shadows in a directional light cascade. Casters
+         * can be anywhere between the light and the receivers, so the volume has no plane on the light side.
+         */
+        static ConvexVolume GetCasterVolume(const Vector3& center, float radius, const Quaternion& lightRotation);
+
+        /** Outputs the @p candidates (indices in @p cullInfos) intersecting @p volume. */
+        static void CullCasters(const Vector<CullInfo>& cullInfos, const ConvexVolume& volume,
+            const Vector<UINT32>& candidates, Vector<UINT32>& output);
+    };
+}
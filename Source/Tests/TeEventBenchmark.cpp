@@ -0,0 +1,272 @@
+#include "TeTestUtility.h"
+#include "Utility/TeEvent.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+using namespace te;
+
+/** Receiver of the events, called through a bound method. */
+class Listener
+{
+public:
+    void OnValue(UINT32 value)
+    {
+        Sum += value;
+    }
+
+    UINT64 Sum = 0;
+};
+
+/**
+ * Triggering path of the mutex based event that Event replaced: a recursive lock around a linked list of std::function.
+ * Only used to compare invocation costs.
+ */
+template <class... Args>
+class BaselineEvent
+{
+    struct Connection
+    {
+        std::function<void(Args...)> Function;
+        Connection* Next = nullptr;
+    };
+
+    struct Data
+    {
+        ~Data()
+        {
+            while (Connections != nullptr)
+            {
+                Connection* next = Connections->Next;
+                te_delete(Connections);
+                Connections = next;
+            }
+        }
+
+        Connection* Connections = nullptr;
+        Connection* LastConnection = nullptr;
+        Connection* NewConnections = nullptr;
+        RecursiveMutex Mutex;
+        bool IsCurrentlyTriggering = false;
+    };
+
+public:
+    void Connect(std::function<void(Args...)> function)
+    {
+        RecursiveLock lock(_data->Mutex);
+
+        Connection* connection = te_new<Connection>();
+        connection->Function = std::move(function);
+
+        if (_data->LastConnection != nullptr)
+            _data->LastConnection->Next = connection;
+        else
+            _data->Connections = connection;
+
+        _data->LastConnection = connection;
+    }
+
+    void operator() (Args... args)
+    {
+        SPtr<Data> data = _data;
+
+        RecursiveLock lock(data->Mutex);
+        data->IsCurrentlyTriggering = true;
+
+        Connection* connection = data->Connections;
+        while (connection != nullptr)
+        {
+            Connection* next = connection->Next;
+
+            if (connection->Function != nullptr)
+                connection->Function(std::forward<Args>(args)...);
+
+            connection = next;
+        }
+
+        data->IsCurrentlyTriggering = false;
+        if (data->NewConnections != nullptr)
+            data->NewConnections = nullptr;
+    }
+
+private:
+    SPtr<Data> _data = te_shared_ptr_new<Data>();
+};
+
+/** Disconnects a handle when the last copy of the callback owning it is destroyed. */
+struct DisconnectOnDestroy
+{
+    ~DisconnectOnDestroy()
+    {
+        Handle.Disconnect();
+    }
+
+    HEvent Handle;
+};
+
+/** Callbacks can disconnect themselves and others while the event is triggered, and destroying them can disconnect. */
+static void TestReentrancy()
+{
+    Event<void(UINT32)> event;
+    UINT32 numCalls[3] = { 0, 0, 0 };
+
+    HEvent first;
+    HEvent second;
+    first = event.Connect([&numCalls, &first, &second](UINT32)
+    {
+        numCalls[0]++;
+        first.Disconnect();
+        second.Disconnect();
+    });
+
+    // Destroying the second callback disconnects the last one, once the event releases the removed callbacks
+    HEvent last = event.Connect([&numCalls](UINT32) { numCalls[2]++; });
+    SPtr<DisconnectOnDestroy> guard = te_shared_ptr_new<DisconnectOnDestroy>();
+    guard->Handle = last;
+    last = HEvent();
+
+    second = event.Connect([&numCalls, guard](UINT32) { numCalls[1]++; });
+    guard = nullptr;
+
+    event(1);
+    TE_TEST_CHECK(numCalls[0] == 1 && numCalls[1] == 0 && numCalls[2] == 1);
+
+    event(2);
+    TE_TEST_CHECK(numCalls[0] == 1 && numCalls[1] == 0 && numCalls[2] == 1);
+    TE_TEST_CHECK(event.Empty());
+}
+
+/** A callback can delete the event triggering it, even from a nested trigger. Later callbacks aren't called. */
+static void TestDeleteFromCallback()
+{
+    Event<void(UINT32)>* event = te_new<Event<void(UINT32)>>();
+    UINT32 numCalls[2] = { 0, 0 };
+
+    HEvent first = event->Connect([&event, &numCalls](UINT32 depth)
+    {
+        numCalls[0]++;
+
+        if (depth == 0)
+            (*event)(1);
+        else
+            te_delete(event);
+    });
+
+    event->Connect([&numCalls](UINT32) { numCalls[1]++; });
+
+    (*event)(0);
+    TE_TEST_CHECK(numCalls[0] == 2 && numCalls[1] == 0);
+
+    // The handle outlives the event
+    first.Disconnect();
+}
+
+/** Once Disconnect() returns on a thread, callbacks triggered on another thread aren't called anymore. */
+static void TestDisconnectFromOtherThread()
+{
+    const UINT32 numIterations = 2000;
+
+    Event<void(UINT32)> event;
+    std::atomic<bool> stop{ false };
+    std::atomic<UINT32> numLateCalls{ 0 };
+
+    std::thread invoker([&event, &stop]()
+    {
+        while (!stop.load())
+            event(1);
+    });
+
+    for (UINT32 i = 0; i < numIterations; i++)
+    {
+        std::atomic<bool> disconnected{ false };
+        std::atomic<UINT32> numCalls{ 0 };
+
+        HEvent handle = event.Connect([&disconnected, &numCalls, &numLateCalls](UINT32)
+        {
+            numCalls.fetch_add(1);
+
+            // Widens the window between the call starting and the flag being read
+            for (volatile UINT32 j = 0; j < 100; j++)
+            { }
+
+            if (disconnected.load())
+                numLateCalls.fetch_add(1);
+        });
+
+        while (numCalls.load() == 0)
+            std::this_thread::yield();
+
+        handle.Disconnect();
+        disconnected.store(true);
+    }
+
+    stop.store(true);
+    invoker.join();
+
+    TE_TEST_CHECK(numLateCalls.load() == 0);
+}
+
+/** Returns the time taken by @p numTriggers triggers of @p event, per called callback, in nanoseconds. */
+template <class E>
+static double MeasureInvocation(E& event, UINT32 numTriggers, UINT32 numConnections)
+{
+    const double ms = Test::Measure([&]()
+    {
+        for (UINT32 i = 0; i < numTriggers; i++)
+            event(i);
+    });
+
+    return ms * 1e6 / ((double)numTriggers * numConnections);
+}
+
+/** Measures the cost of triggering an event, per called callback, next to the cost of the event it replaced. */
+static void BenchmarkInvocation(UINT32 numConnections)
+{
+    const UINT32 numCallbacks = 4000000;
+    const UINT32 numTriggers = numCallbacks / numConnections;
+
+    UINT64 lambdaSum = 0;
+    UINT64 baselineLambdaSum = 0;
+    Listener listener;
+    Listener baselineListener;
+
+    Event<void(UINT32)> lambdaEvent;
+    Event<void(UINT32)> methodEvent;
+    BaselineEvent<UINT32> baselineLambdaEvent;
+    BaselineEvent<UINT32> baselineMethodEvent;
+    Vector<HEvent> handles;
+
+    for (UINT32 i = 0; i < numConnections; i++)
+    {
+        handles.push_back(lambdaEvent.Connect([&lambdaSum](UINT32 value) { lambdaSum += value; }));
+        handles.push_back(methodEvent.Connect(std::bind(&Listener::OnValue, &listener, std::placeholders::_1)));
+
+        baselineLambdaEvent.Connect([&baselineLambdaSum](UINT32 value) { baselineLambdaSum += value; });
+        baselineMethodEvent.Connect(std::bind(&Listener::OnValue, &baselineListener, std::placeholders::_1));
+    }
+
+    const double lambdaNs = MeasureInvocation(lambdaEvent, numTriggers, numConnections);
+    const double methodNs = MeasureInvocation(methodEvent, numTriggers, numConnections);
+    const double baselineLambdaNs = MeasureInvocation(baselineLambdaEvent, numTriggers, numConnections);
+    const double baselineMethodNs = MeasureInvocation(baselineMethodEvent, numTriggers, numConnections);
+
+    TE_TEST_CHECK(lambdaSum == listener.Sum);
+    TE_TEST_CHECK(lambdaSum == baselineLambdaSum && listener.Sum == baselineListener.Sum);
+
+    printf("%3u connections, ns per callback: lambda %6.2f (baseline %6.2f), method %6.2f (baseline %6.2f)\n",
+        numConnections, lambdaNs, baselineLambdaNs, methodNs, baselineMethodNs);
+}
+
+int main()
+{
+    TestReentrancy();
+    TestDeleteFromCallback();
+    TestDisconnectFromOtherThread();
+
+    BenchmarkInvocation(1);
+    BenchmarkInvocation(4);
+    BenchmarkInvocation(16);
+
+    return Test::GetResult();
+}
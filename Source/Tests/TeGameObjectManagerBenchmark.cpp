@@ -0,0 +1,217 @@
+#include "TeTestUtility.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Scene/TeGameObjectPool.h"
+
+#include <atomic>
+#include <random>
+
+using namespace te;
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+// Sanitizers intercept malloc() themselves
+#define TE_COUNT_ALLOCATIONS 0
+#elif defined(__GLIBC__)
+// Counts heap allocations. te_allocate() and operator new both end up calling malloc().
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_memalign(size_t alignment, size_t size);
+
+static std::atomic<UINT64> NumAllocations{ 0 };
+
+extern "C" void* malloc(size_t size)
+{
+    NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size)
+{
+    NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+#define TE_COUNT_ALLOCATIONS 1
+#else
+#define TE_COUNT_ALLOCATIONS 0
+#endif
+
+/** Game object without any logic, unregistered from the manager when destroyed. */
+class BenchmarkObject : public GameObject
+{
+public:
+    static GameObjectHandle<BenchmarkObject> Create()
+    {
+        SPtr<BenchmarkObject> object = te_game_object_shared_ptr(
+            new (te_game_object_allocate<BenchmarkObject>()) BenchmarkObject());
+
+        return static_object_cast<BenchmarkObject>(GameObjectManager::Instance().RegisterObject(object));
+    }
+
+    UINT32 Value = 0;
+
+protected:
+    void DestroyInternal(GameObjectHandleBase& handle, bool immediate) override
+    {
+        GameObjectManager::Instance().UnregisterObject(handle);
+    }
+};
+
+typedef GameObjectHandle<BenchmarkObject> HBenchmarkObject;
+
+/** Handles and IDs of destroyed objects must not resolve to the objects reusing their slots. */
+static void TestSlotReuse()
+{
+    HBenchmarkObject first = BenchmarkObject::Create();
+    const UINT64 firstId = first->GetInstanceId();
+
+    GameObjectManager::Instance().QueueForDestroy(first);
+    GameObjectManager::Instance().QueueForDestroy(first); // Queued twice, destroyed once
+    GameObjectManager::Instance().DestroyQueuedObjects();
+
+    HBenchmarkObject second = BenchmarkObject::Create();
+
+    TE_TEST_CHECK(first.IsDestroyed());
+    TE_TEST_CHECK(!second.IsDestroyed());
+    TE_TEST_CHECK(second->GetInstanceId() != firstId);
+    TE_TEST_CHECK(!GameObjectManager::Instance().ObjectExists(firstId));
+    TE_TEST_CHECK(GameObjectManager::Instance().GetObjectHandle(firstId).IsDestroyed());
+    TE_TEST_CHECK(GameObjectManager::Instance().GetObjectHandle(second->GetInstanceId()).Get() == second.Get());
+
+    GameObjectManager::Instance().QueueForDestroy(second);
+    GameObjectManager::Instance().DestroyQueuedObjects();
+}
+
+/** Restoring the instance data of a destroyed object updates all the handles to the object taking it. */
+static void TestRemap()
+{
+    HBenchmarkObject original = BenchmarkObject::Create();
+    HBenchmarkObject originalCopy = original;
+    GameObjectInstanceDataPtr originalData = original->_getInstanceData();
+
+    GameObjectManager::Instance().QueueForDestroy(original);
+    GameObjectManager::Instance().DestroyQueuedObjects();
+
+    HBenchmarkObject restored = BenchmarkObject::Create();
+    HBenchmarkObject restoredCopy = restored;
+    restored->_setInstanceData(originalData);
+
+    const UINT64 id = originalData->InstanceId;
+    TE_TEST_CHECK(restored->GetInstanceId() == id);
+    TE_TEST_CHECK(restoredCopy.GetInstanceId() == id);
+    TE_TEST_CHECK(originalCopy.Get() == restored.Get());
+
+    HBenchmarkObject found = static_object_cast<BenchmarkObject>(GameObjectManager::Instance().GetObjectHandle(id));
+    TE_TEST_CHECK(found.Get() == restored.Get());
+
+    GameObjectManager::Instance().QueueForDestroy(restored);
+    GameObjectManager::Instance().DestroyQueuedObjects();
+    TE_TEST_CHECK(restoredCopy.IsDestroyed());
+}
+
+/**
+ * Measures object churn: every frame, a part of the live objects is destroyed and replaced by new ones. Then measures
+ * resolving all the live objects from their IDs.
+ */
+static void BenchmarkChurn(UINT32 numObjects, UINT32 numReplacedPerFrame)
+{
+    const UINT32 numFrames = 200;
+    const UINT32 numRuns = 3;
+
+    std::mt19937 random(1234);
+    Vector<HBenchmarkObject> objects;
+
+    GameObjectManager::Instance().Reserve(numObjects);
+    for (UINT32 i = 0; i < numObjects; i++)
+        objects.push_back(BenchmarkObject::Create());
+
+    const double churnMs = Test::Measure([&]()
+    {
+        for (UINT32 frame = 0; frame < numFrames; frame++)
+        {
+            for (UINT32 i = 0; i < numReplacedPerFrame; i++)
+            {
+                HBenchmarkObject& object = objects[random() % numObjects];
+                GameObjectManager::Instance().QueueForDestroy(object);
+                object = BenchmarkObject::Create();
+            }
+
+            GameObjectManager::Instance().DestroyQueuedObjects();
+        }
+    }, numRuns);
+
+    Vector<UINT64> ids;
+    for (auto& object : objects)
+        ids.push_back(object->GetInstanceId());
+
+    UINT32 numResolved = 0;
+    const double resolveMs = Test::Measure([&]()
+    {
+        for (auto& id : ids)
+        {
+            GameObjectHandleBase object = GameObjectManager::Instance().GetObjectHandle(id);
+            if (!object.IsDestroyed())
+            {
+                static_cast<BenchmarkObject*>(object.Get())->Value++;
+                numResolved++;
+            }
+        }
+    }, numRuns);
+
+    TE_TEST_CHECK(numResolved == numObjects * numRuns);
+
+    printf("%6u objects, %5u replaced/frame: %8.1f ns per spawn and destroy, %6.2f ns per resolve\n",
+        numObjects, numReplacedPerFrame, churnMs * 1e6 / ((double)numFrames * numReplacedPerFrame),
+        resolveMs * 1e6 / numObjects);
+
+    for (auto& object : objects)
+        GameObjectManager::Instance().QueueForDestroy(object);
+
+    GameObjectManager::Instance().DestroyQueuedObjects();
+}
+
+/** Counts the heap allocations made when spawning and destroying objects, once pools have been filled. */
+static void MeasureSpawnAllocations()
+{
+#if TE_COUNT_ALLOCATIONS
+    const UINT32 numObjects = 1000;
+    Vector<HBenchmarkObject> objects(numObjects);
+
+    auto spawnAndDestroy = [&objects]()
+    {
+        for (auto& object : objects)
+            object = BenchmarkObject::Create();
+
+        for (auto& object : objects)
+            GameObjectManager::Instance().QueueForDestroy(object);
+
+        GameObjectManager::Instance().DestroyQueuedObjects();
+    };
+
+    // Pools and arrays of the manager grow during the first frame only
+    spawnAndDestroy();
+
+    const UINT64 start = NumAllocations.load();
+    spawnAndDestroy();
+    const UINT64 numAllocations = NumAllocations.load() - start;
+
+    printf("%.2f heap allocations per spawn and destroy\n", (double)numAllocations / numObjects);
+#else
+    printf("Heap allocations are only counted with glibc\n");
+#endif
+}
+
+int main()
+{
+    GameObjectManager::StartUp();
+
+    TestSlotReuse();
+    TestRemap();
+
+    BenchmarkChurn(1000, 100);
+    BenchmarkChurn(10000, 1000);
+    BenchmarkChurn(100000, 1000);
+    MeasureSpawnAllocations();
+
+    GameObjectManager::ShutDown();
+
+    return Test::GetResult();
+}
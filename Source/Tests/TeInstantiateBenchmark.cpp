@@ -0,0 +1,101 @@
+#include "TeTestUtility.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Scene/TeSceneManager.h"
+#include "Scene/TeSceneObject.h"
+#include "Components/TeCBone.h"
+
+using namespace te;
+
+/** Number of nodes of the prefab, each one with a component. */
+static const UINT32 NUM_PREFAB_NODES = 50;
+
+/** Creates a prefab of NUM_PREFAB_NODES nodes, each node having up to three children. */
+static HSceneObject CreatePrefab()
+{
+    Vector<HSceneObject> nodes;
+    nodes.reserve(NUM_PREFAB_NODES);
+
+    for (UINT32 i = 0; i < NUM_PREFAB_NODES; i++)
+    {
+        HSceneObject node = SceneObject::Create("Node" + ToString(i));
+        if (i > 0)
+            node->SetParent(nodes[(i - 1) / 3]);
+
+        node->SetPosition(Vector3((float)i, 0.0f, 1.0f));
+        node->AddComponent<CBone>()->Initialize();
+
+        nodes.push_back(node);
+    }
+
+    return nodes[0];
+}
+
+/** Copies a node and its descendants one object and one component at a time, like a scene built by hand. */
+static HSceneObject CopyNodeByNode(const HSceneObject& source, const HSceneObject& parent)
+{
+    HSceneObject node = SceneObject::Create(source->GetName());
+    if (parent != nullptr)
+        node->SetParent(parent);
+
+    Transform transform = source->GetLocalTransform();
+    node->SetLocalTransform(transform);
+    node->AddComponent<CBone>()->Initialize();
+
+    for (auto& child : source->GetChildren())
+        CopyNodeByNode(child, node);
+
+    return node;
+}
+
+/** Returns the time taken by the fastest of @p numRuns calls to @p copy, destroying the copies after each run. */
+template<class F>
+static double MeasureCopies(F&& copy, UINT32 numCopies, UINT32 numRuns = 5)
+{
+    double best = std::numeric_limits<double>::max();
+    for (UINT32 run = 0; run < numRuns; run++)
+    {
+        Vector<HSceneObject> copies;
+        best = std::min(best, Test::Measure([&]() { copies = copy(); }, 1));
+
+        TE_TEST_CHECK((UINT32)copies.size() == numCopies);
+        TE_TEST_CHECK(gSceneManager().GetNumComponents<CBone>() == (numCopies + 1) * NUM_PREFAB_NODES);
+
+        for (auto& object : copies)
+            object->Destroy(true);
+    }
+
+    return best;
+}
+
+/** Measures creating 1000 copies of a 50 nodes prefab with SceneObject::Instantiate(), and node by node. */
+int main()
+{
+    GameObjectManager::StartUp();
+    SceneManager::StartUp();
+
+    const UINT32 numCopies = 1000;
+    HSceneObject prefab = CreatePrefab();
+
+    const double instantiateMs = MeasureCopies([&]() { return SceneObject::Instantiate(prefab, numCopies); }, numCopies);
+
+    const double nodeByNodeMs = MeasureCopies([&]()
+    {
+        Vector<HSceneObject> copies;
+        for (UINT32 i = 0; i < numCopies; i++)
+            copies.push_back(CopyNodeByNode(prefab, HSceneObject()));
+
+        return copies;
+    }, numCopies);
+
+    const double numNodes = (double)numCopies * NUM_PREFAB_NODES;
+    printf("%u copies of %u nodes: Instantiate() %8.2f ms (%6.1f ns/node), node by node %8.2f ms (%6.1f ns/node)\n",
+        numCopies, NUM_PREFAB_NODES, instantiateMs, instantiateMs * 1e6 / numNodes, nodeByNodeMs,
+        nodeByNodeMs * 1e6 / numNodes);
+
+    prefab->Destroy(true);
+
+    SceneManager::ShutDown();
+    GameObjectManager::ShutDown();
+
+    return Test::GetResult();
+}
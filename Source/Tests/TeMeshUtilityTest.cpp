@@ -0,0 +1,169 @@
+#include "TeTestUtility.h"
+#include "Mesh/TeMeshUtility.h"
+#include "Math/TeVector3.h"
+#include "Math/TeMath.h"
+
+using namespace te;
+
+/** Creates a closed sphere made of @p numRings rings of @p numSegments vertices, plus the two poles. */
+static void CreateSphere(UINT32 numRings, UINT32 numSegments, Vector<Vector3>& vertices, Vector<UINT32>& indices)
+{
+    vertices.push_back(Vector3(0.0f, 1.0f, 0.0f));
+    for (UINT32 ring = 1; ring <= numRings; ring++)
+    {
+        const float theta = Math::PI * ring / (float)(numRings + 1);
+        for (UINT32 segment = 0; segment < numSegments; segment++)
+        {
+            const float phi = Math::TWO_PI * segment / (float)numSegments;
+            vertices.push_back(Vector3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi)));
+        }
+    }
+    vertices.push_back(Vector3(0.0f, -1.0f, 0.0f));
+
+    const auto ringVertex = [numSegments](UINT32 ring, UINT32 segment) { return 1 + ring * numSegments + segment % numSegments; };
+    const auto lastVertex = (UINT32)vertices.size() - 1;
+
+    for (UINT32 segment = 0; segment < numSegments; segment++)
+    {
+        indices.insert(indices.end(), { 0, ringVertex(0, segment + 1), ringVertex(0, segment) });
+        indices.insert(indices.end(), { lastVertex, ringVertex(numRings - 1, segment), ringVertex(numRings - 1, segment + 1) });
+
+        for (UINT32 ring = 0; ring + 1 < numRings; ring++)
+        {
+            const UINT32 a = ringVertex(ring, segment), b = ringVertex(ring, segment + 1);
+            const UINT32 c = ringVertex(ring + 1, segment), d = ringVertex(ring + 1, segment + 1);
+            indices.insert(indices.end(), { a, b, c, b, d, c });
+        }
+    }
+}
+
+/** Checks that a simplified triangle list only contains valid, non degenerate triangles. */
+static bool IsValidTriangleList(const Vector<UINT32>& indices, UINT32 numVertices)
+{
+    if (indices.size() % 3 != 0)
+        return false;
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        if (indices[i] >= numVertices || indices[i + 1] >= numVertices || indices[i + 2] >= numVertices)
+            return false;
+
+        if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2])
+            return false;
+    }
+
+    return true;
+}
+
+static void TestReductionRatios()
+{
+    Vector<Vector3> vertices;
+    Vector<UINT32> indices;
+    CreateSphere(24, 32, vertices, indices);
+
+    const auto numVertices = (UINT32)vertices.size();
+    const auto numIndices = (UINT32)indices.size();
+
+    for (float ratio : { 0.75f, 0.5f, 0.25f, 0.1f })
+    {
+        const UINT32 target = (UINT32)(numIndices / 3 * ratio) * 3;
+
+        Vector<UINT32> output;
+        MeshUtility::Simplify(vertices.data(), numVertices, (const UINT8*)indices.data(), numIndices, target, output);
+
+        TE_TEST_CHECK(IsValidTriangleList(output, numVertices));
+
+        // Each collapse removes two triangles of a closed mesh, so the target is reached within a collapse
+        TE_TEST_CHECK(output.size() <= target);
+        TE_TEST_CHECK(output.size() + 6 >= target);
+    }
+
+    // A target larger than the mesh keeps it as is
+    Vector<UINT32> output;
+    MeshUtility::Simplify(vertices.data(), numVertices, (const UINT8*)indices.data(), numIndices, numIndices * 2, output);
+    TE_TEST_CHECK(output == indices);
+}
+
+static void TestBordersAreKept()
+{
+    // Flat grid, only its interior can be simplified
+    const UINT32 size = 16;
+
+    Vector<Vector3> vertices;
+    for (UINT32 y = 0; y < size; y++)
+    {
+        for (UINT32 x = 0; x < size; x++)
+            vertices.push_back(Vector3((float)x, 0.0f, (float)y));
+    }
+
+    Vector<UINT16> indices;
+    for (UINT32 y = 0; y + 1 < size; y++)
+    {
+        for (UINT32 x = 0; x + 1 < size; x++)
+        {
+            const auto a = (UINT16)(y * size + x);
+            const auto b = (UINT16)(a + 1), c = (UINT16)(a + size), d = (UINT16)(a + size + 1);
+            indices.insert(indices.end(), { a, c, b, b, c, d });
+        }
+    }
+
+    Vector<UINT32> output;
+    MeshUtility::Simplify(vertices.data(), (UINT32)vertices.size(), (const UINT8*)indices.data(), (UINT32)indices.size(),
+        0, output, sizeof(UINT16));
+
+    TE_TEST_CHECK(IsValidTriangleList(output, (UINT32)vertices.size()));
+    TE_TEST_CHECK(output.size() < indices.size() / 4);
+
+    // All border vertices are still used, and the grid is still entirely covered
+    Vector<bool> used(vertices.size(), false);
+    for (auto& index : output)
+        used[index] = true;
+
+    for (UINT32 i = 0; i < size; i++)
+    {
+        TE_TEST_CHECK(used[i] && used[(size - 1) * size + i]);
+        TE_TEST_CHECK(used[i * size] && used[i * size + size - 1]);
+    }
+
+    float area = 0.0f;
+    for (size_t i = 0; i < output.size(); i += 3)
+    {
+        const Vector3 edge0 = vertices[output[i + 1]] - vertices[output[i]];
+        const Vector3 edge1 = vertices[output[i + 2]] - vertices[output[i]];
+        area += edge0.Cross(edge1).Length() * 0.5f;
+    }
+
+    TE_TEST_CHECK(Math::ApproxEquals(area, (float)((size - 1) * (size - 1)), 1e-2f));
+}
+
+static void TestSelectionThresholds()
+{
+    const Vector<float> screenSizes = { 0.5f, 0.25f, 0.1f };
+
+    // Without hysteresis, the level only depends on the screen size
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.8f, 0, 0.0f) == 0);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.5f, 0, 0.0f) == 0);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.3f, 0, 0.0f) == 1);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.2f, 0, 0.0f) == 2);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.05f, 0, 0.0f) == 3);
+
+    // Meshes without levels of detail always use the first one
+    TE_TEST_CHECK(MeshUtility::SelectLOD(Vector<float>(), 0.05f, 0, 0.1f) == 0);
+
+    // With hysteresis, the level only changes once the screen size is far enough from the threshold
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.48f, 0, 0.1f) == 0);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.44f, 0, 0.1f) == 1);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.52f, 1, 0.1f) == 1);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.56f, 1, 0.1f) == 0);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.105f, 3, 0.1f) == 3);
+    TE_TEST_CHECK(MeshUtility::SelectLOD(screenSizes, 0.3f, 3, 0.1f) == 1);
+}
+
+int main()
+{
+    TestReductionRatios();
+    TestBordersAreKept();
+    TestSelectionThresholds();
+
+    return Test::GetResult();
+}
@@ -0,0 +1,129 @@
+#include "TeTestUtility.h"
+#include "Renderer/TeRenderQueue.h"
+#include "Renderer/TeRenderElement.h"
+#include "Math/TeMath.h"
+#include "Math/TeVector3.h"
+
+#include <functional>
+#include <random>
+
+using namespace te;
+
+/** Render element only used as a unique key by the render queue, never drawn. */
+class BenchmarkRenderElement : public RenderElement
+{
+public:
+    void Draw() const override { }
+};
+
+/**
+ * Render queue filled with synthetic elements, sorted back to front like transparent elements, without materials. Only
+ * calls the sorting methods, so it doesn't need a renderer.
+ */
+class BenchmarkRenderQueue : public RenderQueue
+{
+public:
+    BenchmarkRenderQueue(bool coherent)
+    {
+        SetCoherentSorting(coherent);
+    }
+
+    /** Adds all elements with their distance to @p viewOrigin, then sorts them. */
+    void SortElements(const Vector<BenchmarkRenderElement>& elements, const Vector<Vector3>& positions,
+        const Vector3& viewOrigin)
+    {
+        _sortableElements.clear();
+        _sortableElementIdx.clear();
+        _elements.clear();
+
+        for (UINT32 i = 0; i < (UINT32)elements.size(); i++)
+        {
+            SortableElement sortableElem;
+            sortableElem.SeqIdx = i;
+            sortableElem.Priority = 0;
+            sortableElem.DistFromCamera = -viewOrigin.Distance(positions[i]);
+            sortableElem.ShaderId = i % 4;
+            sortableElem.TechniqueIdx = 0;
+            sortableElem.PassIdx = 0;
+            sortableElem.MaterialId = i % 16;
+
+            _sortableElements.push_back(sortableElem);
+            _sortableElementIdx.push_back(i);
+            _elements.push_back(&elements[i]);
+        }
+
+        // Same comparator type as RenderQueue::Sort()
+        const std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod = &ElementSorterPreferDistance;
+
+        if (_coherentSorting)
+            SortCoherent(sortMethod);
+        else
+        {
+            std::sort(_sortableElementIdx.begin(), _sortableElementIdx.end(),
+                [this, &sortMethod](UINT32 a, UINT32 b) { return sortMethod(a, b, _sortableElements); });
+        }
+    }
+
+    const Vector<UINT32>& GetOrder() const { return _sortableElementIdx; }
+};
+
+/**
+ * Compares RenderQueue coherent sorting with a full sort, with a camera orbiting around transparent elements. The view
+ * moves a little every frame, so the order of the previous frame is almost sorted. A camera cut is simulated too.
+ */
+int main()
+{
+    const UINT32 numFrames = 240;
+    const float orbitRadius = 60.0f;
+
+    for (UINT32 numElements : { 32, 500, 2000, 10000 })
+    {
+        Vector<BenchmarkRenderElement> elements(numElements);
+        Vector<Vector3> positions(numElements);
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(-40.0f, 40.0f);
+        for (auto& position : positions)
+            position = Vector3(distribution(generator), distribution(generator) * 0.25f, distribution(generator));
+
+        auto getViewOrigin = [&](UINT32 frame, float degreesPerFrame)
+        {
+            const float angle = Math::TWO_PI * degreesPerFrame * frame / 360.0f;
+            return Vector3(cos(angle) * orbitRadius, 10.0f, sin(angle) * orbitRadius);
+        };
+
+        BenchmarkRenderQueue fullQueue(false);
+        BenchmarkRenderQueue coherentQueue(true);
+
+        // Both methods must give the same order
+        bool identical = true;
+        for (UINT32 frame = 0; frame < numFrames; frame++)
+        {
+            fullQueue.SortElements(elements, positions, getViewOrigin(frame, 0.5f));
+            coherentQueue.SortElements(elements, positions, getViewOrigin(frame, 0.5f));
+            identical &= fullQueue.GetOrder() == coherentQueue.GetOrder();
+        }
+
+        TE_TEST_CHECK(identical);
+
+        for (float degreesPerFrame : { 0.5f, 2.0f, 90.0f })
+        {
+            const double fullTime = Test::Measure([&]()
+            {
+                for (UINT32 frame = 0; frame < numFrames; frame++)
+                    fullQueue.SortElements(elements, positions, getViewOrigin(frame, degreesPerFrame));
+            });
+
+            const double coherentTime = Test::Measure([&]()
+            {
+                for (UINT32 frame = 0; frame < numFrames; frame++)
+                    coherentQueue.SortElements(elements, positions, getViewOrigin(frame, degreesPerFrame));
+            });
+
+            printf("%6u elements, %5.1f deg/frame: std::sort %8.3f ms/frame, coherent %8.3f ms/frame (x%.2f)\n",
+                numElements, degreesPerFrame, fullTime / numFrames, coherentTime / numFrames, fullTime / coherentTime);
+        }
+    }
+
+    return Test::GetResult();
+}
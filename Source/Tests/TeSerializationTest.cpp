@@ -0,0 +1,231 @@
+#include "TeTestUtility.h"
+#include "Serialization/TeBinaryStream.h"
+#include "Serialization/TeSceneSerializer.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Scene/TeSceneObject.h"
+#include "Renderer/TeRenderable.h"
+#include "Math/TeVector3.h"
+#include "Math/TeQuaternion.h"
+
+using namespace te;
+
+/** Header written by SceneSerializer::Save(). */
+struct TestSceneHeader
+{
+    UINT32 Magic;
+    UINT32 Version;
+    UINT32 NumObjects;
+    UINT32 NumComponents;
+};
+
+/** Record of a scene object written by SceneSerializer::Save(). */
+struct TestSceneObjectRecord
+{
+    UUID Id;
+    Vector3 Position;
+    Quaternion Rotation;
+    Vector3 Scale;
+    UINT32 Parent;
+    UINT32 Mobility;
+    UINT32 Active;
+};
+
+/** Writes scene data with a root, two children and a grandchild under the first child, without components. */
+static void WriteTestScene(BinaryWriter& writer, UINT32 numObjects = 4, UINT32 numComponents = 0)
+{
+    const char* names[] = { "Root", "Left", "LeftChild", "Right" };
+    const UINT32 parents[] = { (UINT32)-1, 0, 1, 0 };
+
+    TestSceneObjectRecord records[4];
+    memset(records, 0, sizeof(records)); // Padding is compared too
+
+    for (UINT32 i = 0; i < 4; i++)
+    {
+        records[i].Id = UUID(i + 1, 2, 3, 4);
+        records[i].Position = Vector3((float)i, 2.0f * i, -1.0f);
+        records[i].Rotation = Quaternion::IDENTITY;
+        records[i].Scale = Vector3(1.0f, 1.0f + i, 1.0f);
+        records[i].Parent = parents[i];
+        records[i].Mobility = (UINT32)(i == 2 ? ObjectMobility::Static : ObjectMobility::Movable);
+        records[i].Active = i == 3 ? 0 : 1;
+    }
+
+    writer.Write(TestSceneHeader{ SceneSerializer::MAGIC, SceneSerializer::VERSION, numObjects, numComponents });
+    writer.WriteArray(records, 4);
+
+    for (auto& name : names)
+        writer.Write(String(name));
+}
+
+/** Values, strings, aligned arrays and values written back are read as written. */
+static void TestBinaryStreamRoundTrip()
+{
+    const Vector3 positions[] = { Vector3(1.0f, 2.0f, 3.0f), Vector3(-4.0f, 5.5f, 0.0f), Vector3::ONE };
+
+    BinaryWriter writer;
+    writer.Write((UINT8)7);
+    writer.Write(String("Sponza"));
+    writer.WriteArray(positions, 3);
+
+    const UINT32 sizeOffset = writer.Tell();
+    writer.Write((UINT32)0);
+    writer.Write(Quaternion::IDENTITY);
+    writer.WriteAt(sizeOffset, (UINT32)sizeof(Quaternion));
+    writer.Write(String());
+
+    const Vector<UINT8>& data = writer.GetData();
+    BinaryReader reader(data.data(), (UINT32)data.size(), 2);
+
+    UINT8 byte = 0;
+    String name;
+    TE_TEST_CHECK(reader.Read(byte) && byte == 7);
+    TE_TEST_CHECK(reader.Read(name) && name == "Sponza");
+
+    const Vector3* readPositions = reader.ReadArray<Vector3>(3);
+    TE_TEST_CHECK(readPositions != nullptr);
+    if (readPositions != nullptr)
+    {
+        for (UINT32 i = 0; i < 3; i++)
+            TE_TEST_CHECK(readPositions[i] == positions[i]);
+    }
+
+    UINT32 size = 0;
+    TE_TEST_CHECK(reader.Read(size) && size == sizeof(Quaternion));
+
+    BinaryReader block = reader.ReadBlock(size);
+    Quaternion rotation;
+    TE_TEST_CHECK(block.GetVersion() == 2);
+    TE_TEST_CHECK(block.Read(rotation) && rotation == Quaternion::IDENTITY);
+    TE_TEST_CHECK(block.GetRemaining() == 0);
+
+    TE_TEST_CHECK(reader.Read(name) && name.empty());
+    TE_TEST_CHECK(reader.GetRemaining() == 0 && !reader.HasFailed());
+
+    // Reading past the end fails without reading anything
+    UINT32 value = 42;
+    TE_TEST_CHECK(!reader.Read(value) && value == 42);
+    TE_TEST_CHECK(reader.HasFailed());
+}
+
+/** Arrays larger than the remaining data are rejected, even when their size in bytes overflows. */
+static void TestBinaryStreamArrayOverflow()
+{
+    const UINT32 values[] = { 1, 2, 3, 4 };
+
+    BinaryWriter writer;
+    writer.WriteArray(values, 4);
+
+    const Vector<UINT8>& data = writer.GetData();
+    BinaryReader reader(data.data(), (UINT32)data.size());
+
+    // 0x40000001 * 4 bytes wraps around to 4 bytes in 32 bits
+    TE_TEST_CHECK(reader.ReadArray<UINT32>(0x40000001) == nullptr && reader.HasFailed());
+}
+
+/** Every renderable property is restored, including the ones the first version of the format didn't store. */
+static void TestRenderablePropertiesRoundTrip()
+{
+    RenderableProperties properties;
+    properties.Instancing = true;
+    properties.CanBeMerged = true;
+    properties.CastShadows = false;
+    properties.CastLights = false;
+    properties.ReceiveShadows = false;
+    properties.UseForDynamicEnvMapping = true;
+    properties.WriteVelocity = false;
+    properties.CullDistanceFactor = 0.25f;
+
+    BinaryWriter writer;
+    properties.Serialize(writer);
+
+    const Vector<UINT8>& data = writer.GetData();
+    BinaryReader reader(data.data(), (UINT32)data.size());
+
+    RenderableProperties loaded;
+    TE_TEST_CHECK(loaded.Deserialize(reader));
+    TE_TEST_CHECK(reader.GetRemaining() == 0);
+
+    TE_TEST_CHECK(loaded.Instancing == properties.Instancing);
+    TE_TEST_CHECK(loaded.CanBeMerged == properties.CanBeMerged);
+    TE_TEST_CHECK(loaded.CastShadows == properties.CastShadows);
+    TE_TEST_CHECK(loaded.CastLights == properties.CastLights);
+    TE_TEST_CHECK(loaded.ReceiveShadows == properties.ReceiveShadows);
+    TE_TEST_CHECK(loaded.UseForDynamicEnvMapping == properties.UseForDynamicEnvMapping);
+    TE_TEST_CHECK(loaded.WriteVelocity == properties.WriteVelocity);
+    TE_TEST_CHECK(loaded.CullDistanceFactor == properties.CullDistanceFactor);
+
+    // Truncated data leaves the properties untouched
+    BinaryReader truncated(data.data(), (UINT32)data.size() - 1);
+    RenderableProperties defaults;
+    TE_TEST_CHECK(!defaults.Deserialize(truncated));
+    TE_TEST_CHECK(defaults.CastShadows && defaults.ReceiveShadows && !defaults.CanBeMerged);
+    TE_TEST_CHECK(defaults.CullDistanceFactor == 1.0f);
+}
+
+/** A loaded hierarchy keeps its structure, names, transforms and flags, and is saved back to the same data. */
+static void TestSceneHierarchyRoundTrip()
+{
+    BinaryWriter writer;
+    WriteTestScene(writer);
+
+    const Vector<UINT8>& data = writer.GetData();
+    BinaryReader reader(data.data(), (UINT32)data.size());
+
+    HSceneObject root = SceneSerializer::Load(reader, HSceneObject(), true);
+    TE_TEST_CHECK(root != nullptr && !reader.HasFailed());
+    if (root == nullptr)
+        return;
+
+    TE_TEST_CHECK(root->GetName() == "Root" && root->GetNumChildren() == 2);
+    TE_TEST_CHECK(root->GetUUID() == UUID(1, 2, 3, 4));
+
+    HSceneObject left = root->GetChild(0);
+    HSceneObject right = root->GetChild(1);
+    TE_TEST_CHECK(left->GetName() == "Left" && left->GetNumChildren() == 1);
+    TE_TEST_CHECK(right->GetName() == "Right" && right->GetNumChildren() == 0);
+    TE_TEST_CHECK(right->GetUUID() == UUID(4, 2, 3, 4));
+    TE_TEST_CHECK(!right->GetActive(true) && left->GetActive(true));
+
+    HSceneObject leftChild = left->GetChild(0);
+    TE_TEST_CHECK(leftChild->GetName() == "LeftChild" && leftChild->GetParent() == left);
+    TE_TEST_CHECK(leftChild->GetMobility() == ObjectMobility::Static);
+    TE_TEST_CHECK(leftChild->GetLocalTransform().GetPosition() == Vector3(2.0f, 4.0f, -1.0f));
+    TE_TEST_CHECK(leftChild->GetLocalTransform().GetScale() == Vector3(1.0f, 3.0f, 1.0f));
+
+    BinaryWriter saved;
+    SceneSerializer::Save(root, saved);
+    TE_TEST_CHECK(saved.GetData() == data);
+
+    root->Destroy(true);
+}
+
+/** Counts that don't fit in the data are rejected before any object is created. */
+static void TestSceneInvalidCounts()
+{
+    BinaryWriter tooManyObjects;
+    WriteTestScene(tooManyObjects, 0x40000000);
+
+    BinaryReader objectsReader(tooManyObjects.GetData().data(), (UINT32)tooManyObjects.GetData().size());
+    TE_TEST_CHECK(SceneSerializer::Load(objectsReader) == nullptr);
+
+    BinaryWriter tooManyComponents;
+    WriteTestScene(tooManyComponents, 4, 0xFFFFFFFF);
+
+    BinaryReader componentsReader(tooManyComponents.GetData().data(), (UINT32)tooManyComponents.GetData().size());
+    TE_TEST_CHECK(SceneSerializer::Load(componentsReader) == nullptr);
+}
+
+int main()
+{
+    GameObjectManager::StartUp();
+
+    TestBinaryStreamRoundTrip();
+    TestBinaryStreamArrayOverflow();
+    TestRenderablePropertiesRoundTrip();
+    TestSceneHierarchyRoundTrip();
+    TestSceneInvalidCounts();
+
+    GameObjectManager::ShutDown();
+
+    return Test::GetResult();
+}
@@ -0,0 +1,165 @@
+#include "TeTestUtility.h"
+#include "TeShadowCascades.h"
+#include "TeRendererView.h"
+#include "Math/TeMath.h"
+
+using namespace te;
+
+static void TestSplitDistances()
+{
+    const float nearDist = 0.5f;
+    const float farDist = 200.0f;
+    const UINT32 numCascades = 4;
+    const float exponent = 3.0f;
+
+    TE_TEST_CHECK(Math::ApproxEquals(ShadowCascades::GetSplitDistance(0, numCascades, nearDist, farDist, exponent), nearDist));
+    TE_TEST_CHECK(Math::ApproxEquals(ShadowCascades::GetSplitDistance(numCascades, numCascades, nearDist, farDist, exponent),
+        farDist, 1e-3f));
+
+    // Each cascade covers a range @p exponent times larger than the previous one
+    float previousRange = 0.0f;
+    for (UINT32 i = 0; i < numCascades; i++)
+    {
+        const float start = ShadowCascades::GetSplitDistance(i, numCascades, nearDist, farDist, exponent);
+        const float end = ShadowCascades::GetSplitDistance(i + 1, numCascades, nearDist, farDist, exponent);
+        TE_TEST_CHECK(end > start);
+
+        if (i > 0)
+            TE_TEST_CHECK(Math::ApproxEquals((end - start) / previousRange, exponent, 1e-3f));
+
+        previousRange = end - start;
+    }
+
+    // An exponent of one splits the range evenly
+    TE_TEST_CHECK(Math::ApproxEquals(ShadowCascades::GetSplitDistance(1, 4, 0.0f, 100.0f, 1.0f), 25.0f, 1e-4f));
+}
+
+static void TestCascadeSelection()
+{
+    LightShadowInfo shadows;
+    shadows.Maps.resize(3);
+
+    const float splits[] = { 0.5f, 10.0f, 40.0f, 100.0f };
+    for (UINT32 i = 0; i < 3; i++)
+    {
+        shadows.Maps[i].SplitNear = splits[i];
+        shadows.Maps[i].SplitFar = splits[i + 1];
+    }
+
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(shadows, 0.0f) == 0);
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(shadows, 9.99f) == 0);
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(shadows, 10.0f) == 1);
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(shadows, 39.0f) == 1);
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(shadows, 99.0f) == 2);
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(shadows, 100.0f) == -1);
+    TE_TEST_CHECK(ShadowCascades::SelectCascade(LightShadowInfo(), 1.0f) == -1);
+}
+
+static void TestSliceBounds()
+{
+    const Matrix4 proj = Matrix4::ProjectionPerspective(Degree(90.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    const float sliceNear = 10.0f;
+    const float sliceFar = 40.0f;
+
+    // The radius doesn't depend on the view orientation, so cascades keep their resolution when the view rotates
+    float radius = 0.0f;
+    for (float angle : { 0.0f, 30.0f, 75.0f, 160.0f })
+    {
+        const Quaternion rotation(Vector3::Normalize(Vector3(0.3f, 1.0f, 0.2f)), Radian(Degree(angle)));
+        const Matrix4 invView = Matrix4::View(Vector3(5.0f, 2.0f, -3.0f), rotation).InverseAffine();
+
+        const Sphere bounds = ShadowCascades::GetSliceBounds(proj, PT_PERSPECTIVE, invView, sliceNear, sliceFar);
+        if (radius == 0.0f)
+            radius = bounds.GetRadius();
+
+        TE_TEST_CHECK(bounds.GetRadius() == radius);
+
+        // The sphere encloses all corners of the slice
+        const float halfWidth = 1.0f / proj[0][0];
+        const float halfHeight = 1.0f / proj[1][1];
+        for (float depth : { sliceNear, sliceFar })
+        {
+            for (float x : { -1.0f, 1.0f })
+            {
+                for (float y : { -1.0f, 1.0f })
+                {
+                    const Vector3 corner = invView.MultiplyAffine(
+                        Vector3(x * halfWidth * depth, y * halfHeight * depth, -depth));
+                    TE_TEST_CHECK(corner.Distance(bounds.GetCenter()) <= bounds.GetRadius() + 1e-3f);
+                }
+            }
+        }
+    }
+}
+
+static void TestTexelSnapping()
+{
+    const Quaternion lightRotation(Vector3::Normalize(Vector3(1.0f, 0.0f, 0.5f)), Radian(Degree(-60.0f)));
+    const float radius = 32.0f;
+    const UINT32 shadowMapSize = 1024;
+    const float texelSize = 2.0f * radius / shadowMapSize;
+
+    const Matrix4 lightView = Matrix4::View(Vector3::ZERO, lightRotation);
+    const Vector3 right = lightRotation.XAxis();
+
+    const Vector3 center(12.34f, 5.67f, -8.9f);
+    const Vector3 snapped = ShadowCascades::SnapToTexels(center, radius, lightRotation, shadowMapSize);
+
+    // The center only moves by less than a texel, on the texel grid of the light
+    const Vector3 lightSpace = lightView.MultiplyAffine(snapped);
+    TE_TEST_CHECK(snapped.Distance(center) < texelSize * 1.5f);
+    TE_TEST_CHECK(Math::ApproxEquals(lightSpace.x / texelSize, std::round(lightSpace.x / texelSize), 1e-2f));
+    TE_TEST_CHECK(Math::ApproxEquals(lightSpace.y / texelSize, std::round(lightSpace.y / texelSize), 1e-2f));
+
+    // Moving the view by a fraction of a texel doesn't move the cascade, moving it by a texel moves it by exactly one
+    const Vector3 snappedMoved = ShadowCascades::SnapToTexels(
+        lightView.InverseAffine().MultiplyAffine(lightSpace + Vector3(texelSize * 0.25f, 0.0f, 0.0f)), radius,
+        lightRotation, shadowMapSize);
+    TE_TEST_CHECK(snappedMoved.Distance(snapped) < 1e-3f);
+
+    const Vector3 snappedTexel = ShadowCascades::SnapToTexels(snapped + right * texelSize * 1.25f, radius, lightRotation,
+        shadowMapSize);
+    TE_TEST_CHECK(Math::ApproxEquals(snappedTexel.Distance(snapped), texelSize, 1e-3f));
+}
+
+static void TestCasterCulling()
+{
+    // The light shines along -Z, so casters can be anywhere toward +Z
+    const Quaternion lightRotation = Quaternion::IDENTITY;
+    const ConvexVolume volume = ShadowCascades::GetCasterVolume(Vector3::ZERO, 10.0f, lightRotation);
+
+    auto createCullInfo = [](const Vector3& center, float extent)
+    {
+        const Vector3 halfSize(extent, extent, extent);
+        return CullInfo(Bounds(AABox(center - halfSize, center + halfSize), Sphere(center, halfSize.Length())));
+    };
+
+    Vector<CullInfo> cullInfos;
+    cullInfos.push_back(createCullInfo(Vector3(0.0f, 0.0f, 0.0f), 1.0f));     // Inside the cascade
+    cullInfos.push_back(createCullInfo(Vector3(3.0f, -2.0f, 500.0f), 1.0f));  // Far toward the light
+    cullInfos.push_back(createCullInfo(Vector3(0.0f, 0.0f, -30.0f), 1.0f));   // Behind the receivers
+    cullInfos.push_back(createCullInfo(Vector3(30.0f, 0.0f, 50.0f), 1.0f));   // Outside on the side
+    cullInfos.push_back(createCullInfo(Vector3(10.5f, 0.0f, 5.0f), 1.0f));    // Overlapping the side
+    cullInfos.push_back(createCullInfo(Vector3(0.0f, 0.0f, 0.0f), 1.0f));     // Inside, but not a candidate
+
+    const Vector<UINT32> candidates = { 0, 1, 2, 3, 4 };
+    Vector<UINT32> casters;
+    ShadowCascades::CullCasters(cullInfos, volume, candidates, casters);
+
+    TE_TEST_CHECK(casters == Vector<UINT32>({ 0, 1, 4 }));
+
+    // Previous results are cleared
+    ShadowCascades::CullCasters(cullInfos, volume, Vector<UINT32>({ 2, 3 }), casters);
+    TE_TEST_CHECK(casters.empty());
+}
+
+int main()
+{
+    TestSplitDistances();
+    TestCascadeSelection();
+    TestSliceBounds();
+    TestTexelSnapping();
+    TestCasterCulling();
+
+    return Test::GetResult();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+namespace te
+{
+    /** Helpers shared by the unit tests and benchmarks. */
+    namespace Test
+    {
+        /** Returns the number of checks that failed so far. */
+        inline UINT32& GetNumFailures()
+        {
+            static UINT32 numFailures = 0;
+            return numFailures;
+        }
+
+        /** Reports a failed check. Use TE_TEST_CHECK instead. */
+        inline void Check(bool condition, const char* expression, const char* file, int line)
+        {
+            if (condition)
+                return;
+
+            printf("%s(%d): check failed: %s\n", file, line, expression);
+            GetNumFailures()++;
+        }
+
+        /** Returns the exit code of a test: 0 if all checks passed. */
+        inline int GetResult()
+        {
+            if (GetNumFailures() > 0)
+            {
+                printf("%u check(s) failed\n", GetNumFailures());
+                return 1;
+            }
+
+            return 0;
+        }
+
+        /** Calls @p func @p numRuns times and returns the fastest run, in milliseconds. */
+        template<class F>
+        double Measure(F&& func, UINT32 numRuns = 5)
+        {
+            double best = std::numeric_limits<double>::max();
+            for (UINT32 i = 0; i < numRuns; i++)
+            {
+                const auto start = std::chrono::high_resolution_clock::now();
+                func();
+                const auto end = std::chrono::high_resolution_clock::now();
+
+                best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+            }
+
+            return best;
+        }
+    }
+}
+
+/** Checks a condition, making the test fail (without stopping it) if it is false. */
+#define TE_TEST_CHECK(condition) te::Test::Check((condition), #condition, __FILE__, __LINE__)